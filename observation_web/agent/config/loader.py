@@ -10,6 +10,8 @@ from pathlib import Path
 
 from typing import Any, Dict, List
 
+from ..core.aggregation import MODES as AGGREGATION_MODES
+
 logger = logging.getLogger(__name__)
 
 
@@ -23,12 +25,25 @@ class ConfigLoader:
             'max_memory_mb': 50,
             'subprocess_timeout': 10,
             'update_check_interval_seconds': 1800,
+            'checkpoint_enabled': True,
+            'checkpoint_path': '/var/lib/observation-points/checkpoint.json',
+            'checkpoint_interval_seconds': 30,
         },
         'reporter': {
             'output': 'file',
             'file_path': '/var/log/observation-points/alerts.log',
             'syslog_facility': 'local0',
             'cooldown_seconds': 300,
+            'timeseries_enabled': True,
+            'timeseries_max_series': 128,
+            'timeseries_capacity': 2880,
+            'aggregation': {
+                'mode': 'deadband',
+                'deadband': 0,
+                'heartbeat_seconds': 300,
+                'window_seconds': 60,
+                'observers': {},
+            },
         },
         'observers': {
             'error_code': {
@@ -214,4 +229,12 @@ class ConfigLoader:
             interval = obs_config.get('interval', 0)
             if interval and interval < 1:
                 errors.append("observers.%s.interval 必须 >= 1" % name)
+        aggregation = (config.get('reporter', {}) or {}).get('aggregation', {}) or {}
+        policies = [('reporter.aggregation', aggregation)]
+        policies += [('reporter.aggregation.observers.%s' % name, cfg)
+                     for name, cfg in (aggregation.get('observers') or {}).items()]
+        for path, policy in policies:
+            mode = (policy or {}).get('mode')
+            if mode is not None and mode not in AGGREGATION_MODES:
+                errors.append("%s.mode 必须是 %s 之一" % (path, '/'.join(AGGREGATION_MODES)))
         return errors
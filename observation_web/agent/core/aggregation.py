@@ -0,0 +1,246 @@
+"""
+指标推送前的本地聚合
+
+上报器每条指标记录都会写入本地 metrics.jsonl 与时序环形缓冲（原始精度）；推送到后端前
+先经本模块按观察点聚合，数值不变或变化很小时不重复推送：
+
+- raw:       每条都推送
+- deadband:  任一数值字段相对上次推送值的变化超过死区（绝对值 deadband 或
+             百分比 deadband_percent）才推送；deadband 为 0 即仅变化时推送
+- window:    每 window_seconds 推送一条 avg，附 <field>_min / <field>_max 与样本数
+- heartbeat: 只每 heartbeat_seconds 推送一次最新值（适合长期平稳的观察点）
+
+deadband / raw 模式在 heartbeat_seconds 内没有推送时也会推送一次，后端据此判断 agent 存活。
+
+后端通过响应头 X-Ingest-Pressure（0~3）或 429/503 状态码反馈背压：压力等级为 n 时，
+死区、窗口、心跳间隔均放大 2^n 倍，raw 模式退化为仅变化时推送；压力消失后每
+pressure_decay_seconds 降一级。
+"""
+
+import threading
+import time
+from typing import Any, Callable, Dict, List, Optional
+
+MODES = ('raw', 'deadband', 'window', 'heartbeat')
+
+# 背压等级上限：放大倍数最多 2^3 = 8
+DEFAULT_MAX_PRESSURE = 3
+
+_THROTTLE_STATUS = (429, 503)
+
+
+class AggregationPolicy(object):
+    """单个观察点的聚合参数"""
+
+    def __init__(self, mode='deadband', deadband=0.0, deadband_percent=0.0,
+                 window_seconds=60.0, heartbeat_seconds=300.0):
+        # type: (str, float, float, float, float) -> None
+        self.mode = mode if mode in MODES else 'deadband'
+        self.deadband = max(0.0, float(deadband))
+        self.deadband_percent = max(0.0, float(deadband_percent))
+        self.window_seconds = max(1.0, float(window_seconds))
+        self.heartbeat_seconds = max(1.0, float(heartbeat_seconds))
+
+    @classmethod
+    def from_config(cls, config, base=None):
+        # type: (Dict[str, Any], Optional[AggregationPolicy]) -> AggregationPolicy
+        """按配置构造；未给出的字段继承 base"""
+        base = base or cls()
+        return cls(
+            mode=config.get('mode', base.mode),
+            deadband=config.get('deadband', base.deadband),
+            deadband_percent=config.get('deadband_percent', base.deadband_percent),
+            window_seconds=config.get('window_seconds', base.window_seconds),
+            heartbeat_seconds=config.get('heartbeat_seconds', base.heartbeat_seconds),
+        )
+
+
+class _ObserverState(object):
+    __slots__ = ('last_emit', 'emitted', 'window_start', 'window_values', 'window_last')
+
+    def __init__(self):
+        self.last_emit = None  # type: Optional[float]
+        self.emitted = {}  # type: Dict[str, float]
+        self.window_start = None  # type: Optional[float]
+        self.window_values = {}  # type: Dict[str, List[float]]
+        self.window_last = None  # type: Optional[Dict[str, Any]]
+
+
+class MetricAggregator(object):
+    """按观察点聚合指标记录，决定哪些需要推送"""
+
+    def __init__(self, config=None, clock=time.time):
+        # type: (Optional[Dict[str, Any]], Callable[[], float]) -> None
+        config = config or {}
+        self._clock = clock
+        self.default_policy = AggregationPolicy.from_config(config)
+        self.policies = {
+            name: AggregationPolicy.from_config(cfg or {}, self.default_policy)
+            for name, cfg in (config.get('observers') or {}).items()
+        }  # type: Dict[str, AggregationPolicy]
+        self.max_pressure = int(config.get('max_pressure', DEFAULT_MAX_PRESSURE))
+        self.pressure_decay_seconds = float(config.get('pressure_decay_seconds', 60))
+        self._states = {}  # type: Dict[str, _ObserverState]
+        self._pressure = 0
+        self._pressure_changed = 0.0
+        self._lock = threading.Lock()
+        self.offered = 0
+        self.emitted = 0
+
+    # ---------- 背压 ----------
+
+    @property
+    def pressure(self):
+        # type: () -> int
+        with self._lock:
+            self._decay_locked(self._clock())
+            return self._pressure
+
+    def update_pressure(self, status, header=None):
+        # type: (Optional[int], Optional[str]) -> None
+        """根据推送响应更新压力等级（推送线程调用）"""
+        now = self._clock()
+        level = None  # type: Optional[int]
+        if header is not None:
+            try:
+                level = int(header)
+            except (TypeError, ValueError):
+                level = None
+        with self._lock:
+            if status in _THROTTLE_STATUS:
+                level = max(level or 0, self._pressure + 1)
+            if level is None:
+                self._decay_locked(now)
+                return
+            level = max(0, min(level, self.max_pressure))
+            if level >= self._pressure:
+                # 升压或维持：刷新计时，持续收到压力信号时不衰减
+                self._pressure = level
+                self._pressure_changed = now
+            else:
+                self._decay_locked(now, floor=level)
+
+    def _decay_locked(self, now, floor=0):
+        # type: (float, int) -> None
+        while self._pressure > floor and now - self._pressure_changed >= self.pressure_decay_seconds:
+            self._pressure -= 1
+            self._pressure_changed = now
+
+    # ---------- 聚合 ----------
+
+    def policy_for(self, observer):
+        # type: (str) -> AggregationPolicy
+        return self.policies.get(observer, self.default_policy)
+
+    def offer(self, observer, record):
+        # type: (str, Dict[str, Any]) -> List[Dict[str, Any]]
+        """
+        提交一条原始指标记录
+
+        Returns:
+            需要推送的记录（可能为空、原记录或窗口聚合记录）
+        """
+        now = self._clock()
+        factor = 2 ** self.pressure
+        policy = self.policy_for(observer)
+        state = self._states.get(observer)
+        if state is None:
+            state = self._states[observer] = _ObserverState()
+        self.offered += 1
+
+        mode = policy.mode
+        if mode == 'raw' and factor > 1:
+            mode = 'deadband'
+
+        if mode == 'window':
+            out = self._offer_window(state, policy, record, now, factor)
+        elif mode == 'heartbeat':
+            due = state.last_emit is None or now - state.last_emit >= policy.heartbeat_seconds * factor
+            out = [record] if due else []
+        elif mode == 'deadband':
+            due = (state.last_emit is None
+                   or now - state.last_emit >= policy.heartbeat_seconds * factor
+                   or self._exceeds_deadband(state, policy, record, factor))
+            out = [record] if due else []
+        else:
+            out = [record]
+
+        if out:
+            state.last_emit = now
+            for emitted in out:
+                state.emitted.update(_numeric(emitted))
+            self.emitted += len(out)
+        return out
+
+    @staticmethod
+    def _exceeds_deadband(state, policy, record, factor):
+        # type: (_ObserverState, AggregationPolicy, Dict[str, Any], int) -> bool
+        absolute = policy.deadband * factor
+        percent = policy.deadband_percent * factor
+        for key, value in _numeric(record).items():
+            prev = state.emitted.get(key)
+            if prev is None:
+                return True
+            delta = abs(value - prev)
+            limit = absolute
+            if percent:
+                limit = max(limit, abs(prev) * percent / 100.0)
+            if delta > limit:
+                return True
+        return False
+
+    def _offer_window(self, state, policy, record, now, factor):
+        # type: (_ObserverState, AggregationPolicy, Dict[str, Any], float, int) -> List[Dict[str, Any]]
+        out = []
+        if state.window_start is not None and now - state.window_start >= policy.window_seconds * factor:
+            out.append(self._close_window(state, policy.window_seconds * factor))
+        if state.window_start is None:
+            state.window_start = now
+        for key, value in _numeric(record).items():
+            state.window_values.setdefault(key, []).append(value)
+        state.window_last = record
+        return out
+
+    def flush(self):
+        # type: () -> List[Dict[str, Any]]
+        """立即结束所有未满窗口（停止时调用）"""
+        factor = 2 ** self.pressure
+        out = []
+        for observer, state in self._states.items():
+            if state.window_start is not None and state.window_last is not None:
+                out.append(self._close_window(state, self.policy_for(observer).window_seconds * factor))
+        self.emitted += len(out)
+        return out
+
+    @staticmethod
+    def _close_window(state, window_seconds):
+        # type: (_ObserverState, float) -> Dict[str, Any]
+        record = dict(state.window_last or {})
+        samples = 0
+        for key, values in state.window_values.items():
+            record[key] = round(sum(values) / len(values), 3)
+            record[f'{key}_min'] = min(values)
+            record[f'{key}_max'] = max(values)
+            samples = max(samples, len(values))
+        record['samples'] = samples
+        record['window_seconds'] = window_seconds
+        state.window_start = None
+        state.window_values = {}
+        state.window_last = None
+        return record
+
+    def stats(self):
+        # type: () -> Dict[str, Any]
+        return {
+            'offered': self.offered,
+            'emitted': self.emitted,
+            'pressure': self.pressure,
+        }
+
+
+def _numeric(record):
+    # type: (Dict[str, Any]) -> Dict[str, float]
+    return {
+        k: float(v) for k, v in record.items()
+        if not isinstance(v, bool) and isinstance(v, (int, float))
+    }
@@ -93,6 +93,18 @@ class BaseObserver(ABC):
         """清理资源（子类可覆盖）"""
         pass
     
+    def get_state(self) -> Optional[Dict[str, Any]]:
+        """
+        导出需要跨重启保留的运行状态（子类可覆盖）
+        
+        由调度器周期性写入检查点，须可 JSON 序列化；返回 None 表示无需保留。
+        """
+        return None
+    
+    def restore_state(self, state: Dict[str, Any]):
+        """从检查点恢复运行状态（子类可覆盖），在首次 check() 之前调用"""
+        pass
+    
     def is_enabled(self) -> bool:
         """是否启用"""
         return self.enabled
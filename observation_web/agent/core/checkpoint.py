@@ -0,0 +1,133 @@
+"""
+Agent 状态检查点
+
+周期性地把各观察点的运行状态（日志读取偏移与 inode、活跃告警、累计计数）
+以及上报器的冷却计时原子写入磁盘，重启或自更新后恢复，使 agent 从上次停止
+的位置继续：停机期间新增的日志行不会丢失，也不会重新扫描整个日志或重复上报。
+
+写入方式：临时文件 + fsync + rename，任意时刻崩溃都只会留下完整的旧文件或新文件。
+"""
+
+import json
+import logging
+import os
+import tempfile
+import time
+from pathlib import Path
+from typing import Any, Dict, Optional, Tuple, Union
+
+logger = logging.getLogger(__name__)
+
+CHECKPOINT_VERSION = 1
+
+DEFAULT_CHECKPOINT_PATH = '/var/lib/observation-points/checkpoint.json'
+
+# 默认检查点间隔（秒）
+DEFAULT_CHECKPOINT_INTERVAL = 30
+
+
+class CheckpointStore(object):
+    """检查点文件读写"""
+
+    def __init__(self, path=DEFAULT_CHECKPOINT_PATH):
+        # type: (Union[str, Path]) -> None
+        self.path = Path(path)
+
+    def load(self):
+        # type: () -> Dict[str, Any]
+        """读取检查点，不存在、损坏或版本不符时返回空字典"""
+        try:
+            with open(self.path, 'r', encoding='utf-8') as f:
+                data = json.load(f)
+        except FileNotFoundError:
+            return {}
+        except (IOError, OSError, ValueError) as e:
+            logger.warning(f"检查点文件不可用，忽略: {self.path}: {e}")
+            return {}
+        if not isinstance(data, dict) or data.get('version') != CHECKPOINT_VERSION:
+            logger.warning(f"检查点版本不符，忽略: {self.path}")
+            return {}
+        return data
+
+    def save(self, observers, reporter=None):
+        # type: (Dict[str, Any], Optional[Dict[str, Any]]) -> bool
+        """原子写入检查点"""
+        data = {
+            'version': CHECKPOINT_VERSION,
+            'saved_at': time.time(),
+            'observers': observers,
+            'reporter': reporter or {},
+        }
+        try:
+            self.path.parent.mkdir(parents=True, exist_ok=True)
+            fd, tmp = tempfile.mkstemp(prefix='.checkpoint.', dir=str(self.path.parent))
+            try:
+                with os.fdopen(fd, 'w', encoding='utf-8') as f:
+                    json.dump(data, f, ensure_ascii=False, default=str)
+                    f.flush()
+                    os.fsync(f.fileno())
+                os.replace(tmp, str(self.path))
+            except BaseException:
+                try:
+                    os.unlink(tmp)
+                except OSError:
+                    pass
+                raise
+            _fsync_dir(self.path.parent)
+            return True
+        except (IOError, OSError, TypeError, ValueError) as e:
+            logger.warning(f"写入检查点失败: {self.path}: {e}")
+            return False
+
+
+def _fsync_dir(path):
+    # type: (Path) -> None
+    """rename 之后同步目录项，确保掉电后新文件名可见"""
+    try:
+        fd = os.open(str(path), os.O_RDONLY)
+    except OSError:
+        return
+    try:
+        os.fsync(fd)
+    except OSError:
+        pass
+    finally:
+        os.close(fd)
+
+
+# ---------- 日志游标 ----------
+
+def log_cursor(position, inode):
+    # type: (int, Optional[int]) -> Dict[str, Any]
+    """
+    记录日志读取位置及文件 inode（用于恢复时识别轮转）
+
+    inode 必须是观察点读到该位置时所读文件的 inode（读取时 fstat 得到），
+    不能在保存检查点时再 stat 路径：两者之间日志可能已轮转，旧文件的偏移
+    会被配上新文件的 inode，恢复后跳过新日志开头的内容。
+    """
+    return {'position': position, 'inode': inode}
+
+
+def restore_log_cursor(path, cursor):
+    # type: (Union[str, Path], Optional[Dict[str, Any]]) -> Optional[Tuple[int, int]]
+    """
+    根据检查点计算恢复后的读取位置
+
+    Returns:
+        (位置, 当前文件 inode)。同一文件且未截断：原位置；文件已轮转（inode
+        变化）或被截断：0（从新文件开头读起，即停机期间写入的内容）；
+        无法判断（无检查点、文件不存在）：None
+    """
+    if not cursor or cursor.get('position') is None:
+        return None
+    try:
+        st = os.stat(str(path))
+    except OSError:
+        return None
+    position = int(cursor['position'])
+    if cursor.get('inode') is not None and cursor['inode'] != st.st_ino:
+        return 0, st.st_ino
+    if st.st_size < position:
+        return 0, st.st_ino
+    return position, st.st_ino
@@ -11,15 +11,34 @@ import logging
 import re
 import syslog
 import threading
+import time
+import zlib
 from dataclasses import dataclass
 from datetime import datetime
 from pathlib import Path
 from typing import Any, Dict, Optional
 
+from .aggregation import MetricAggregator
 from .base import ObserverResult, AlertLevel
+from .timeseries import DEFAULT_CAPACITY, DEFAULT_MAX_SERIES, TimeSeriesStore
 
 logger = logging.getLogger(__name__)
 
+# 后端在推送响应中反馈的背压等级（0 表示无压力）
+PRESSURE_HEADER = 'X-Ingest-Pressure'
+
+# datetime.isoformat() 的两种输出（微秒为 0 时省略）；fromisoformat 需 3.7+
+_ISO_FORMATS = ('%Y-%m-%dT%H:%M:%S.%f', '%Y-%m-%dT%H:%M:%S')
+
+
+def _parse_isoformat(value: str) -> datetime:
+    for fmt in _ISO_FORMATS:
+        try:
+            return datetime.strptime(value, fmt)
+        except ValueError:
+            continue
+    raise ValueError(f"unrecognized timestamp: {value!r}")
+
 
 @dataclass
 class Alert:
@@ -60,7 +79,8 @@ class Reporter:
     - HTTP 推送：主动将告警推送到 Web 后端
     - 告警冷却：同一观察点的相同告警在冷却期内不重复上报
     - 脱敏：自动对敏感信息进行脱敏处理
-    - 指标记录：记录 CPU/内存等时序数据到 metrics.jsonl
+    - 指标记录：记录 CPU/内存等时序数据到 metrics.jsonl，
+      并写入本地时序环形缓冲 metrics.ring（供 observation_points.query 查询）
     """
     
     # 默认脱敏规则
@@ -114,12 +134,19 @@ class Reporter:
         self.push_enabled = config.get('push_enabled', False)
         self.push_url = config.get('push_url', '')  # e.g., "http://192.168.1.100:8000/api/ingest"
         self.push_timeout = config.get('push_timeout', 5)
+        # 指标推送前的本地聚合（死区 / 窗口 / 心跳），随后端背压自动收紧
+        self._aggregator = MetricAggregator(config.get('aggregation'))
         
         # Metrics recording
         self.metrics_enabled = config.get('metrics_enabled', True)
         metrics_dir = self.file_path.parent if self.file_path else Path('/var/log/observation-points')
         self.metrics_path = metrics_dir / 'metrics.jsonl'
         
+        # 本地时序环形缓冲（首次记录指标时打开）
+        self.timeseries_enabled = config.get('timeseries_enabled', True)
+        self.timeseries_path = Path(config.get('timeseries_path', metrics_dir / 'metrics.ring'))
+        self._timeseries = None  # type: Optional[TimeSeriesStore]
+        
         # 告警冷却记录
         self._cooldown_cache = {}  # type: Dict[str, Dict[str, datetime]]
         
@@ -202,9 +229,9 @@ class Reporter:
     def _is_in_cooldown(self, result: ObserverResult) -> bool:
         """检查告警是否在冷却期内"""
         observer_cache = self._cooldown_cache.get(result.observer_name, {})
-        msg_hash = hash(result.message)
+        msg_hash = self._message_key(result.message)
         
-        last_time = observer_cache.get(str(msg_hash))
+        last_time = observer_cache.get(msg_hash)
         if last_time is None:
             return False
         
@@ -216,12 +243,35 @@ class Reporter:
         if result.observer_name not in self._cooldown_cache:
             self._cooldown_cache[result.observer_name] = {}
         
-        msg_hash = str(hash(result.message))
+        msg_hash = self._message_key(result.message)
         self._cooldown_cache[result.observer_name][msg_hash] = datetime.now()
         
         # 清理过期的冷却记录（避免内存泄漏）
         self._cleanup_cooldown_cache()
     
+    @staticmethod
+    def _message_key(message: str) -> str:
+        """冷却键：使用稳定哈希（内置 hash 每个进程随机化，无法跨重启恢复）"""
+        return format(zlib.crc32(message.encode('utf-8', 'replace')), '08x')
+    
+    def get_state(self) -> Dict[str, Any]:
+        """导出冷却计时，写入检查点"""
+        return {
+            observer_name: {key: ts.isoformat() for key, ts in cache.items()}
+            for observer_name, cache in self._cooldown_cache.items()
+        }
+    
+    def restore_state(self, state: Dict[str, Any]):
+        """从检查点恢复冷却计时，重启后不重复上报冷却期内的告警"""
+        for observer_name, cache in (state or {}).items():
+            restored = self._cooldown_cache.setdefault(observer_name, {})
+            for key, ts in cache.items():
+                try:
+                    restored[key] = _parse_isoformat(ts)
+                except (TypeError, ValueError):
+                    continue
+        self._cleanup_cooldown_cache()
+    
     def _cleanup_cooldown_cache(self):
         """清理过期的冷却记录"""
         now = datetime.now()
@@ -355,18 +405,50 @@ class Reporter:
             with open(self.metrics_path, 'a', encoding='utf-8') as f:
                 f.write(json.dumps(record, ensure_ascii=False) + '\n')
             
-            # 也推送指标到 Web 后端（如果启用）
+            self._record_timeseries(metrics)
+            
+            # 也推送指标到 Web 后端（如果启用），先经本地聚合
             if self.push_enabled and self.push_url:
-                self._push_metrics_to_web(record)
+                observer = metrics.get('observer') or 'agent'
+                for aggregated in self._aggregator.offer(observer, record):
+                    self._push_metrics_to_web(aggregated)
                 
         except Exception as e:
             logger.error(f"写入指标文件失败: {e}")
     
+    def _record_timeseries(self, metrics: Dict[str, Any]):
+        """把指标中的数值字段写入时序环形缓冲（按 <observer>/<metric> 分序列）"""
+        if not self.timeseries_enabled:
+            return
+        if self._timeseries is None:
+            try:
+                self._timeseries = TimeSeriesStore(
+                    self.timeseries_path,
+                    max_series=self.config.get('timeseries_max_series', DEFAULT_MAX_SERIES),
+                    capacity=self.config.get('timeseries_capacity', DEFAULT_CAPACITY),
+                )
+            except (OSError, ValueError) as e:
+                logger.error(f"打开时序文件失败，停用时序记录: {e}")
+                self.timeseries_enabled = False
+                return
+        observer = metrics.get('observer') or 'agent'
+        self._timeseries.record(observer, metrics, time.time())
+    
+    def close(self):
+        """推送未满的聚合窗口，释放时序文件映射"""
+        if self.push_enabled and self.push_url:
+            for aggregated in self._aggregator.flush():
+                self._push_metrics_to_web(aggregated)
+        if self._timeseries is not None:
+            self._timeseries.close()
+            self._timeseries = None
+    
     def _push_metrics_to_web(self, record: Dict[str, Any]):
-        """异步推送指标到 Web 后端"""
+        """异步推送指标到 Web 后端，并按响应更新背压等级"""
         def _do_push():
+            import urllib.error
+            import urllib.request
             try:
-                import urllib.request
                 data = json.dumps({
                     'type': 'metrics',
                     **record,
@@ -376,7 +458,12 @@ class Reporter:
                     data=data,
                     headers={'Content-Type': 'application/json'},
                 )
-                urllib.request.urlopen(req, timeout=self.push_timeout)
+                with urllib.request.urlopen(req, timeout=self.push_timeout) as resp:
+                    self._aggregator.update_pressure(
+                        resp.status, resp.headers.get(PRESSURE_HEADER))
+            except urllib.error.HTTPError as e:
+                self._aggregator.update_pressure(
+                    e.code, e.headers.get(PRESSURE_HEADER) if e.headers else None)
             except Exception:
                 pass  # 指标推送失败不记录，避免日志膨胀
         
@@ -8,11 +8,15 @@
 import logging
 import time
 from datetime import datetime
-from typing import Any, Dict, List, Tuple
+from typing import Any, Dict, List, Optional, Tuple
 
 from .base import BaseObserver, ObserverResult, AlertLevel
+from .checkpoint import CheckpointStore, DEFAULT_CHECKPOINT_INTERVAL, DEFAULT_CHECKPOINT_PATH
 from .reporter import Reporter
 from .updater import AgentUpdater
+from ..observers.registry import load_observer_class
+from ..utils import proctable, sysstats
+from ..utils.cli_session import close_all_sessions
 
 logger = logging.getLogger(__name__)
 
@@ -43,14 +47,25 @@ class Scheduler:
         self._running = False
         self._observers = []  # type: List[Tuple[BaseObserver, float]]
         self._start_work_ready = True
-        self._updater = AgentUpdater(config)
+        global_cfg = config.get('global', {}) or {}
+        # 自更新重启前写入检查点，新进程从同一位置继续
+        self._updater = AgentUpdater(config, before_restart=self.save_checkpoint)
         self._next_update_check = time.time() + 60
-        self._update_interval_seconds = int((config.get('global', {}) or {}).get('update_check_interval_seconds', 1800))
+        self._update_interval_seconds = int(global_cfg.get('update_check_interval_seconds', 1800))
         # Per-observer consecutive failure counts for backoff tracking
         self._observer_failures: Dict[str, int] = {}
 
+        # 状态检查点（日志偏移、活跃告警、冷却计时等），重启后恢复
+        self._checkpoint = None  # type: Optional[CheckpointStore]
+        if global_cfg.get('checkpoint_enabled', True):
+            self._checkpoint = CheckpointStore(global_cfg.get('checkpoint_path', DEFAULT_CHECKPOINT_PATH))
+        self._checkpoint_interval = max(
+            5, int(global_cfg.get('checkpoint_interval_seconds', DEFAULT_CHECKPOINT_INTERVAL)))
+        self._next_checkpoint = time.time() + self._checkpoint_interval
+
         # 从配置加载并注册观察点
         self._load_observers()
+        self._restore_checkpoint()
 
     def _record_failure(self, name: str, exc: Exception) -> None:
         """Record an observer failure.
@@ -89,19 +104,66 @@ class Scheduler:
         if prev >= _FAILURE_LOG_THRESHOLD:
             logger.info("[%s] 恢复正常运行（此前连续失败 %d 次）", name, prev)
     
+    def _restore_checkpoint(self):
+        """启动时从检查点恢复各观察点与上报器状态"""
+        if self._checkpoint is None:
+            return
+        data = self._checkpoint.load()
+        if not data:
+            return
+        states = data.get('observers', {}) or {}
+        restored = 0
+        for observer, _ in self._observers:
+            state = states.get(observer.name)
+            if not state or not hasattr(observer, 'restore_state'):
+                continue
+            try:
+                observer.restore_state(state)
+                restored += 1
+            except Exception as e:
+                logger.warning(f"[{observer.name}] 恢复检查点失败，按初始状态运行: {e}")
+        if hasattr(self.reporter, 'restore_state'):
+            try:
+                self.reporter.restore_state(data.get('reporter', {}))
+            except Exception as e:
+                logger.warning(f"恢复上报器检查点失败: {e}")
+        logger.info(f"已从检查点恢复 {restored} 个观察点状态")
+
+    def save_checkpoint(self) -> bool:
+        """写入状态检查点"""
+        checkpoint = getattr(self, '_checkpoint', None)
+        if checkpoint is None:
+            return False
+        states = {}
+        for observer, _ in self._observers:
+            get_state = getattr(observer, 'get_state', None)
+            if get_state is None:
+                continue
+            try:
+                state = get_state()
+            except Exception as e:
+                logger.warning(f"[{observer.name}] 导出状态失败: {e}")
+                continue
+            if state is not None:
+                states[observer.name] = state
+        reporter_state = self.reporter.get_state() if hasattr(self.reporter, 'get_state') else {}
+        self._next_checkpoint = time.time() + self._checkpoint_interval
+        return checkpoint.save(states, reporter_state)
+
     def _load_observers(self):
-        """从配置加载观察点"""
+        """从配置加载观察点（只导入已启用观察点的模块）"""
         observers_config = self.config.get('observers', {})
         
-        # 动态导入观察点模块
-        observer_classes = self._get_observer_classes()
-        
         for name, obs_config in observers_config.items():
             if not obs_config.get('enabled', True):
                 logger.debug(f"跳过禁用的观察点: {name}")
                 continue
             
-            obs_class = observer_classes.get(name)
+            try:
+                obs_class = load_observer_class(name)
+            except Exception as e:
+                logger.error(f"加载观察点模块失败 {name}: {e}")
+                continue
             if obs_class is None:
                 logger.warning(f"未知观察点: {name}")
                 continue
@@ -114,8 +176,10 @@ class Scheduler:
                 logger.error(f"初始化失败 {name}: {e}")
 
         # Load custom_monitors (from admin-deployed templates)
-        from ..observers.custom_monitor import CustomMonitorObserver as CustomMonCls
         custom_monitors = self.config.get('custom_monitors', [])
+        if not custom_monitors:
+            return
+        from ..observers.custom_monitor import CustomMonitorObserver as CustomMonCls
         for i, mon_config in enumerate(custom_monitors):
             name = mon_config.get('name') or f'custom_monitor_{i}'
             obs_config = {
@@ -130,62 +194,6 @@ class Scheduler:
             except Exception as e:
                 logger.error(f"自定义监控 {name} 初始化失败: {e}")
     
-    def _get_observer_classes(self) -> Dict[str, type]:
-        """获取所有观察点类的映射"""
-        from ..observers.error_code import ErrorCodeObserver
-        from ..observers.link_status import LinkStatusObserver
-        from ..observers.card_recovery import CardRecoveryObserver
-        from ..observers.sensitive_info import SensitiveInfoObserver
-        from ..observers.custom_command import CustomCommandObserver
-        from ..observers.alarm_type import AlarmTypeObserver
-        from ..observers.memory_leak import MemoryLeakObserver
-        from ..observers.cpu_usage import CpuUsageObserver
-        from ..observers.cmd_response import CmdResponseObserver
-        from ..observers.sig_monitor import SigMonitorObserver
-        from ..observers.port_fec import PortFecObserver
-        from ..observers.port_speed import PortSpeedObserver
-        from ..observers.pcie_bandwidth import PcieBandwidthObserver
-        from ..observers.card_info import CardInfoObserver
-        from ..observers.port_counters import PortCountersObserver
-        from ..observers.controller_state import ControllerStateObserver
-        from ..observers.disk_state import DiskStateObserver
-        from ..observers.process_crash import ProcessCrashObserver
-        from ..observers.io_timeout import IoTimeoutObserver
-        from ..observers.port_error_code import PortErrorCodeObserver
-        from ..observers.process_restart import ProcessRestartObserver
-        from ..observers.sfp_monitor import SfpMonitorObserver
-        from ..observers.abnormal_reset import AbnormalResetObserver
-        from ..observers.custom_monitor import CustomMonitorObserver
-        from ..observers.start_work import StartWorkObserver
-        
-        return {
-            'error_code': ErrorCodeObserver,
-            'link_status': LinkStatusObserver,
-            'card_recovery': CardRecoveryObserver,
-            'sensitive_info': SensitiveInfoObserver,
-            'custom_commands': CustomCommandObserver,
-            'alarm_type': AlarmTypeObserver,
-            'memory_leak': MemoryLeakObserver,
-            'cpu_usage': CpuUsageObserver,
-            'cmd_response': CmdResponseObserver,
-            'sig_monitor': SigMonitorObserver,
-            'port_fec': PortFecObserver,
-            'port_speed': PortSpeedObserver,
-            'pcie_bandwidth': PcieBandwidthObserver,
-            'card_info': CardInfoObserver,
-            'port_counters': PortCountersObserver,
-            'controller_state': ControllerStateObserver,
-            'disk_state': DiskStateObserver,
-            'process_crash': ProcessCrashObserver,
-            'io_timeout': IoTimeoutObserver,
-            'port_error_code': PortErrorCodeObserver,
-            'process_restart': ProcessRestartObserver,
-            'sfp_monitor': SfpMonitorObserver,
-            'abnormal_reset': AbnormalResetObserver,
-            'start_work': StartWorkObserver,
-            'custom_monitor': CustomMonitorObserver,
-        }
-    
     def register(self, observer: BaseObserver):
         """
         注册观察点
@@ -206,6 +214,9 @@ class Scheduler:
         while self._running:
             now = time.time()
             next_wakeup = now + 60  # 默认最长等待60秒
+            # 本轮进程类、系统统计类观察点各自共享同一份 /proc 快照
+            proctable.new_tick()
+            sysstats.new_tick()
 
             if now >= self._next_update_check:
                 self._updater.check_and_apply_update()
@@ -276,6 +287,11 @@ class Scheduler:
                 if next_run < next_wakeup:
                     next_wakeup = next_run
             
+            if self._checkpoint is not None:
+                if time.time() >= self._next_checkpoint:
+                    self.save_checkpoint()
+                next_wakeup = min(next_wakeup, self._next_checkpoint)
+
             # 休眠到下次执行时间
             sleep_time = max(0.1, next_wakeup - time.time())
             time.sleep(sleep_time)
@@ -285,11 +301,18 @@ class Scheduler:
         self._running = False
         logger.info("调度器停止中...")
         
+        # 清理前保存状态，下次启动从此处继续
+        self.save_checkpoint()
+        
         # 清理所有观察点
         for observer, _ in self._observers:
             try:
                 observer.cleanup()
             except Exception as e:
                 logger.error(f"[{observer.name}] 清理失败: {e}")
+        close_all_sessions()
+        reporter = getattr(self, 'reporter', None)
+        if reporter is not None and hasattr(reporter, 'close'):
+            reporter.close()
         
         logger.info("调度器已停止")
@@ -0,0 +1,300 @@
+"""
+本地时序环形缓冲
+
+按观察点指标（``<observer>/<metric>``）保存最近的 (时间戳, 数值) 点，整个存储是一个
+固定大小的内存映射文件，写满后逐点覆盖最旧数据。上报器每次 record_metrics 时写入；
+``python3 -m observation_points.query`` 以只读方式映射同一文件，按时间范围 / 最近 N 点 /
+聚合查询，后端一次调用即可取回所需窗口，无需 tail 并解析整段 metrics.jsonl。
+
+文件布局（小端）：
+    头部      64 字节：magic、版本、最大序列数、每序列容量
+    序列目录  max_series × 96 字节：名称(80) + seq + head + count + 保留
+    数据区    max_series × capacity × 16 字节：(ts: float64, value: float64)
+
+单写多读：写入方按序列维护 seq（奇数表示写入中），读取方读前后比较 seq，不一致则重试。
+"""
+
+import logging
+import mmap
+import os
+import struct
+import sys
+import threading
+from array import array
+from bisect import bisect_left, bisect_right
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple, Union
+
+logger = logging.getLogger(__name__)
+
+MAGIC = b'OPTS'
+VERSION = 1
+
+DEFAULT_MAX_SERIES = 128
+# 每序列默认 2880 点：60s 采样约 48 小时
+DEFAULT_CAPACITY = 2880
+
+_HEADER = struct.Struct('<4sIII')
+_HEADER_SIZE = 64
+_NAME_SIZE = 80
+_ENTRY = struct.Struct('<%dsIII4x' % _NAME_SIZE)
+_ENTRY_SIZE = _ENTRY.size
+_STATE = struct.Struct('<III')
+_POINT = struct.Struct('<dd')
+
+_READ_RETRIES = 5
+
+Point = Tuple[float, float]
+
+
+class TimeSeriesStore(object):
+    """内存映射的多序列环形缓冲"""
+
+    def __init__(self, path, max_series=DEFAULT_MAX_SERIES, capacity=DEFAULT_CAPACITY,
+                 readonly=False):
+        # type: (Union[str, Path], int, int, bool) -> None
+        self.path = Path(path)
+        self.readonly = readonly
+        self._lock = threading.Lock()
+        self._index = {}  # type: Dict[str, int]
+        self._full_warned = False
+        if readonly:
+            self._open_readonly()
+        else:
+            self._open_writable(max(1, int(max_series)), max(2, int(capacity)))
+        self._load_index()
+
+    # ---------- 打开 ----------
+
+    def _open_readonly(self):
+        fd = os.open(str(self.path), os.O_RDONLY)
+        try:
+            self._mm = mmap.mmap(fd, 0, access=mmap.ACCESS_READ)
+        finally:
+            os.close(fd)
+        dims = self._read_header()
+        if dims is None:
+            self._mm.close()
+            raise ValueError(f"不是有效的时序文件: {self.path}")
+        self.max_series, self.capacity = dims
+
+    def _open_writable(self, max_series, capacity):
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        size = _file_size(max_series, capacity)
+        fd = os.open(str(self.path), os.O_RDWR | os.O_CREAT, 0o644)
+        try:
+            existing = os.fstat(fd).st_size
+            fresh = existing != size
+            if fresh:
+                # 尺寸变化（配置修改）或新文件：重建，空洞文件不占实际磁盘
+                os.ftruncate(fd, 0)
+                os.ftruncate(fd, size)
+            self._mm = mmap.mmap(fd, size)
+        finally:
+            os.close(fd)
+        if not fresh and self._read_header() != (max_series, capacity):
+            fresh = True
+            self._mm[:_HEADER_SIZE + max_series * _ENTRY_SIZE] = \
+                bytes(_HEADER_SIZE + max_series * _ENTRY_SIZE)
+        if fresh:
+            if existing:
+                logger.info(f"时序文件尺寸或格式变化，已重建: {self.path}")
+            _HEADER.pack_into(self._mm, 0, MAGIC, VERSION, max_series, capacity)
+        self.max_series = max_series
+        self.capacity = capacity
+
+    def _read_header(self):
+        # type: () -> Optional[Tuple[int, int]]
+        if len(self._mm) < _HEADER_SIZE:
+            return None
+        magic, version, max_series, capacity = _HEADER.unpack_from(self._mm, 0)
+        if magic != MAGIC or version != VERSION or not max_series or not capacity:
+            return None
+        if len(self._mm) < _file_size(max_series, capacity):
+            return None
+        return max_series, capacity
+
+    def _load_index(self):
+        self._index = {}
+        for slot in range(self.max_series):
+            name = self._mm[self._entry_offset(slot):self._entry_offset(slot) + _NAME_SIZE]
+            name = name.rstrip(b'\0')
+            if not name:
+                break
+            self._index[name.decode('utf-8', 'replace')] = slot
+
+    def close(self):
+        mm = getattr(self, '_mm', None)
+        if mm is None:
+            return
+        if not self.readonly:
+            try:
+                mm.flush()
+            except (OSError, ValueError):
+                pass
+        mm.close()
+        self._mm = None
+
+    # ---------- 布局 ----------
+
+    def _entry_offset(self, slot):
+        # type: (int) -> int
+        return _HEADER_SIZE + slot * _ENTRY_SIZE
+
+    def _data_offset(self, slot):
+        # type: (int) -> int
+        return _HEADER_SIZE + self.max_series * _ENTRY_SIZE + slot * self.capacity * _POINT.size
+
+    # ---------- 写入 ----------
+
+    def append(self, series, ts, value):
+        # type: (str, float, float) -> bool
+        """追加一个点；序列表已满或名称过长时返回 False"""
+        with self._lock:
+            slot = self._slot_for(series)
+            if slot is None:
+                return False
+            state_off = self._entry_offset(slot) + _NAME_SIZE
+            seq, head, count = _STATE.unpack_from(self._mm, state_off)
+            _STATE.pack_into(self._mm, state_off, (seq + 1) & 0xFFFFFFFF, head, count)
+            _POINT.pack_into(self._mm, self._data_offset(slot) + head * _POINT.size,
+                             float(ts), float(value))
+            head = (head + 1) % self.capacity
+            count = min(count + 1, self.capacity)
+            _STATE.pack_into(self._mm, state_off, (seq + 2) & 0xFFFFFFFF, head, count)
+            return True
+
+    def record(self, observer, metrics, ts):
+        # type: (str, Dict[str, Any], float) -> int
+        """把一条指标记录中的数值字段逐个写入 ``<observer>/<key>``，返回写入点数"""
+        written = 0
+        for key, value in metrics.items():
+            if isinstance(value, bool) or not isinstance(value, (int, float)):
+                continue
+            if self.append(f"{observer}/{key}", ts, value):
+                written += 1
+        return written
+
+    def _slot_for(self, series):
+        # type: (str) -> Optional[int]
+        slot = self._index.get(series)
+        if slot is not None:
+            return slot
+        name = series.encode('utf-8')
+        if len(name) > _NAME_SIZE or not name:
+            logger.debug(f"时序名称过长，忽略: {series}")
+            return None
+        slot = len(self._index)
+        if slot >= self.max_series:
+            if not self._full_warned:
+                logger.warning(f"时序序列数已达上限 {self.max_series}，新序列不再记录")
+                self._full_warned = True
+            return None
+        # 先清空状态再写名称，读取方看到名称时序列一定是空的
+        _STATE.pack_into(self._mm, self._entry_offset(slot) + _NAME_SIZE, 0, 0, 0)
+        self._mm[self._entry_offset(slot):self._entry_offset(slot) + _NAME_SIZE] = \
+            name.ljust(_NAME_SIZE, b'\0')
+        self._index[series] = slot
+        return slot
+
+    # ---------- 读取 ----------
+
+    def series(self):
+        # type: () -> List[str]
+        """所有序列名（只读模式下会重新扫描目录以发现新序列）"""
+        if self.readonly:
+            self._load_index()
+        return sorted(self._index)
+
+    def _points(self, series):
+        # type: (str) -> List[Point]
+        """按写入顺序返回序列中的全部点"""
+        if self.readonly and series not in self._index:
+            self._load_index()
+        slot = self._index.get(series)
+        if slot is None:
+            return []
+        state_off = self._entry_offset(slot) + _NAME_SIZE
+        base = self._data_offset(slot)
+        for _ in range(_READ_RETRIES):
+            seq, head, count = _STATE.unpack_from(self._mm, state_off)
+            raw = array('d')
+            raw.frombytes(self._mm[base:base + self.capacity * _POINT.size])
+            if not seq & 1 and _STATE.unpack_from(self._mm, state_off)[0] == seq:
+                break
+        else:
+            logger.debug(f"时序读取与写入冲突，返回可能不一致的数据: {series}")
+        if sys.byteorder == 'big':
+            raw.byteswap()
+        start = (head - count) % self.capacity
+        order = [(start + i) % self.capacity for i in range(count)]
+        return [(raw[2 * i], raw[2 * i + 1]) for i in order]
+
+    def query(self, series, since=None, until=None, last=None):
+        # type: (str, Optional[float], Optional[float], Optional[int]) -> List[Point]
+        """
+        按时间范围和/或最近 N 点查询
+
+        Args:
+            since / until: 时间戳闭区间，None 表示不限
+            last: 只返回（范围内）最近 N 个点
+        """
+        points = self._points(series)
+        if since is not None or until is not None:
+            stamps = [p[0] for p in points]
+            lo = bisect_left(stamps, since) if since is not None else 0
+            hi = bisect_right(stamps, until) if until is not None else len(points)
+            points = points[lo:hi]
+        if last is not None:
+            points = points[-last:] if last > 0 else []
+        return points
+
+    def aggregate(self, series, since=None, until=None, step=None):
+        # type: (str, Optional[float], Optional[float], Optional[float]) -> Any
+        """
+        聚合查询
+
+        Returns:
+            step 为空：整段范围的 {count, min, max, avg, first, last}；
+            否则按 step 秒对齐分桶，返回 [{ts, count, min, max, avg}, ...]
+        """
+        points = self.query(series, since=since, until=until)
+        if not step:
+            return summarize(points)
+        buckets = []  # type: List[Dict[str, Any]]
+        current = None
+        bucket_points = []  # type: List[Point]
+        for point in points:
+            key = point[0] - point[0] % step
+            if key != current and bucket_points:
+                buckets.append(dict(summarize(bucket_points), ts=current))
+                bucket_points = []
+            current = key
+            bucket_points.append(point)
+        if bucket_points:
+            buckets.append(dict(summarize(bucket_points), ts=current))
+        for bucket in buckets:
+            bucket.pop('first', None)
+            bucket.pop('last', None)
+        return buckets
+
+
+def summarize(points):
+    # type: (List[Point]) -> Dict[str, Any]
+    """一组点的 count/min/max/avg/first/last"""
+    if not points:
+        return {'count': 0, 'min': None, 'max': None, 'avg': None, 'first': None, 'last': None}
+    values = [p[1] for p in points]
+    return {
+        'count': len(values),
+        'min': min(values),
+        'max': max(values),
+        'avg': sum(values) / len(values),
+        'first': values[0],
+        'last': values[-1],
+    }
+
+
+def _file_size(max_series, capacity):
+    # type: (int, int) -> int
+    return _HEADER_SIZE + max_series * _ENTRY_SIZE + max_series * capacity * _POINT.size
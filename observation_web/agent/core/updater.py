@@ -20,8 +20,10 @@ HASH_FILE = Path("/etc/observation-points/.package_hash")
 
 
 class AgentUpdater:
-    def __init__(self, config: dict):
+    def __init__(self, config: dict, before_restart=None):
         self.config = config
+        # 重启前回调（调度器用于写入状态检查点）
+        self.before_restart = before_restart
 
     def _base_url(self) -> str:
         push_url = ((self.config.get("reporter", {}) or {}).get("push_url") or "").strip()
@@ -61,6 +63,11 @@ class AgentUpdater:
             return resp.read()
 
     def _restart_self(self):
+        if self.before_restart is not None:
+            try:
+                self.before_restart()
+            except Exception as e:
+                logger.warning("Pre-restart hook failed: %s", e)
         runtime = self.config.get("_runtime", {}) or {}
         python_exe = runtime.get("python_executable") or sys.executable
         argv = runtime.get("argv") or [
@@ -1,40 +1,70 @@
-"""观察点模块"""
+"""
+观察点模块
+
+包本身不导入任何观察点：调度器经 registry 按配置只导入已启用的模块。
+包级类名（如 ``from observers import CpuUsageObserver``、``import *``）在首次
+访问时才导入对应子模块。模块级 ``__getattr__``（PEP 562）要求 Python 3.7，
+agent 需支持 3.6，因此改用 ModuleType 子类实现。
+"""
+
+import importlib
+import sys
+import types
+
+# 类名 → 子模块
+_CLASS_MODULES = {
+    'PortCountersObserver': 'port_counters',
+    'ErrorCodeObserver': 'error_code',
+    'PortErrorCodeObserver': 'port_error_code',
+    'NetworkErrorsObserver': 'network_errors',
+    'LinkStatusObserver': 'link_status',
+    'CardRecoveryObserver': 'card_recovery',
+    'SensitiveInfoObserver': 'sensitive_info',
+    'CustomCommandObserver': 'custom_command',
+    'AlarmTypeObserver': 'alarm_type',
+    'MemoryLeakObserver': 'memory_leak',
+    'CpuUsageObserver': 'cpu_usage',
+    'CmdResponseObserver': 'cmd_response',
+    'SigMonitorObserver': 'sig_monitor',
+    'PortFecObserver': 'port_fec',
+    'PortSpeedObserver': 'port_speed',
+    'PcieBandwidthObserver': 'pcie_bandwidth',
+    'CardInfoObserver': 'card_info',
+    'ControllerStateObserver': 'controller_state',
+    'DiskStateObserver': 'disk_state',
+    'ProcessCrashObserver': 'process_crash',
+    'IoTimeoutObserver': 'io_timeout',
+    'DiskIoObserver': 'disk_io',
+    'DiskSpaceObserver': 'disk_space',
+    'LoadAverageObserver': 'load_average',
+    'SwapUsageObserver': 'swap_usage',
+    'TcpConnectionsObserver': 'tcp_connections',
+    'ZombieProcessesObserver': 'zombie_processes',
+    'FileDescriptorsObserver': 'file_descriptors',
+    'ThermalObserver': 'thermal',
+    'DmesgErrorsObserver': 'dmesg_errors',
+    'SystemUptimeObserver': 'system_uptime',
+    'ProcessRestartObserver': 'process_restart',
+    'SfpMonitorObserver': 'sfp_monitor',
+    'AbnormalResetObserver': 'abnormal_reset',
+    'StartWorkObserver': 'gate.start_work',
+}
+
+
+class _LazyObserversModule(types.ModuleType):
+    """包模块：访问未导入的类名时导入其子模块"""
+
+    def __getattr__(self, name):
+        module_name = _CLASS_MODULES.get(name)
+        if module_name is None:
+            raise AttributeError(f"module {self.__name__!r} has no attribute {name!r}")
+        value = getattr(importlib.import_module('.' + module_name, self.__name__), name)
+        setattr(self, name, value)
+        return value
+
+
+sys.modules[__name__].__class__ = _LazyObserversModule
 
-from .port_counters import PortCountersObserver
-from .error_code import ErrorCodeObserver
-from .link_status import LinkStatusObserver
-from .card_recovery import CardRecoveryObserver
-from .sensitive_info import SensitiveInfoObserver
-from .custom_command import CustomCommandObserver
-from .alarm_type import AlarmTypeObserver
-from .memory_leak import MemoryLeakObserver
-from .cpu_usage import CpuUsageObserver
-from .cmd_response import CmdResponseObserver
-from .sig_monitor import SigMonitorObserver
-from .port_fec import PortFecObserver
-from .port_speed import PortSpeedObserver
-from .pcie_bandwidth import PcieBandwidthObserver
-from .card_info import CardInfoObserver
-from .controller_state import ControllerStateObserver
-from .disk_state import DiskStateObserver
-from .process_crash import ProcessCrashObserver
-from .io_timeout import IoTimeoutObserver
-from .disk_io import DiskIoObserver
-from .disk_space import DiskSpaceObserver
-from .load_average import LoadAverageObserver
-from .network_errors import NetworkErrorsObserver
-from .swap_usage import SwapUsageObserver
-from .tcp_connections import TcpConnectionsObserver
-from .zombie_processes import ZombieProcessesObserver
-from .file_descriptors import FileDescriptorsObserver
-from .thermal import ThermalObserver
-from .dmesg_errors import DmesgErrorsObserver
-from .system_uptime import SystemUptimeObserver
-from .port_error_code import PortErrorCodeObserver
-from .process_restart import ProcessRestartObserver
-from .sfp_monitor import SfpMonitorObserver
-from .abnormal_reset import AbnormalResetObserver
-from .start_work import StartWorkObserver
 
 __all__ = [
     'PortCountersObserver',
@@ -8,6 +8,9 @@ os_cli 是交互式命令：
   1. 运行 os_cli → 等待回显 "succeed" 或 "success"（约 5 秒）
   2. 就绪后在同一会话中执行 cat log_reset.txt
   3. 解析输出中的 reason / time 字段
+
+默认复用常驻 os_cli 会话（utils/cli_session），只在首次或会话异常时启动并
+等待就绪；persistent_session 设为 false 时回退为每次启动 os_cli 并退出。
 """
 
 import logging
@@ -19,6 +22,7 @@ import time
 from typing import Any, Dict, List, Optional, Set
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.cli_session import get_cli_session
 
 logger = logging.getLogger(__name__)
 
@@ -68,6 +72,8 @@ class AbnormalResetObserver(BaseObserver):
         self.ready_timeout = config.get('ready_timeout', 10)
         self.ready_keyword = config.get('ready_keyword', 'succeed')
         self.ensure_path = config.get('ensure_path', True)
+        self.persistent_session = config.get('persistent_session', True)
+        self.command_timeout = config.get('command_timeout', 30)
 
         # Legacy: support old 'command' field for backward-compat
         old_cmd = config.get('command', '')
@@ -81,6 +87,19 @@ class AbnormalResetObserver(BaseObserver):
         ]
         self._last_reported_times: Set[str] = set()
 
+    def _run_in_session(self) -> tuple:
+        """在常驻 os_cli 会话中执行 inner_cmd，返回 (returncode, stdout, stderr)"""
+        keywords = [self.ready_keyword]
+        if self.ready_keyword.lower() != 'success':
+            keywords.append('success')
+        session = get_cli_session(
+            self.os_cli_cmd,
+            ready_keywords=keywords,
+            ready_timeout=self.ready_timeout,
+            ensure_path=self.ensure_path,
+        )
+        return session.run(self.inner_cmd, timeout=self.command_timeout)
+
     def _run_os_cli(self) -> tuple:
         """
         Two-stage interactive execution:
@@ -156,7 +175,10 @@ class AbnormalResetObserver(BaseObserver):
         return proc.returncode or 0, "".join(stdout_buf), "".join(stderr_buf)
 
     def check(self) -> ObserverResult:
-        ret, stdout, stderr = self._run_os_cli()
+        if self.persistent_session:
+            ret, stdout, stderr = self._run_in_session()
+        else:
+            ret, stdout, stderr = self._run_os_cli()
 
         if ret != 0:
             err_preview = (stderr or '')[:200]
@@ -19,6 +19,7 @@ from pathlib import Path
 from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..core.checkpoint import log_cursor, restore_log_cursor
 from ..utils.helpers import tail_file
 
 logger = logging.getLogger(__name__)
@@ -63,6 +64,7 @@ class AlarmTypeObserver(BaseObserver):
         
         # 文件读取位置
         self._file_position = 0
+        self._file_inode = None  # type: Optional[int]
         self._first_run = True
         
         # 统计数据
@@ -76,6 +78,30 @@ class AlarmTypeObserver(BaseObserver):
         # 最近的告警事件（用于展示，包含 recovered 标记）
         self._recent_events = deque(maxlen=self.recent_count)  # type: deque
     
+    def get_state(self) -> Optional[Dict[str, Any]]:
+        return {
+            'cursor': log_cursor(self._file_position, self._file_inode),
+            'total_event_count': self._total_event_count,
+            'total_send_count': self._total_send_count,
+            'total_resume_count': self._total_resume_count,
+            # 保持插入顺序
+            'active_alarms': list(self._active_alarms.items()),
+            'recent_events': list(self._recent_events),
+        }
+    
+    def restore_state(self, state: Dict[str, Any]):
+        restored = restore_log_cursor(self.log_path, state.get('cursor'))
+        if restored is not None:
+            self._file_position, self._file_inode = restored
+            self._first_run = False
+        self._total_event_count = state.get('total_event_count', 0)
+        self._total_send_count = state.get('total_send_count', 0)
+        self._total_resume_count = state.get('total_resume_count', 0)
+        # 活跃告警跨重启保留：停机前未恢复的告警，重启后收到 resume 仍能正确消除
+        for alarm_id, event in state.get('active_alarms', []):
+            self._active_alarms[alarm_id] = event
+        self._recent_events.extend(state.get('recent_events', []))
+    
     def check(self) -> ObserverResult:
         """检查 AlarmType 事件"""
         # 首次运行时跳过历史数据
@@ -83,11 +109,12 @@ class AlarmTypeObserver(BaseObserver):
         self._first_run = False
         
         # 读取新增日志行
-        new_lines, new_position = tail_file(
+        new_lines, new_position, self._file_inode = tail_file(
             self.log_path,
             self._file_position,
             self.max_lines_per_check,
-            skip_existing=skip_existing
+            skip_existing=skip_existing,
+            with_inode=True,
         )
         self._file_position = new_position
         
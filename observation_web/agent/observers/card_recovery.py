@@ -13,6 +13,7 @@ from pathlib import Path
 from typing import Any, Dict, List, Optional, Tuple
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..core.checkpoint import log_cursor, restore_log_cursor
 from ..utils.helpers import tail_file, get_bus_to_slot_mapping
 
 logger = logging.getLogger(__name__)
@@ -50,12 +51,28 @@ class CardRecoveryObserver(BaseObserver):
         
         # 文件读取位置
         self._file_position = 0
+        self._file_inode = None  # type: Optional[int]
         self._first_run = True
         
         # 统计数据
         self._total_count = 0
         self._recent_events = deque(maxlen=3)  # type: deque
     
+    def get_state(self) -> Optional[Dict[str, Any]]:
+        return {
+            'cursor': log_cursor(self._file_position, self._file_inode),
+            'total_count': self._total_count,
+            'recent_events': list(self._recent_events),
+        }
+    
+    def restore_state(self, state: Dict[str, Any]):
+        restored = restore_log_cursor(self.log_path, state.get('cursor'))
+        if restored is not None:
+            self._file_position, self._file_inode = restored
+            self._first_run = False
+        self._total_count = state.get('total_count', 0)
+        self._recent_events.extend(state.get('recent_events', []))
+    
     def check(self) -> ObserverResult:
         """检查卡修复事件"""
         # 首次运行时跳过历史数据
@@ -63,11 +80,12 @@ class CardRecoveryObserver(BaseObserver):
         self._first_run = False
         
         # 读取新增日志行
-        new_lines, new_position = tail_file(
+        new_lines, new_position, self._file_inode = tail_file(
             self.log_path,
             self._file_position,
             self.max_lines_per_check,
-            skip_existing=skip_existing
+            skip_existing=skip_existing,
+            with_inode=True,
         )
         self._file_position = new_position
         
@@ -2,6 +2,8 @@
 命令响应时间监测观察点
 
 通过 time 命令执行指定命令，检查响应时间是否在阈值内。
+配置 cli_session 时命令在常驻 CLI 会话中执行，测量的是命令本身的响应时间，
+不含 CLI 启动与登录。
 """
 
 import logging
@@ -11,6 +13,7 @@ from datetime import datetime
 from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.cli_session import session_for
 from ..utils.helpers import run_command
 
 logger = logging.getLogger(__name__)
@@ -36,6 +39,9 @@ class CmdResponseObserver(BaseObserver):
         
         # 命令执行超时（秒）- 比阈值稍长，防止卡死
         self.execution_timeout = config.get('execution_timeout', 10)
+        
+        # 常驻 CLI 会话配置（如 "os_cli"），为空则每次通过 shell 执行
+        self.cli_session = config.get('cli_session')
     
     def check(self) -> ObserverResult:
         """检查命令响应时间"""
@@ -84,13 +90,19 @@ class CmdResponseObserver(BaseObserver):
         start_time = time.time()
         
         try:
-            ret, stdout, stderr = run_command(
-                cmd, 
-                shell=True, 
-                timeout=self.execution_timeout
-            )
-            
-            elapsed = time.time() - start_time
+            if self.cli_session:
+                session = session_for(self.cli_session)
+                ret, stdout, stderr = session.run(cmd, timeout=self.execution_timeout)
+                # 会话首次启动或重启的耗时不计入命令响应时间
+                elapsed = session.last_command_seconds if ret == 0 else time.time() - start_time
+            else:
+                ret, stdout, stderr = run_command(
+                    cmd, 
+                    shell=True, 
+                    timeout=self.execution_timeout
+                )
+                
+                elapsed = time.time() - start_time
             
             return {
                 'command': cmd,
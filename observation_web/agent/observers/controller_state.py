@@ -12,7 +12,7 @@ from datetime import datetime
 from typing import Any, Dict, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command
+from ..utils.cli_session import run_cli_command
 
 logger = logging.getLogger(__name__)
 
@@ -26,6 +26,7 @@ class ControllerStateObserver(BaseObserver):
         "enabled": true,
         "interval": 60,
         "command": "show controller status",
+        "cli_session": "os_cli",
         "keywords": ["online", "offline", "degraded"]
     }
     """
@@ -33,6 +34,9 @@ class ControllerStateObserver(BaseObserver):
     def __init__(self, name: str, config: Dict[str, Any]):
         super().__init__(name, config)
         self.command = config.get('command', '')
+        # 配置后命令在常驻 CLI 会话中执行（如 "os_cli"），省去每次启动与登录
+        self.cli_session = config.get('cli_session')
+        self.timeout = config.get('timeout', 30)
         self.keywords = config.get('keywords', ['online', 'offline', 'degraded', 'normal'])
         self._last_states = {}  # controller_id -> state
 
@@ -43,7 +47,7 @@ class ControllerStateObserver(BaseObserver):
                 message="控制器状态监控：未配置命令，请在 config.json 中设置 command",
             )
 
-        ret, stdout, stderr = run_command(self.command, shell=True, timeout=30)
+        ret, stdout, stderr = run_cli_command(self.command, self.cli_session, timeout=self.timeout)
         if ret != 0:
             return self.create_result(
                 has_alert=True,
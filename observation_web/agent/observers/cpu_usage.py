@@ -1,7 +1,8 @@
 """
 CPU0 利用率监测观察点
 
-通过解析 /proc/stat 或 top 命令监测 CPU0 的利用率。
+通过共享系统统计快照（/proc/stat，按核解析）或 top 命令监测 CPU0 的利用率，
+同时给出总体及每核利用率。
 当连续 N 次（默认6次）检测超过阈值（默认90%）时告警。
 当利用率下降到阈值以下时，自动发出恢复告警，活跃问题面板中对应条目消失。
 """
@@ -10,11 +11,11 @@ import logging
 import re
 from collections import deque
 from datetime import datetime
-from pathlib import Path
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
 from ..utils.helpers import run_command
+from ..utils.sysstats import SystemStats, get_system_stats
 
 logger = logging.getLogger(__name__)
 
@@ -41,8 +42,11 @@ class CpuUsageObserver(BaseObserver):
         # 历史数据
         self._history = deque(maxlen=self.consecutive_threshold)  # type: deque
         
-        # 上次 /proc/stat 数据（用于计算利用率）
-        self._last_cpu_stats = None  # type: Optional[Tuple[int, int]]
+        # 上次系统统计快照（用于计算利用率）
+        self._last_stats = None  # type: Optional[SystemStats]
+        
+        # 最近一次的每核利用率 {'cpu': 总体, 'cpu0': ..., ...}
+        self._per_core = {}  # type: Dict[str, float]
         
         # 是否正在告警（用于状态转换检测，非永久 sticky）
         self._was_alerting = False
@@ -61,10 +65,13 @@ class CpuUsageObserver(BaseObserver):
         
         # 记录指标数据（每次都记录，无论是否告警）
         if reporter and hasattr(reporter, 'record_metrics'):
-            reporter.record_metrics({
+            metrics = {
                 'cpu0': round(cpu_usage, 1),
                 'observer': self.name,
-            })
+            }
+            if 'cpu' in self._per_core:
+                metrics['cpu_total'] = round(self._per_core['cpu'], 1)
+            reporter.record_metrics(metrics)
         
         # 记录当前值
         timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S')
@@ -84,6 +91,11 @@ class CpuUsageObserver(BaseObserver):
             'consecutive_threshold': self.consecutive_threshold,
             'consecutive_over_threshold': self._count_consecutive_over_threshold(),
         }
+        if self._per_core:
+            details['total_usage_percent'] = round(self._per_core.get('cpu', cpu_usage), 1)
+            details['per_core'] = {
+                name: round(value, 1) for name, value in self._per_core.items() if name != 'cpu'
+            }
         
         # 当前是否处于告警状态（连续超阈值 或 曾经触发且仍超阈值）
         currently_alerting = False
@@ -138,63 +150,23 @@ class CpuUsageObserver(BaseObserver):
         """
         获取 CPU0 利用率
         
-        通过读取 /proc/stat 计算 CPU0 的利用率。
+        基于本轮共享的 /proc/stat 快照与上次快照的差值计算，同时更新每核利用率。
         利用率 = (非空闲时间增量 / 总时间增量) * 100
         """
-        proc_stat = Path('/proc/stat')
+        stats = get_system_stats()
         
-        if not proc_stat.exists():
+        if stats is None or 'cpu0' not in stats.cpus:
             # 回退到 top 命令
+            self._per_core = {}
             return self._get_cpu0_usage_from_top()
         
-        try:
-            content = proc_stat.read_text()
-        except Exception as e:
-            logger.error(f"读取 /proc/stat 失败: {e}")
-            return self._get_cpu0_usage_from_top()
-        
-        # 解析 cpu0 行
-        # 格式: cpu0 user nice system idle iowait irq softirq steal guest guest_nice
-        for line in content.split('\n'):
-            if line.startswith('cpu0 '):
-                parts = line.split()
-                if len(parts) >= 5:
-                    try:
-                        user = int(parts[1])
-                        nice = int(parts[2])
-                        system = int(parts[3])
-                        idle = int(parts[4])
-                        iowait = int(parts[5]) if len(parts) > 5 else 0
-                        
-                        # 计算总时间和空闲时间
-                        total = user + nice + system + idle + iowait
-                        idle_total = idle + iowait
-                        
-                        # 如果是首次运行，保存数据并返回 None
-                        if self._last_cpu_stats is None:
-                            self._last_cpu_stats = (total, idle_total)
-                            return None
-                        
-                        # 计算增量
-                        last_total, last_idle = self._last_cpu_stats
-                        total_delta = total - last_total
-                        idle_delta = idle_total - last_idle
-                        
-                        # 更新缓存
-                        self._last_cpu_stats = (total, idle_total)
-                        
-                        if total_delta <= 0:
-                            return None
-                        
-                        # 计算利用率
-                        usage = ((total_delta - idle_delta) / total_delta) * 100
-                        return max(0.0, min(100.0, usage))
-                        
-                    except (ValueError, IndexError) as e:
-                        logger.error(f"解析 /proc/stat 失败: {e}")
-                        return None
+        # 首次运行只保存基线
+        last, self._last_stats = self._last_stats, stats
+        if last is None or last is stats:
+            return None
         
-        return None
+        self._per_core = stats.cpu_usage(last)
+        return self._per_core.get('cpu0')
     
     def _get_cpu0_usage_from_top(self) -> Optional[float]:
         """通过 top 命令获取 CPU0 利用率（备用方案）"""
@@ -8,11 +8,10 @@ import logging
 import re
 from collections import deque
 from datetime import datetime
-from pathlib import Path
 from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command
+from ..utils.counters import DISKSTATS, get_counter_reader
 
 logger = logging.getLogger(__name__)
 
@@ -28,6 +27,7 @@ class DiskIoObserver(BaseObserver):
         self.throughput_threshold_mbps = config.get('throughput_threshold_mbps', 500)
         self.consecutive_threshold = config.get('consecutive_threshold', 3)
         self.disk_filter = config.get('disk_filter', r'^(sd[a-z]+|nvme\d+n\d+|vd[a-z]+)$')
+        self._disk_pattern = re.compile(self.disk_filter)
 
         self._last_stats: Dict[str, Dict] = {}
         self._alerts_history = deque(maxlen=self.consecutive_threshold)
@@ -137,37 +137,13 @@ class DiskIoObserver(BaseObserver):
         )
 
     def _read_diskstats(self) -> Dict[str, Dict]:
-        """读取 /proc/diskstats"""
-        stats = {}
-        diskstats_path = Path('/proc/diskstats')
-
-        if not diskstats_path.exists():
-            return stats
-
-        try:
-            content = diskstats_path.read_text()
-            pattern = re.compile(self.disk_filter)
-            now = datetime.now()
-
-            for line in content.strip().split('\n'):
-                parts = line.split()
-                if len(parts) < 14:
-                    continue
-
-                disk_name = parts[2]
-                if not pattern.match(disk_name):
-                    continue
-
-                stats[disk_name] = {
-                    'timestamp': now,
-                    'reads': int(parts[3]),
-                    'read_sectors': int(parts[5]),
-                    'writes': int(parts[7]),
-                    'write_sectors': int(parts[9]),
-                    'io_time_ms': int(parts[12]),
-                }
-
-        except Exception as e:
-            logger.error(f"读取 /proc/diskstats 失败: {e}")
-
+        """读取 /proc/diskstats（共享计数器读取层，fd 常驻）"""
+        data = get_counter_reader().read('/proc/diskstats')
+        if data is None:
+            return {}
+
+        stats = DISKSTATS.parse(data, self._disk_pattern)
+        now = datetime.now()
+        for disk_stats in stats.values():
+            disk_stats['timestamp'] = now
         return stats
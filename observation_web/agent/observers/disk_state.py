@@ -11,7 +11,7 @@ from datetime import datetime
 from typing import Any, Dict
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command
+from ..utils.cli_session import run_cli_command
 
 logger = logging.getLogger(__name__)
 
@@ -24,13 +24,17 @@ class DiskStateObserver(BaseObserver):
     {
         "enabled": true,
         "interval": 60,
-        "command": "show disk status"
+        "command": "show disk status",
+        "cli_session": "os_cli"
     }
     """
 
     def __init__(self, name: str, config: Dict[str, Any]):
         super().__init__(name, config)
         self.command = config.get('command', '')
+        # 配置后命令在常驻 CLI 会话中执行（如 "os_cli"），省去每次启动与登录
+        self.cli_session = config.get('cli_session')
+        self.timeout = config.get('timeout', 30)
         self._last_states = {}  # disk_id -> state
 
     def check(self, reporter=None) -> ObserverResult:
@@ -40,7 +44,7 @@ class DiskStateObserver(BaseObserver):
                 message="磁盘状态监控：未配置命令，请在 config.json 中设置 command",
             )
 
-        ret, stdout, stderr = run_command(self.command, shell=True, timeout=30)
+        ret, stdout, stderr = run_cli_command(self.command, self.cli_session, timeout=self.timeout)
         if ret != 0:
             return self.create_result(
                 has_alert=True,
@@ -5,10 +5,10 @@
 """
 
 import logging
-from pathlib import Path
 from typing import Any, Dict, Optional, Tuple
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.counters import FILE_NR, get_counter_reader
 
 logger = logging.getLogger(__name__)
 
@@ -85,22 +85,7 @@ class FileDescriptorsObserver(BaseObserver):
 
     def _get_fd_info(self) -> Optional[Tuple[int, int, int]]:
         """获取文件描述符信息"""
-        file_nr_path = Path('/proc/sys/fs/file-nr')
-
-        if not file_nr_path.exists():
+        values = FILE_NR.parse(get_counter_reader().read('/proc/sys/fs/file-nr'))
+        if values is None:
             return None
-
-        try:
-            content = file_nr_path.read_text().strip()
-            parts = content.split()
-
-            if len(parts) >= 3:
-                allocated = int(parts[0])
-                free = int(parts[1])
-                max_fds = int(parts[2])
-                return (allocated, free, max_fds)
-
-        except Exception as e:
-            logger.error(f"读取 /proc/sys/fs/file-nr 失败: {e}")
-
-        return None
+        return (values['allocated'], values['free'], values['max'])
@@ -3,17 +3,19 @@
 
 监测端口链路状态变化（link down/up）。
 支持白名单排除已知的维护操作。
+
+优先使用 netlink 事件（utils/netlink.py），周期内的每次闪断都会上报并带精确
+时间戳；netlink 不可用或配置 use_netlink: false 时回退到 sysfs 轮询。
 """
 
 import logging
 from datetime import datetime
 from pathlib import Path
-from typing import Any
-
 from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
 from ..utils.helpers import read_sysfs
+from ..utils.netlink import get_link_monitor
 
 logger = logging.getLogger(__name__)
 
@@ -34,12 +36,78 @@ class LinkStatusObserver(BaseObserver):
         self.protocols = config.get('protocols', ['iscsi', 'nvme', 'nas'])
         self.ports = config.get('ports', [])
         self._last_states = {}  # type: Dict[str, Dict[str, Any]]
+        self.use_netlink = config.get('use_netlink', True)
+        self._netlink_seq = None  # type: Optional[int]
         
         # 首次运行标记
         self._first_run = True
     
     def check(self) -> ObserverResult:
         """检查链路状态"""
+        monitor = get_link_monitor() if self.use_netlink else None
+        if monitor is not None:
+            return self._check_netlink(monitor)
+        return self._check_polling()
+
+    def _check_netlink(self, monitor) -> ObserverResult:
+        """按 netlink 事件逐条检测变化，不轮询 sysfs"""
+        alerts = []
+        details = {
+            'changes': [],
+            'current_states': {},
+            'source': 'netlink',
+        }
+
+        if self._netlink_seq is None:
+            # 首次：以当前快照为基线，之后只看增量事件
+            states, self._netlink_seq = monitor.checkpoint()
+            for port, state in states.items():
+                if self._wants_port(port, state):
+                    self._last_states[port] = state
+            events = []
+        else:
+            events, self._netlink_seq = monitor.events_since(self._netlink_seq)
+
+        for event in events:
+            port = event['port']
+            state = event['state']
+            if not self._wants_port(port, state):
+                continue
+            last_state = self._last_states.get(port)
+
+            if event['kind'] == 'removed':
+                if last_state and last_state.get('carrier') == '1' and port not in self.whitelist:
+                    change = f"{port} link DOWN (端口消失)"
+                    alerts.append(change)
+                    details['changes'].append({'port': port, 'change': change, 'timestamp': state['timestamp']})
+                    logger.warning(f"[LinkStatus] {port} DOWN (端口消失)")
+                self._last_states.pop(port, None)
+                continue
+
+            if last_state and port not in self.whitelist:
+                changes = self._detect_changes(port, last_state, state)
+                alerts.extend(changes)
+                details['changes'].extend(
+                    {'port': port, 'change': c, 'timestamp': state['timestamp']}
+                    for c in changes
+                )
+            self._last_states[port] = state
+
+        for port, state in monitor.snapshot().items():
+            if self._wants_port(port, state):
+                details['current_states'][port] = state
+
+        self._first_run = False
+        return self._build_result(alerts, details)
+
+    def _wants_port(self, port: str, state: Dict[str, Any]) -> bool:
+        """netlink 事件的端口过滤，与轮询模式的端口选择一致"""
+        if self.ports:
+            return port in self.ports
+        return not self._is_excluded(port) and not state.get('is_slave')
+
+    def _check_polling(self) -> ObserverResult:
+        """轮询 sysfs 检测状态变化（netlink 不可用时）"""
         alerts = []
         details = {
             'changes': [],
@@ -94,7 +162,9 @@ class LinkStatusObserver(BaseObserver):
             self._last_states[port] = state
         
         self._first_run = False
-        
+        return self._build_result(alerts, details)
+
+    def _build_result(self, alerts: List[str], details: Dict[str, Any]) -> ObserverResult:
         if alerts:
             message = f"检测到链路状态变化: {'; '.join(alerts[:3])}"
             if len(alerts) > 3:
@@ -125,11 +195,7 @@ class LinkStatusObserver(BaseObserver):
         if net_path.exists():
             for item in net_path.iterdir():
                 name = item.name
-                # 排除 lo 和虚拟接口
-                if name == 'lo' or name.startswith('veth') or name.startswith('docker'):
-                    continue
-                # 排除管理口和 eno 接口
-                if name.startswith('eth-m') or name.startswith('eno'):
+                if self._is_excluded(name):
                     continue
                 # 排除 bond slave（只监控 bond 本身）
                 if self._is_bond_slave(name):
@@ -137,6 +203,14 @@ class LinkStatusObserver(BaseObserver):
                 ports.append(name)
         
         return sorted(ports)
+
+    @staticmethod
+    def _is_excluded(name: str) -> bool:
+        # 排除 lo 和虚拟接口
+        if name == 'lo' or name.startswith('veth') or name.startswith('docker'):
+            return True
+        # 排除管理口和 eno 接口
+        return name.startswith('eth-m') or name.startswith('eno')
     
     def _is_bond_slave(self, port: str) -> bool:
         """检查端口是否是 bond 的 slave"""
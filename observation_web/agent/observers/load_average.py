@@ -1,15 +1,15 @@
 """
 系统负载监测观察点
 
-监测 1/5/15 分钟平均负载。
+监测 1/5/15 分钟平均负载（数据来自共享系统统计快照中的 /proc/loadavg）。
 """
 
 import logging
 import os
-from pathlib import Path
 from typing import Any, Dict
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.sysstats import get_system_stats
 
 logger = logging.getLogger(__name__)
 
@@ -95,20 +95,11 @@ class LoadAverageObserver(BaseObserver):
 
     def _get_load_average(self):
         """获取系统负载"""
-        loadavg_path = Path('/proc/loadavg')
-
-        if not loadavg_path.exists():
-            try:
-                return os.getloadavg()
-            except OSError:
-                return None
+        stats = get_system_stats()
+        if stats is not None and stats.loadavg is not None:
+            return stats.loadavg
 
         try:
-            content = loadavg_path.read_text().strip()
-            parts = content.split()
-            if len(parts) >= 3:
-                return float(parts[0]), float(parts[1]), float(parts[2])
-        except Exception as e:
-            logger.error(f"读取 /proc/loadavg 失败: {e}")
-
-        return None
+            return os.getloadavg()
+        except OSError:
+            return None
@@ -1,17 +1,22 @@
 """
 内存泄漏监测观察点
 
-通过 free -m 命令监测内存使用量，当连续 N 次采集都在增长时告警。
+从共享系统统计快照（/proc/meminfo）读取内存使用量，对滑动窗口内的样本做
+线性回归：增长斜率超过阈值且拟合优度足够高（持续、稳定地增长）时告警。
+单次回落不会清零判定，缓慢泄漏能更早发现；无规律波动因 R² 低不会误报。
+/proc/meminfo 不可用时回退到 free -m。
 """
 
 import logging
-import re
+import time
 from collections import deque
 from datetime import datetime
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Any, Dict, Optional, Tuple
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
 from ..utils.helpers import run_command
+from ..utils.sysstats import get_system_stats
+from ..utils.trend import TrendFit, TrendWindow
 
 logger = logging.getLogger(__name__)
 
@@ -21,39 +26,46 @@ class MemoryLeakObserver(BaseObserver):
     内存泄漏监测观察点
     
     功能：
-    - 定期执行 free -m 获取内存使用量
-    - 连续 N 次（默认8次，即12小时）增长则告警
-    - 连续 M 次（默认3次）下降则自动恢复
+    - 定期采集已用内存，保留最近 window_size 个样本（默认8个，间隔1.5h 即12小时）
+    - 样本数达到 min_samples 后做线性回归，斜率 >= growth_threshold_mb_per_hour
+      且 R² >= r2_threshold 则告警
+    - 告警后连续 recovery_threshold 次（默认3次）不再呈增长趋势则自动恢复
     """
     
     def __init__(self, name: str, config: Dict[str, Any]):
         super().__init__(name, config)
         
-        # 连续增长阈值（默认8次 = 12小时，间隔1.5h）
-        self.consecutive_threshold = config.get('consecutive_threshold', 8)
+        # 滑动窗口样本数（兼容旧配置 consecutive_threshold）
+        self.window_size = config.get('window_size', config.get('consecutive_threshold', 8))
         
-        # 连续下降恢复阈值（默认3次）
+        # 开始判定所需最少样本数（默认窗口过半）
+        self.min_samples = config.get('min_samples', max(3, self.window_size // 2 + 1))
+        
+        # 增长斜率阈值（MB/小时）与拟合优度阈值
+        self.growth_threshold_mb_per_hour = config.get('growth_threshold_mb_per_hour', 5.0)
+        self.r2_threshold = config.get('r2_threshold', 0.8)
+        
+        # 连续无增长趋势恢复阈值（默认3次）
         self.recovery_threshold = config.get('recovery_threshold', 3)
         
-        # 历史数据（保留足够长度用于恢复判断）
-        max_len = max(self.consecutive_threshold, self.recovery_threshold + 1)
-        self._history = deque(maxlen=max_len)  # type: deque
+        self._window = TrendWindow(self.window_size)
+        self._history = deque(maxlen=self.window_size)  # type: deque
         
-        # 是否已触发告警（sticky状态）
+        # 是否已触发告警（sticky状态）及告警后连续无增长趋势次数
         self._alert_triggered = False
+        self._no_trend_count = 0
     
     def check(self, reporter=None) -> ObserverResult:
         """检查内存使用情况"""
-        # 获取当前内存使用量
-        used_mb = self._get_memory_used()
-        total_mb = self._get_memory_total()
+        memory = self._get_memory()
         
-        if used_mb is None:
+        if memory is None:
             return self.create_result(
                 has_alert=False,
                 message="无法获取内存信息",
-                details={'error': '执行 free -m 失败'},
+                details={'error': '读取 /proc/meminfo 与执行 free -m 均失败'},
             )
+        used_mb, total_mb = memory
         
         # 记录指标数据（每次都记录，无论是否告警）
         if reporter and hasattr(reporter, 'record_metrics'):
@@ -63,31 +75,32 @@ class MemoryLeakObserver(BaseObserver):
                 'observer': self.name,
             })
         
-        # 记录当前值
-        timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S')
+        self._window.add(time.time(), used_mb)
         self._history.append({
-            'timestamp': timestamp,
+            'timestamp': datetime.now().strftime('%Y-%m-%d %H:%M:%S'),
             'used_mb': used_mb,
         })
         
-        # 构建详情
-        consecutive_increases = self._count_consecutive_increases()
-        consecutive_decreases = self._count_consecutive_decreases()
+        fit = self._window.fit() if len(self._window) >= self.min_samples else None
+        leaking = self._is_leak_trend(fit)
+        
         details = {
             'current_used_mb': used_mb,
             'history': list(self._history),
-            'consecutive_threshold': self.consecutive_threshold,
+            'window_size': self.window_size,
+            'min_samples': self.min_samples,
+            'growth_threshold_mb_per_hour': self.growth_threshold_mb_per_hour,
+            'r2_threshold': self.r2_threshold,
             'recovery_threshold': self.recovery_threshold,
-            'consecutive_increases': consecutive_increases,
-            'consecutive_decreases': consecutive_decreases,
+            'trend': fit.to_dict() if fit else None,
         }
         
-        # 检查是否连续增长 -> 触发告警
-        if self._is_continuous_increase():
+        if leaking:
+            self._no_trend_count = 0
             self._alert_triggered = True
             message = (
-                f"内存疑似泄漏: 连续 {self.consecutive_threshold} 次采集内存持续增长 "
-                f"(当前: {used_mb}MB)"
+                f"内存疑似泄漏: 近 {fit.span / 3600:.1f} 小时内存持续增长 "
+                f"{fit.slope * 3600:.1f}MB/h (R²={fit.r2:.2f}, 当前: {used_mb}MB)"
             )
             logger.error(message)
             
@@ -99,32 +112,34 @@ class MemoryLeakObserver(BaseObserver):
                 sticky=True,
             )
         
-        # 检查是否连续下降 -> 恢复
-        if self._alert_triggered and self._is_continuous_decrease():
-            self._alert_triggered = False
-            details['recovered'] = True
-            message = (
-                f"内存泄漏已恢复: 连续 {self.recovery_threshold} 次采集内存下降 "
-                f"(当前: {used_mb}MB)"
-            )
-            logger.info(message)
-            
-            return self.create_result(
-                has_alert=True,
-                alert_level=AlertLevel.INFO,
-                message=message,
-                details=details,
-                sticky=False,
-            )
-        
-        # 如果之前触发过告警且未恢复，持续报告
         if self._alert_triggered:
-            message = f"内存泄漏告警持续中 (当前: {used_mb}MB)"
+            self._no_trend_count += 1
+            details['no_trend_count'] = self._no_trend_count
+            
+            # 连续多次不再呈增长趋势 -> 恢复
+            if self._no_trend_count >= self.recovery_threshold:
+                self._alert_triggered = False
+                self._no_trend_count = 0
+                details['recovered'] = True
+                message = (
+                    f"内存泄漏已恢复: 连续 {self.recovery_threshold} 次采集未见增长趋势 "
+                    f"(当前: {used_mb}MB)"
+                )
+                logger.info(message)
+                
+                return self.create_result(
+                    has_alert=True,
+                    alert_level=AlertLevel.INFO,
+                    message=message,
+                    details=details,
+                    sticky=False,
+                )
             
+            # 之前触发过告警且未恢复，持续报告
             return self.create_result(
                 has_alert=True,
                 alert_level=AlertLevel.ERROR,
-                message=message,
+                message=f"内存泄漏告警持续中 (当前: {used_mb}MB)",
                 details=details,
                 sticky=True,
             )
@@ -135,8 +150,22 @@ class MemoryLeakObserver(BaseObserver):
             details=details,
         )
     
-    def _get_memory_used(self) -> Optional[int]:
-        """执行 free -m 获取已用内存（MB）"""
+    def _is_leak_trend(self, fit: Optional[TrendFit]) -> bool:
+        """斜率超过阈值且拟合足够线性才视为泄漏"""
+        if fit is None:
+            return False
+        return fit.slope * 3600 >= self.growth_threshold_mb_per_hour and fit.r2 >= self.r2_threshold
+    
+    def _get_memory(self) -> Optional[Tuple[int, Optional[int]]]:
+        """获取 (已用内存, 总内存)（MB），优先共享快照"""
+        stats = get_system_stats()
+        if stats is not None and stats.mem_used_kb is not None:
+            total_kb = stats.mem_total_kb
+            return stats.mem_used_kb // 1024, (total_kb // 1024 if total_kb is not None else None)
+        return self._get_memory_from_free()
+    
+    def _get_memory_from_free(self) -> Optional[Tuple[int, Optional[int]]]:
+        """执行 free -m 获取已用/总内存（MB，备用方案）"""
         ret, stdout, stderr = run_command('free -m', shell=True, timeout=5)
         
         if ret != 0:
@@ -148,86 +177,8 @@ class MemoryLeakObserver(BaseObserver):
                 parts = line.split()
                 if len(parts) >= 3:
                     try:
-                        return int(parts[2])  # used 列
+                        return int(parts[2]), int(parts[1])  # used 列, total 列
                     except ValueError:
                         pass
         
         return None
-    
-    def _get_memory_total(self) -> Optional[int]:
-        """获取总内存（MB）"""
-        ret, stdout, stderr = run_command('free -m', shell=True, timeout=5)
-        
-        if ret != 0:
-            return None
-        
-        for line in stdout.split('\n'):
-            if line.startswith('Mem:'):
-                parts = line.split()
-                if len(parts) >= 2:
-                    try:
-                        return int(parts[1])  # total 列
-                    except ValueError:
-                        pass
-        
-        return None
-    
-    def _is_continuous_increase(self) -> bool:
-        """检查是否连续增长"""
-        if len(self._history) < self.consecutive_threshold:
-            return False
-        
-        # 检查每次采集是否都比前一次大
-        values = [h['used_mb'] for h in self._history]
-        
-        for i in range(1, len(values)):
-            if values[i] <= values[i - 1]:
-                return False
-        
-        return True
-    
-    def _count_consecutive_increases(self) -> int:
-        """计算当前连续增长次数"""
-        if len(self._history) < 2:
-            return 0
-        
-        values = [h['used_mb'] for h in self._history]
-        count = 0
-        
-        for i in range(len(values) - 1, 0, -1):
-            if values[i] > values[i - 1]:
-                count += 1
-            else:
-                break
-        
-        return count
-    
-    def _is_continuous_decrease(self) -> bool:
-        """检查是否连续下降（用于恢复判断）"""
-        if len(self._history) < self.recovery_threshold:
-            return False
-        
-        # 只检查最近 recovery_threshold 次采集
-        values = [h['used_mb'] for h in self._history][-self.recovery_threshold:]
-        
-        for i in range(1, len(values)):
-            if values[i] >= values[i - 1]:
-                return False
-        
-        return True
-    
-    def _count_consecutive_decreases(self) -> int:
-        """计算当前连续下降次数"""
-        if len(self._history) < 2:
-            return 0
-        
-        values = [h['used_mb'] for h in self._history]
-        count = 0
-        
-        for i in range(len(values) - 1, 0, -1):
-            if values[i] < values[i - 1]:
-                count += 1
-            else:
-                break
-        
-        return count
@@ -18,6 +18,7 @@ from pathlib import Path
 from typing import Any, Dict, List, Optional, Tuple
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.counters import get_counter_reader, parse_int
 from ..utils.helpers import run_command, read_sysfs, safe_int
 
 logger = logging.getLogger(__name__)
@@ -313,12 +314,12 @@ class PortCountersObserver(BaseObserver):
 
     def _read_sysfs_counters(self, port: str) -> Dict[str, int]:
         counters: Dict[str, int] = {}
-        stats_path = Path(f'/sys/class/net/{port}/statistics')
-        if stats_path.exists():
-            for name in _SYSFS_COUNTERS:
-                val = read_sysfs(stats_path / name)
-                if val is not None:
-                    counters[name] = safe_int(val)
+        stats_path = f'/sys/class/net/{port}/statistics'
+        values = get_counter_reader().read_many(f'{stats_path}/{name}' for name in _SYSFS_COUNTERS)
+        for name in _SYSFS_COUNTERS:
+            val = parse_int(values.get(f'{stats_path}/{name}'))
+            if val is not None:
+                counters[name] = val
 
         if not counters:
             counters = self._read_ethtool_counters(port)
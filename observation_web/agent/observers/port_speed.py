@@ -6,16 +6,19 @@
 
 内置通用方式：通过 /sys/class/net/<port>/speed 读取，
 或回退到 ethtool <port> 解析 Speed 字段。
-如果配置了 command 则优先使用自定义命令。
+netlink 可用时，速率随链路事件更新（utils/netlink.py），周期内的每次变化都会
+上报，不再逐端口轮询。如果配置了 command 则优先使用自定义命令。
 """
 
 import logging
 import re
 from pathlib import Path
-from typing import Any, Dict, List
+from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command, read_sysfs
+from ..utils.counters import get_counter_reader, parse_text
+from ..utils.helpers import run_command
+from ..utils.netlink import get_link_monitor
 
 logger = logging.getLogger(__name__)
 
@@ -32,6 +35,7 @@ class PortSpeedObserver(BaseObserver):
     - command: 自定义命令（可选，留空则使用内置 sysfs/ethtool）
     - ports: 要监测的端口列表（可选，为空则自动发现）
     - parse_pattern: 自定义命令的解析正则（需含 port 和 speed 命名组）
+    - use_netlink: 内置模式下是否使用 netlink 事件（默认 true）
     """
 
     # ethtool 输出中提取 Speed
@@ -46,14 +50,22 @@ class PortSpeedObserver(BaseObserver):
         self.parse_pattern = re.compile(
             config.get('parse_pattern', self.DEFAULT_PATTERN)
         )
+        self.use_netlink = config.get('use_netlink', True)
         self._last_speed = {}  # type: Dict[str, str]
+        self._netlink_seq = None  # type: Optional[int]
         self._first_run = True
 
     def check(self) -> ObserverResult:
+        changes = []
+        monitor = None
         if self.command:
             current_speed = self._collect_via_command()
         else:
-            current_speed = self._collect_via_sysfs()
+            monitor = get_link_monitor() if self.use_netlink else None
+            if monitor is not None:
+                current_speed = self._collect_via_netlink(monitor, changes)
+            else:
+                current_speed = self._collect_via_sysfs()
 
         if not current_speed:
             return self.create_result(
@@ -61,8 +73,7 @@ class PortSpeedObserver(BaseObserver):
                 message="端口速率查询无数据（可能无网络端口）",
             )
 
-        changes = []
-        if not self._first_run:
+        if not self._first_run and monitor is None:
             for port, speed in current_speed.items():
                 old_speed = self._last_speed.get(port)
                 if old_speed is not None and old_speed != speed:
@@ -73,7 +84,9 @@ class PortSpeedObserver(BaseObserver):
                     })
                     logger.warning(f"[PortSpeed] {port} 速率变化: {old_speed} -> {speed}")
 
-        self._last_speed = current_speed
+        if monitor is None:
+            # netlink 模式下 _last_speed 由事件维护（端口 down 期间保留 down 前速率）
+            self._last_speed = current_speed
         self._first_run = False
 
         if changes:
@@ -98,22 +111,86 @@ class PortSpeedObserver(BaseObserver):
         result = {}
         ports = self._discover_ports()
 
+        reader = get_counter_reader()
         for port in ports:
-            # 优先 sysfs
-            speed = read_sysfs(Path(f'/sys/class/net/{port}/speed'))
+            # 优先 sysfs（文件描述符常驻，按周期 pread）
+            speed = parse_text(reader.read(f'/sys/class/net/{port}/speed'))
             if speed and speed != '-1':
                 result[port] = f"{speed}Mb/s"
                 continue
 
             # 回退到 ethtool
-            ret, stdout, _ = run_command(['ethtool', port], timeout=5)
-            if ret == 0:
-                m = self.SPEED_PATTERN.search(stdout)
-                if m:
-                    result[port] = m.group(1)
+            speed = self._ethtool_speed(port)
+            if speed is not None:
+                result[port] = speed
+
+        return result
+
+    # ---------- netlink 事件模式 ----------
+
+    def _collect_via_netlink(self, monitor, changes: List[Dict[str, str]]) -> Dict[str, str]:
+        """按链路事件顺序检测速率变化（含周期内的多次变化），返回当前速率"""
+        if self._netlink_seq is None:
+            _, self._netlink_seq = monitor.checkpoint()
+            events = []
+        else:
+            events, self._netlink_seq = monitor.events_since(self._netlink_seq)
+
+        for event in events:
+            port = event['port']
+            speed = self._format_speed(event['state'].get('speed'))
+            if speed is None or not self._wants_port(port):
+                continue
+            old_speed = self._last_speed.get(port)
+            if old_speed is not None and old_speed != speed:
+                changes.append({
+                    'port': port,
+                    'old_speed': old_speed,
+                    'new_speed': speed,
+                    'timestamp': event['state']['timestamp'],
+                })
+                logger.warning(f"[PortSpeed] {port} 速率变化: {old_speed} -> {speed}")
+            self._last_speed[port] = speed
 
+        result = {}
+        for port, state in monitor.snapshot().items():
+            if not self._wants_port(port):
+                continue
+            speed = self._format_speed(state.get('speed'))
+            if speed is None and state.get('carrier') == '1':
+                # 驱动未在 sysfs 提供速率：仅对这些端口回退到 ethtool
+                speed = self._ethtool_speed(port)
+            if speed is not None:
+                result[port] = speed
+                self._last_speed.setdefault(port, speed)
         return result
 
+    def _ethtool_speed(self, port: str) -> Optional[str]:
+        ret, stdout, _ = run_command(['ethtool', port], timeout=5)
+        if ret == 0:
+            m = self.SPEED_PATTERN.search(stdout)
+            if m:
+                return m.group(1)
+        return None
+
+    @staticmethod
+    def _format_speed(speed: Optional[str]) -> Optional[str]:
+        # 端口 down 时 speed 为 -1 或不可读，不视为速率变化
+        if not speed or speed == '-1':
+            return None
+        return f"{speed}Mb/s"
+
+    def _wants_port(self, port: str) -> bool:
+        if self.ports_filter:
+            return port in self.ports_filter
+        return not self._is_excluded(port)
+
+    @staticmethod
+    def _is_excluded(name: str) -> bool:
+        if name == 'lo' or name.startswith(('veth', 'docker', 'virbr', 'br-')):
+            return True
+        return name.startswith('eth-m') or name.startswith('eno')
+
     def _discover_ports(self) -> List[str]:
         """发现要监测的网络端口"""
         if self.ports_filter:
@@ -124,9 +201,7 @@ class PortSpeedObserver(BaseObserver):
         if net_path.exists():
             for item in net_path.iterdir():
                 name = item.name
-                if name == 'lo' or name.startswith(('veth', 'docker', 'virbr', 'br-')):
-                    continue
-                if name.startswith('eth-m') or name.startswith('eno'):
+                if self._is_excluded(name):
                     continue
                 ports.append(name)
         return sorted(ports)
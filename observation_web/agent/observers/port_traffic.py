@@ -0,0 +1,253 @@
+"""
+端口流量观察点
+
+归属：端口级检查
+后台线程以亚秒级间隔（默认 200ms）采样各端口 sysfs 字节/报文计数器，
+在本地计算速率、峰值和分位数，每个观察周期输出一条紧凑的窗口汇总到
+traffic.jsonl，后端直接同步汇总记录，无需自行根据计数器差值还原速率。
+
+记录格式兼容原 traffic.jsonl（ts/port/tx_bytes/rx_bytes/tx_rate_bps/rx_rate_bps/
+mode/protocol），并附加 *_peak_bps、*_p50/p95/p99_bps、*_pps 等窗口统计。
+"""
+
+import json
+import logging
+import threading
+import time
+from datetime import datetime, timedelta
+from pathlib import Path
+from typing import Any, Dict, List, Optional
+
+from ..core.base import BaseObserver, ObserverResult
+from ..utils.counters import get_counter_reader, parse_int
+
+logger = logging.getLogger(__name__)
+
+NET_ROOT = '/sys/class/net'
+
+COUNTERS = ('rx_bytes', 'tx_bytes', 'rx_packets', 'tx_packets')
+
+# 单窗口单端口最多保留的速率样本数（30s / 0.2s = 150，留足余量）
+MAX_WINDOW_SAMPLES = 4096
+
+# traffic.jsonl 按保留时长裁剪的最小间隔（秒）
+TRIM_INTERVAL = 600
+
+
+def percentile(sorted_values, pct):
+    # type: (List[float], float) -> float
+    """最近秩分位数，sorted_values 需已排序"""
+    if not sorted_values:
+        return 0.0
+    rank = int(round(pct / 100.0 * (len(sorted_values) - 1)))
+    return sorted_values[max(0, min(rank, len(sorted_values) - 1))]
+
+
+class _PortWindow(object):
+    """单端口一个汇总窗口内的采样累积"""
+
+    __slots__ = ('first', 'last', 'first_ts', 'last_ts', 'rates')
+
+    def __init__(self):
+        self.first = None  # type: Optional[Dict[str, int]]
+        self.last = None  # type: Optional[Dict[str, int]]
+        self.first_ts = 0.0
+        self.last_ts = 0.0
+        self.rates = {'tx_bps': [], 'rx_bps': [], 'tx_pps': [], 'rx_pps': []}  # type: Dict[str, List[float]]
+
+
+class PortTrafficObserver(BaseObserver):
+    """
+    端口流量速率观察点
+
+    配置项：
+    - interval: 汇总窗口/上报周期（秒）
+    - sample_interval: 计数器采样间隔（秒，默认 0.2）
+    - ports: 要采样的端口列表（为空则自动发现）
+    - output_path: 汇总输出文件（traffic.jsonl）
+    - retention_hours: 输出文件保留时长
+    """
+
+    def __init__(self, name: str, config: Dict[str, Any]):
+        super().__init__(name, config)
+        self.sample_interval = max(0.05, float(config.get('sample_interval', 0.2)))
+        self.ports = list(config.get('ports', []))
+        self.output_path = Path(config.get('output_path', '/var/log/observation-points/traffic.jsonl'))
+        self.retention_hours = config.get('retention_hours', 2)
+        self.net_root = Path(config.get('net_root', NET_ROOT))
+
+        self._lock = threading.Lock()
+        self._windows = {}  # type: Dict[str, _PortWindow]
+        self._prev = {}  # type: Dict[str, tuple]
+        self._stop = threading.Event()
+        self._thread = None  # type: Optional[threading.Thread]
+        self._last_trim = 0.0
+
+    # ---------- 采样 ----------
+
+    def _discover_ports(self) -> List[str]:
+        if self.ports:
+            return self.ports
+        ports = []
+        if self.net_root.exists():
+            for item in self.net_root.iterdir():
+                name = item.name
+                if name == 'lo' or name.startswith(('veth', 'docker', 'virbr', 'br-')):
+                    continue
+                if name.startswith('eth-m') or name.startswith('eno'):
+                    continue
+                ports.append(name)
+        return sorted(ports)
+
+    def _read_counters(self, port: str) -> Optional[Dict[str, int]]:
+        # 采样频率高：计数器文件描述符常驻，每次 pread 而非 open/read/close
+        reader = get_counter_reader()
+        stats = self.net_root / port / 'statistics'
+        values = {}
+        for counter in COUNTERS:
+            value = parse_int(reader.read(str(stats / counter)))
+            if value is None:
+                return None
+            values[counter] = value
+        return values
+
+    def sample(self, now: Optional[float] = None):
+        """采样一次所有端口计数器（采样线程调用，测试可直接调用）"""
+        now = time.monotonic() if now is None else now
+        for port in self._discover_ports():
+            counters = self._read_counters(port)
+            if counters is None:
+                continue
+            with self._lock:
+                window = self._windows.get(port)
+                if window is None:
+                    window = self._windows[port] = _PortWindow()
+                prev = self._prev.get(port)
+                if prev is not None:
+                    prev_ts, prev_counters = prev
+                    dt = now - prev_ts
+                    if dt > 0:
+                        d = {k: counters[k] - prev_counters[k] for k in COUNTERS}
+                        # 计数器回绕/重置（如驱动重载）：丢弃该区间
+                        if all(v >= 0 for v in d.values()):
+                            rates = window.rates
+                            if len(rates['tx_bps']) < MAX_WINDOW_SAMPLES:
+                                rates['tx_bps'].append(d['tx_bytes'] * 8 / dt)
+                                rates['rx_bps'].append(d['rx_bytes'] * 8 / dt)
+                                rates['tx_pps'].append(d['tx_packets'] / dt)
+                                rates['rx_pps'].append(d['rx_packets'] / dt)
+                if window.first is None:
+                    # 新窗口从上一个采样点起算，相邻窗口首尾相接
+                    if prev is not None:
+                        window.first_ts, window.first = prev
+                    else:
+                        window.first_ts, window.first = now, counters
+                window.last, window.last_ts = counters, now
+                self._prev[port] = (now, counters)
+
+    def _run(self):
+        while not self._stop.is_set():
+            started = time.monotonic()
+            try:
+                self.sample(started)
+            except Exception as e:
+                logger.debug(f"[PortTraffic] 采样失败: {e}")
+            self._stop.wait(max(0.0, self.sample_interval - (time.monotonic() - started)))
+
+    def _ensure_sampler(self):
+        if self._thread is None or not self._thread.is_alive():
+            self._stop.clear()
+            self._thread = threading.Thread(target=self._run, name='port-traffic-sampler', daemon=True)
+            self._thread.start()
+
+    def cleanup(self):
+        self._stop.set()
+        if self._thread is not None:
+            self._thread.join(timeout=2)
+            self._thread = None
+
+    # ---------- 窗口汇总 ----------
+
+    def summarize(self) -> List[Dict[str, Any]]:
+        """结束当前窗口，返回各端口汇总并开始新窗口"""
+        with self._lock:
+            windows, self._windows = self._windows, {}
+
+        ts = datetime.now().isoformat()
+        summaries = []
+        for port in sorted(windows):
+            window = windows[port]
+            if window.last is None:
+                continue
+            span = window.last_ts - window.first_ts
+            record = {
+                'ts': ts,
+                'port': port,
+                'tx_bytes': window.last['tx_bytes'],
+                'rx_bytes': window.last['rx_bytes'],
+                'mode': 'sysfs',
+                'protocol': 'ethernet',
+                'window_s': round(span, 3),
+                'samples': len(window.rates['tx_bps']),
+            }
+            for direction in ('tx', 'rx'):
+                delta_bytes = window.last[f'{direction}_bytes'] - window.first[f'{direction}_bytes']
+                delta_pkts = window.last[f'{direction}_packets'] - window.first[f'{direction}_packets']
+                # 平均速率取窗口首尾计数器差，不受采样丢失影响
+                record[f'{direction}_rate_bps'] = round(delta_bytes * 8 / span, 1) if span > 0 and delta_bytes >= 0 else 0.0
+                record[f'{direction}_pps'] = round(delta_pkts / span, 1) if span > 0 and delta_pkts >= 0 else 0.0
+                bps = sorted(window.rates[f'{direction}_bps'])
+                pps = window.rates[f'{direction}_pps']
+                record[f'{direction}_peak_bps'] = round(bps[-1], 1) if bps else 0.0
+                record[f'{direction}_p50_bps'] = round(percentile(bps, 50), 1)
+                record[f'{direction}_p95_bps'] = round(percentile(bps, 95), 1)
+                record[f'{direction}_p99_bps'] = round(percentile(bps, 99), 1)
+                record[f'{direction}_peak_pps'] = round(max(pps), 1) if pps else 0.0
+            summaries.append(record)
+        return summaries
+
+    def _write(self, summaries: List[Dict[str, Any]]):
+        try:
+            self.output_path.parent.mkdir(parents=True, exist_ok=True)
+            with open(self.output_path, 'a', encoding='utf-8') as f:
+                for record in summaries:
+                    f.write(json.dumps(record, ensure_ascii=False) + '\n')
+            if time.time() - self._last_trim >= TRIM_INTERVAL:
+                self._last_trim = time.time()
+                self._trim()
+        except (IOError, OSError) as e:
+            logger.warning(f"[PortTraffic] 写入 {self.output_path} 失败: {e}")
+
+    def _trim(self):
+        """删除超出保留时长的汇总记录"""
+        cutoff = (datetime.now() - timedelta(hours=self.retention_hours)).isoformat()
+        with open(self.output_path, 'r', encoding='utf-8') as f:
+            lines = f.readlines()
+        kept = []
+        for line in lines:
+            try:
+                if json.loads(line).get('ts', '') >= cutoff:
+                    kept.append(line)
+            except ValueError:
+                continue
+        if len(kept) != len(lines):
+            tmp = self.output_path.with_suffix('.tmp')
+            with open(tmp, 'w', encoding='utf-8') as f:
+                f.writelines(kept)
+            tmp.replace(self.output_path)
+
+    def check(self) -> ObserverResult:
+        self._ensure_sampler()
+        summaries = self.summarize()
+        if summaries:
+            self._write(summaries)
+
+        busiest = sorted(summaries, key=lambda r: r['tx_peak_bps'] + r['rx_peak_bps'], reverse=True)[:10]
+        return self.create_result(
+            has_alert=False,
+            message=f"端口流量采样正常 ({len(summaries)} 端口)",
+            details={
+                'sample_interval': self.sample_interval,
+                'ports': busiest,
+            },
+        )
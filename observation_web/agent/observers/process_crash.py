@@ -6,12 +6,14 @@
 """
 
 import logging
+import os
 import re
 from datetime import datetime
 from pathlib import Path
-from typing import Any, Dict, List
+from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..core.checkpoint import log_cursor, restore_log_cursor
 from ..utils.helpers import run_command
 
 logger = logging.getLogger(__name__)
@@ -42,6 +44,22 @@ class ProcessCrashObserver(BaseObserver):
         super().__init__(name, config)
         self.log_paths = config.get('log_paths', ['/var/log/messages', '/var/log/syslog'])
         self._last_positions = {}  # path -> byte offset
+        self._last_inodes = {}  # type: Dict[str, int]
+
+    def get_state(self) -> Optional[Dict[str, Any]]:
+        return {
+            'cursors': {
+                path: log_cursor(position, self._last_inodes.get(path))
+                for path, position in self._last_positions.items()
+            },
+        }
+
+    def restore_state(self, state: Dict[str, Any]):
+        # 从上次偏移续读，重启后不再从头重扫整个日志
+        for path, cursor in (state.get('cursors') or {}).items():
+            restored = restore_log_cursor(path, cursor)
+            if restored is not None:
+                self._last_positions[path], self._last_inodes[path] = restored
 
     def check(self, reporter=None) -> ObserverResult:
         all_crashes = []
@@ -92,6 +110,8 @@ class ProcessCrashObserver(BaseObserver):
                 f.seek(last_pos)
                 new_lines = f.readlines()
                 self._last_positions[log_path] = f.tell()
+                # 与偏移一起记录所读文件的 inode，检查点据此识别轮转
+                self._last_inodes[log_path] = os.fstat(f.fileno()).st_ino
 
             for line in new_lines[-500:]:  # Only check last 500 new lines
                 for pattern, crash_type in CRASH_PATTERNS:
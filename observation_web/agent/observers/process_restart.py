@@ -10,11 +10,12 @@ import re
 from typing import Any, Dict, List, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command, safe_int
+from ..utils.helpers import safe_int
+from ..utils.proctable import get_process_table
 
 logger = logging.getLogger(__name__)
 
-# ps -aux | grep 输出中提取 -v N 参数
+# 从进程命令行中提取 -v N 参数
 V_PARAM_PATTERN = re.compile(r'-v\s+(\d+)', re.IGNORECASE)
 
 
@@ -24,8 +25,8 @@ class ProcessRestartObserver(BaseObserver):
 
     工作流程：
     1. 默认监控 app_data, devm, memf（可配置）
-    2. 每周期执行 ps -aux | grep -aiE {进程名}
-    3. 解析回显中的 -v N 参数
+    2. 每周期在共享进程表快照中按进程名正则匹配（等同 ps -aux | grep -aiE）
+    3. 解析命令行中的 -v N 参数
     4. 若 -v 值增大（如 1 -> 2），说明进程被重拉，上报告警
     """
 
@@ -67,19 +68,15 @@ class ProcessRestartObserver(BaseObserver):
         )
 
     def _get_v_param(self, proc_name: str) -> Optional[int]:
-        """从 ps 输出中解析 -v N"""
-        cmd = f"ps -aux | grep -aiE '{proc_name}'"
-        ret, stdout, _ = run_command(cmd, shell=True, timeout=5)
-        if ret != 0 and not stdout.strip():
+        """从匹配进程的命令行中解析 -v N"""
+        table = get_process_table()
+        if table is None:
             return None
 
         # 取最大的 -v 值（可能有多个进程实例）
         max_v = None
-        for line in stdout.strip().split('\n'):
-            line = line.strip()
-            if not line or 'grep' in line:
-                continue
-            m = V_PARAM_PATTERN.search(line)
+        for proc in table.search(proc_name):
+            m = V_PARAM_PATTERN.search(proc.cmdline)
             if m:
                 v = safe_int(m.group(1), 0)
                 if max_v is None or v > max_v:
@@ -0,0 +1,62 @@
+"""
+观察点注册表
+
+配置中的观察点名 → (模块, 类名)。调度器按配置只导入已启用观察点所在的模块，
+未启用的观察点不会被导入或实例化，启动耗时与常驻内存随启用数量而非安装数量增长。
+
+兼容旧名（error_code / port_error_code）直接指向合并后的模块，
+不经过 error_code.py 等仅做别名的废弃模块。
+"""
+
+import importlib
+from typing import Dict, List, Optional, Tuple
+
+OBSERVER_REGISTRY = {
+    'error_code': ('port_counters', 'PortCountersObserver'),
+    'port_error_code': ('port_counters', 'PortCountersObserver'),
+    'link_status': ('link_status', 'LinkStatusObserver'),
+    'card_recovery': ('card_recovery', 'CardRecoveryObserver'),
+    'sensitive_info': ('sensitive_info', 'SensitiveInfoObserver'),
+    'custom_commands': ('custom_command', 'CustomCommandObserver'),
+    'alarm_type': ('alarm_type', 'AlarmTypeObserver'),
+    'memory_leak': ('memory_leak', 'MemoryLeakObserver'),
+    'cpu_usage': ('cpu_usage', 'CpuUsageObserver'),
+    'cmd_response': ('cmd_response', 'CmdResponseObserver'),
+    'sig_monitor': ('sig_monitor', 'SigMonitorObserver'),
+    'port_fec': ('port_fec', 'PortFecObserver'),
+    'port_speed': ('port_speed', 'PortSpeedObserver'),
+    'port_traffic': ('port_traffic', 'PortTrafficObserver'),
+    'pcie_bandwidth': ('pcie_bandwidth', 'PcieBandwidthObserver'),
+    'card_info': ('card_info', 'CardInfoObserver'),
+    'controller_state': ('controller_state', 'ControllerStateObserver'),
+    'disk_state': ('disk_state', 'DiskStateObserver'),
+    'process_crash': ('process_crash', 'ProcessCrashObserver'),
+    'io_timeout': ('io_timeout', 'IoTimeoutObserver'),
+    'process_restart': ('process_restart', 'ProcessRestartObserver'),
+    'sfp_monitor': ('sfp_monitor', 'SfpMonitorObserver'),
+    'abnormal_reset': ('abnormal_reset', 'AbnormalResetObserver'),
+    'start_work': ('gate.start_work', 'StartWorkObserver'),
+    'custom_monitor': ('custom_monitor', 'CustomMonitorObserver'),
+}  # type: Dict[str, Tuple[str, str]]
+
+
+def available_observers():
+    # type: () -> List[str]
+    """已安装（可配置）的观察点名"""
+    return sorted(OBSERVER_REGISTRY)
+
+
+def load_observer_class(name):
+    # type: (str) -> Optional[type]
+    """
+    按需导入观察点类
+
+    Returns:
+        观察点类；未注册的名称返回 None，模块导入失败时抛出原异常
+    """
+    entry = OBSERVER_REGISTRY.get(name)
+    if entry is None:
+        return None
+    module_name, class_name = entry
+    module = importlib.import_module('.' + module_name, __package__)
+    return getattr(module, class_name)
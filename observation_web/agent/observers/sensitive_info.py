@@ -119,29 +119,13 @@ class SensitiveInfoObserver(BaseObserver):
         ])
         
         # 用户自定义模式
-        user_patterns = config.get('patterns', [])
+        self._user_patterns = config.get('patterns', [])
         
-        # 编译所有模式
-        self._patterns = {}  # type: Dict[str, List[Any]]
-        for category, patterns in self.DEFAULT_PATTERNS.items():
-            self._patterns[category] = [re.compile(p, re.IGNORECASE) for p in patterns]
-        
-        # 添加用户自定义模式
-        if user_patterns:
-            self._patterns['custom'] = [re.compile(p, re.IGNORECASE) for p in user_patterns]
-        
-        # 编译安全模式
-        self._safe_patterns = [re.compile(p, re.IGNORECASE) for p in self.SAFE_PATTERNS]
-        
-        # 编译上下文排除模式
-        self._exclude_patterns = [
-            re.compile(p, re.IGNORECASE) for p in self.EXCLUDE_CONTEXT_PATTERNS
-        ]
-        
-        # 编译白名单模式
-        self._whitelist_patterns = [
-            re.compile(p, re.IGNORECASE) for p in self.whitelist_patterns
-        ]
+        # 正则集合较大，首次扫描时再编译（未产生新日志行时不付出编译开销）
+        self._patterns = None  # type: Optional[Dict[str, List[Any]]]
+        self._safe_patterns = []  # type: List[Any]
+        self._exclude_patterns = []  # type: List[Any]
+        self._whitelist_patterns = []  # type: List[Any]
         
         # 文件位置缓存
         self._file_positions = {}  # type: Dict[str, int]
@@ -225,8 +209,30 @@ class SensitiveInfoObserver(BaseObserver):
             details={'files_checked': details['files_checked']},
         )
     
+    def _compile_patterns(self):
+        """编译所有模式（首次使用时调用一次）"""
+        patterns_by_category = {}  # type: Dict[str, List[Any]]
+        for category, patterns in self.DEFAULT_PATTERNS.items():
+            patterns_by_category[category] = [re.compile(p, re.IGNORECASE) for p in patterns]
+        
+        # 添加用户自定义模式
+        if self._user_patterns:
+            patterns_by_category['custom'] = [re.compile(p, re.IGNORECASE) for p in self._user_patterns]
+        
+        # 安全模式、上下文排除模式、白名单模式
+        self._safe_patterns = [re.compile(p, re.IGNORECASE) for p in self.SAFE_PATTERNS]
+        self._exclude_patterns = [
+            re.compile(p, re.IGNORECASE) for p in self.EXCLUDE_CONTEXT_PATTERNS
+        ]
+        self._whitelist_patterns = [
+            re.compile(p, re.IGNORECASE) for p in self.whitelist_patterns
+        ]
+        self._patterns = patterns_by_category
+    
     def _scan_line(self, line: str) -> List[Dict]:
         """扫描单行内容"""
+        if self._patterns is None:
+            self._compile_patterns()
         findings = []
         
         # 1. 检查是否匹配安全模式
@@ -364,6 +370,8 @@ class SensitiveInfoObserver(BaseObserver):
     
     def _redact_line(self, line: str) -> str:
         """脱敏整行内容"""
+        if self._patterns is None:
+            self._compile_patterns()
         result = line
         
         # 脱敏所有敏感模式匹配
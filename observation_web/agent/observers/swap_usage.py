@@ -1,15 +1,14 @@
 """
 Swap 使用率监测观察点
 
-监测系统 swap 空间使用情况。
+监测系统 swap 空间使用情况（数据来自共享系统统计快照中的 /proc/meminfo）。
 """
 
 import logging
-from pathlib import Path
 from typing import Any, Dict, Optional
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import parse_key_value
+from ..utils.sysstats import get_system_stats
 
 logger = logging.getLogger(__name__)
 
@@ -92,31 +91,11 @@ class SwapUsageObserver(BaseObserver):
         )
 
     def _get_swap_info(self) -> Optional[Dict[str, int]]:
-        """获取 Swap 信息"""
-        meminfo_path = Path('/proc/meminfo')
-
-        if not meminfo_path.exists():
-            return None
-
-        try:
-            content = meminfo_path.read_text()
-            info = {}
-
-            for line in content.strip().split('\n'):
-                if ':' not in line:
-                    continue
-                key, value = line.split(':', 1)
-                key = key.strip()
-
-                if key in ['SwapTotal', 'SwapFree', 'SwapCached']:
-                    value = value.strip().replace(' kB', '')
-                    try:
-                        info[key] = int(value)
-                    except ValueError:
-                        info[key] = 0
-
-            return info
-
-        except Exception as e:
-            logger.error(f"读取 /proc/meminfo 失败: {e}")
+        """获取 Swap 信息（kB）"""
+        stats = get_system_stats()
+        if stats is None or 'SwapTotal' not in stats.meminfo:
             return None
+        return {
+            key: stats.meminfo.get(key, 0)
+            for key in ('SwapTotal', 'SwapFree', 'SwapCached')
+        }
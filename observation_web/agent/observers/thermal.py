@@ -5,12 +5,17 @@ CPU 温度监测观察点
 """
 
 import logging
+import time
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Dict, List, Optional, Tuple
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
+from ..utils.counters import get_counter_reader, parse_int
 from ..utils.helpers import run_command
 
+# 热区列表重新发现间隔（秒），热区在运行期间基本不变
+ZONE_REDISCOVER_INTERVAL = 600
+
 logger = logging.getLogger(__name__)
 
 
@@ -23,6 +28,8 @@ class ThermalObserver(BaseObserver):
         self.temp_warning_celsius = config.get('temp_warning_celsius', 75)
         self.temp_critical_celsius = config.get('temp_critical_celsius', 90)
         self._was_alerting = False
+        self._zones = []  # type: List[Tuple[str, str, str]]
+        self._zones_discovered_at = 0.0
 
     def check(self, reporter=None) -> ObserverResult:
         """检查温度"""
@@ -92,32 +99,43 @@ class ThermalObserver(BaseObserver):
             details=details,
         )
 
-    def _get_temperatures(self) -> List[Dict]:
-        """获取温度信息"""
-        temps = []
-
+    def _discover_zones(self) -> List[Tuple[str, str, str]]:
+        """发现热区：(zone, type, temp 文件路径)，type 只在发现时读取一次"""
+        zones = []
         thermal_path = Path('/sys/class/thermal')
         if thermal_path.exists():
-            for zone in thermal_path.glob('thermal_zone*'):
+            for zone in sorted(thermal_path.glob('thermal_zone*')):
                 temp_file = zone / 'temp'
+                if not temp_file.exists():
+                    continue
+                zone_type = 'unknown'
                 type_file = zone / 'type'
-
-                if temp_file.exists():
+                if type_file.exists():
                     try:
-                        temp_milli = int(temp_file.read_text().strip())
-                        temp_celsius = temp_milli / 1000.0
-
-                        zone_type = 'unknown'
-                        if type_file.exists():
-                            zone_type = type_file.read_text().strip()
-
-                        temps.append({
-                            'zone': zone.name,
-                            'type': zone_type,
-                            'temp_celsius': round(temp_celsius, 1),
-                        })
-                    except (ValueError, IOError):
+                        zone_type = type_file.read_text().strip()
+                    except (IOError, OSError):
                         pass
+                zones.append((zone.name, zone_type, str(temp_file)))
+        return zones
+
+    def _get_temperatures(self) -> List[Dict]:
+        """获取温度信息"""
+        now = time.monotonic()
+        if not self._zones or now - self._zones_discovered_at >= ZONE_REDISCOVER_INTERVAL:
+            self._zones = self._discover_zones()
+            self._zones_discovered_at = now
+
+        temps = []
+        values = get_counter_reader().read_many(path for _, _, path in self._zones)
+        for zone_name, zone_type, path in self._zones:
+            temp_milli = parse_int(values.get(path))
+            if temp_milli is None:
+                continue
+            temps.append({
+                'zone': zone_name,
+                'type': zone_type,
+                'temp_celsius': round(temp_milli / 1000.0, 1),
+            })
 
         if not temps:
             temps = self._get_temps_from_sensors()
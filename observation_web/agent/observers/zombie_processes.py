@@ -8,7 +8,7 @@ import logging
 from typing import Any, Dict, List
 
 from ..core.base import BaseObserver, ObserverResult, AlertLevel
-from ..utils.helpers import run_command
+from ..utils.proctable import get_process_table
 
 logger = logging.getLogger(__name__)
 
@@ -32,7 +32,7 @@ class ZombieProcessesObserver(BaseObserver):
             return self.create_result(
                 has_alert=False,
                 message="无法获取进程信息",
-                details={'error': '执行 ps 命令失败'},
+                details={'error': '读取 /proc 进程表失败'},
             )
 
         zombie_count = zombie_info['count']
@@ -84,33 +84,21 @@ class ZombieProcessesObserver(BaseObserver):
         )
 
     def _get_zombie_processes(self) -> Dict[str, Any]:
-        """获取僵尸进程列表"""
-        ret, stdout, _ = run_command(['ps', 'aux'], timeout=10)
-
-        if ret != 0:
+        """获取僵尸进程列表（来自本轮共享的进程表快照）"""
+        table = get_process_table()
+        if table is None:
             return None
 
         zombies = []
-        for line in stdout.strip().split('\n')[1:]:
-            parts = line.split()
-            if len(parts) >= 11:
-                stat = parts[7]
-                if 'Z' in stat:
-                    zombies.append({
-                        'pid': parts[1],
-                        'ppid': self._get_ppid(parts[1]),
-                        'user': parts[0],
-                        'command': ' '.join(parts[10:])[:100],
-                    })
+        for proc in table.zombies():
+            zombies.append({
+                'pid': str(proc.pid),
+                'ppid': str(proc.ppid),
+                'user': proc.user,
+                'command': '{} <defunct>'.format(proc.command)[:100],
+            })
 
         return {
             'count': len(zombies),
             'processes': zombies,
         }
-
-    def _get_ppid(self, pid: str) -> str:
-        """获取父进程 ID"""
-        ret, stdout, _ = run_command(['ps', '-o', 'ppid=', '-p', pid], timeout=5)
-        if ret == 0 and stdout:
-            return stdout.strip()
-        return 'unknown'
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+本地时序查询：python3 -m observation_points.query
+
+只读映射上报器维护的时序环形缓冲（metrics.ring），按时间范围 / 最近 N 点 / 聚合输出 JSON。
+供后端通过一次 SSH 调用取回所需窗口，例如：
+
+    python3 -m observation_points.query --since 3600 --format records
+    python3 -m observation_points.query --series 'cpu_usage/*' --since 86400 --step 300
+    python3 -m observation_points.query --series memory_leak/mem_used_mb --last 10
+"""
+
+import argparse
+import fnmatch
+import json
+import sys
+import time
+from datetime import datetime
+from typing import Any, Dict, List, Optional
+
+from .core.timeseries import TimeSeriesStore
+
+DEFAULT_RING_PATH = '/var/log/observation-points/metrics.ring'
+
+
+def _number(value):
+    # type: (float) -> Any
+    """整数值按 int 输出，与 metrics.jsonl 中的原始类型一致"""
+    return int(value) if value == value and float(value).is_integer() else value
+
+
+def select_series(store, patterns):
+    # type: (TimeSeriesStore, Optional[List[str]]) -> List[str]
+    names = store.series()
+    if not patterns:
+        return names
+    return [n for n in names if any(fnmatch.fnmatchcase(n, p) for p in patterns)]
+
+
+def build_records(store, names, since=None, until=None, last=None):
+    # type: (TimeSeriesStore, List[str], Optional[float], Optional[float], Optional[int]) -> List[Dict[str, Any]]
+    """
+    合并为 metrics.jsonl 兼容记录：同一观察点同一时刻的各指标合为一条
+    {"ts": ISO 时间, "observer": 名称, <metric>: 值, ...}
+    """
+    merged = {}  # type: Dict[Any, Dict[str, Any]]
+    for name in names:
+        observer, _, metric = name.partition('/')
+        for ts, value in store.query(name, since=since, until=until, last=last):
+            record = merged.get((ts, observer))
+            if record is None:
+                record = merged[(ts, observer)] = {
+                    'ts': datetime.fromtimestamp(ts).isoformat(),
+                    'observer': observer,
+                }
+            record[metric or observer] = _number(value)
+    return [merged[k] for k in sorted(merged)]
+
+
+def run_query(args):
+    # type: (argparse.Namespace) -> Dict[str, Any]
+    store = TimeSeriesStore(args.path, readonly=True)
+    try:
+        names = select_series(store, args.series)
+        if args.list:
+            return {'series': names}
+
+        until = args.until
+        since = args.start
+        if args.since is not None:
+            since = (until or time.time()) - args.since
+
+        if args.format == 'records':
+            return {'records': build_records(store, names, since, until, args.last)}
+
+        result = {}  # type: Dict[str, Any]
+        for name in names:
+            if args.agg or args.step:
+                result[name] = store.aggregate(name, since=since, until=until, step=args.step)
+            else:
+                result[name] = [[ts, _number(v)]
+                                for ts, v in store.query(name, since=since, until=until, last=args.last)]
+        return {'series': result}
+    finally:
+        store.close()
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description='查询 agent 本地时序环形缓冲')
+    parser.add_argument('--path', default=DEFAULT_RING_PATH, help='时序文件路径')
+    parser.add_argument('--series', action='append',
+                        help='序列名或通配符（<observer>/<metric>，可重复），默认全部')
+    parser.add_argument('--list', action='store_true', help='只列出序列名')
+    parser.add_argument('--since', type=float, help='最近 N 秒')
+    parser.add_argument('--start', type=float, help='起始时间戳（秒）')
+    parser.add_argument('--until', type=float, help='结束时间戳（秒）')
+    parser.add_argument('--last', type=int, help='每个序列只取最近 N 个点')
+    parser.add_argument('--agg', action='store_true', help='输出 count/min/max/avg/first/last')
+    parser.add_argument('--step', type=float, help='按 N 秒分桶聚合')
+    parser.add_argument('--format', choices=['series', 'records'], default='series',
+                        help='series: 按序列输出；records: 合并为 metrics.jsonl 兼容记录')
+    args = parser.parse_args(argv)
+
+    try:
+        output = run_query(args)
+    except (OSError, ValueError) as e:
+        sys.stderr.write(f"{e}\n")
+        return 2
+    sys.stdout.write(json.dumps(output, ensure_ascii=False, separators=(',', ':')))
+    sys.stdout.write('\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
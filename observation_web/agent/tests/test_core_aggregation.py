@@ -0,0 +1,119 @@
+"""Tests for core/aggregation.py — metric aggregation before push."""
+from observation_points.core.aggregation import MetricAggregator
+
+
+class Clock:
+    def __init__(self):
+        self.now = 1000.0
+
+    def __call__(self):
+        return self.now
+
+
+def _agg(config):
+    clock = Clock()
+    return MetricAggregator(config, clock=clock), clock
+
+
+def rec(**values):
+    return dict(values, ts="2026-01-01T00:00:00", observer="cpu_usage")
+
+
+class TestDeadband:
+    def test_change_only_with_heartbeat(self):
+        agg, clock = _agg({"mode": "deadband", "heartbeat_seconds": 300})
+        assert agg.offer("cpu_usage", rec(cpu0=10)) == [rec(cpu0=10)]
+        clock.now += 10
+        assert agg.offer("cpu_usage", rec(cpu0=10)) == []
+        clock.now += 10
+        assert agg.offer("cpu_usage", rec(cpu0=11)) == [rec(cpu0=11)]
+        clock.now += 300
+        assert agg.offer("cpu_usage", rec(cpu0=11)) == [rec(cpu0=11)]
+
+    def test_absolute_and_percent_deadband(self):
+        agg, clock = _agg({"observers": {"cpu_usage": {"deadband": 2},
+                                         "memory_leak": {"deadband_percent": 5}}})
+        agg.offer("cpu_usage", rec(cpu0=10))
+        assert agg.offer("cpu_usage", rec(cpu0=11.5)) == []
+        assert agg.offer("cpu_usage", rec(cpu0=12.5)) != []
+        agg.offer("memory_leak", {"mem_used_mb": 1000})
+        assert agg.offer("memory_leak", {"mem_used_mb": 1040}) == []
+        assert agg.offer("memory_leak", {"mem_used_mb": 1060}) != []
+
+    def test_new_field_is_emitted(self):
+        agg, _ = _agg({})
+        agg.offer("cpu_usage", rec(cpu0=10))
+        assert agg.offer("cpu_usage", rec(cpu0=10, cpu_total=5)) != []
+
+
+class TestWindowAndHeartbeat:
+    def test_window_emits_min_max_avg(self):
+        agg, clock = _agg({"mode": "window", "window_seconds": 60})
+        for v in (10, 20, 30):
+            assert agg.offer("cpu_usage", rec(cpu0=v)) == []
+            clock.now += 20
+        out = agg.offer("cpu_usage", rec(cpu0=40))
+        assert len(out) == 1
+        assert out[0]["cpu0"] == 20 and out[0]["cpu0_min"] == 10 and out[0]["cpu0_max"] == 30
+        assert out[0]["samples"] == 3 and out[0]["observer"] == "cpu_usage"
+        flushed = agg.flush()
+        assert flushed[0]["cpu0"] == 40 and flushed[0]["samples"] == 1
+        assert agg.flush() == []
+
+    def test_heartbeat_only(self):
+        agg, clock = _agg({"mode": "heartbeat", "heartbeat_seconds": 60})
+        assert agg.offer("x", {"v": 1}) != []
+        clock.now += 30
+        assert agg.offer("x", {"v": 99}) == []
+        clock.now += 30
+        assert agg.offer("x", {"v": 2}) == [{"v": 2}]
+
+    def test_raw(self):
+        agg, _ = _agg({"mode": "raw"})
+        assert agg.offer("x", {"v": 1}) and agg.offer("x", {"v": 1})
+
+
+class TestBackPressure:
+    def test_header_and_throttle_status_raise_level(self):
+        agg, _ = _agg({})
+        agg.update_pressure(200, "2")
+        assert agg.pressure == 2
+        agg.update_pressure(429, None)
+        assert agg.pressure == 3
+        agg.update_pressure(503, None)
+        assert agg.pressure == 3  # 上限
+
+    def test_pressure_decays_one_level_per_period(self):
+        agg, clock = _agg({"pressure_decay_seconds": 60})
+        agg.update_pressure(200, "2")
+        clock.now += 30
+        agg.update_pressure(200, "0")
+        assert agg.pressure == 2
+        clock.now += 30
+        agg.update_pressure(200, None)
+        assert agg.pressure == 1
+        clock.now += 60
+        assert agg.pressure == 0
+
+    def test_pressure_widens_heartbeat_and_tightens_raw(self):
+        agg, clock = _agg({"mode": "raw", "heartbeat_seconds": 60, "pressure_decay_seconds": 3600})
+        agg.update_pressure(200, "1")
+        assert agg.offer("x", {"v": 1}) != []
+        assert agg.offer("x", {"v": 1}) == []  # raw 在压力下仅变化时推送
+        clock.now += 90
+        assert agg.offer("x", {"v": 1}) == []  # 心跳 60s × 2
+        clock.now += 30
+        assert agg.offer("x", {"v": 1}) != []
+
+
+def test_reporter_pushes_aggregated(tmp_path, monkeypatch):
+    from observation_points.core.reporter import Reporter
+    pushed = []
+    r = Reporter({"output": "console", "file_path": str(tmp_path / "alerts.log"),
+                  "push_enabled": True, "push_url": "http://backend/api/ingest",
+                  "timeseries_enabled": False})
+    monkeypatch.setattr(r, "_push_metrics_to_web", pushed.append)
+    for _ in range(3):
+        r.record_metrics({"cpu0": 10.0, "observer": "cpu_usage"})
+    assert len(pushed) == 1
+    assert len((tmp_path / "metrics.jsonl").read_text().splitlines()) == 3
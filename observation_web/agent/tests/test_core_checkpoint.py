@@ -0,0 +1,180 @@
+"""Tests for core/checkpoint.py — crash-safe observer state checkpoints."""
+import json
+import os
+from datetime import datetime, timedelta
+
+from observation_points.core.base import AlertLevel, ObserverResult
+from observation_points.core.checkpoint import (
+    CHECKPOINT_VERSION, CheckpointStore, log_cursor, restore_log_cursor,
+)
+from observation_points.core.reporter import Reporter
+
+
+class TestCheckpointStore:
+    def test_round_trip(self, tmp_path):
+        store = CheckpointStore(tmp_path / "state" / "checkpoint.json")
+        assert store.load() == {}
+        assert store.save({"obs": {"a": 1}}, {"r": {}}) is True
+        data = store.load()
+        assert data["version"] == CHECKPOINT_VERSION
+        assert data["observers"] == {"obs": {"a": 1}}
+        # 不留下临时文件
+        assert os.listdir(tmp_path / "state") == ["checkpoint.json"]
+
+    def test_corrupt_or_foreign_file_ignored(self, tmp_path):
+        path = tmp_path / "checkpoint.json"
+        path.write_text("{not json")
+        assert CheckpointStore(path).load() == {}
+        path.write_text(json.dumps({"version": 999, "observers": {"x": {}}}))
+        assert CheckpointStore(path).load() == {}
+
+    def test_non_json_values_saved_as_str(self, tmp_path):
+        store = CheckpointStore(tmp_path / "checkpoint.json")
+        ts = datetime(2026, 1, 1, 10, 0, 0)
+        assert store.save({"obs": {"ts": ts}}) is True
+        assert store.load()["observers"]["obs"] == {"ts": str(ts)}
+
+
+class TestLogCursor:
+    def test_same_file_resumes(self, tmp_path):
+        log = tmp_path / "messages"
+        log.write_text("a\nb\n")
+        cursor = log_cursor(2, os.stat(log).st_ino)
+        with open(log, "a") as f:
+            f.write("c\n")
+        assert restore_log_cursor(log, cursor) == (2, os.stat(log).st_ino)
+
+    def test_rotated_file_starts_over(self, tmp_path):
+        log = tmp_path / "messages"
+        log.write_text("a\nb\nc\n")
+        cursor = log_cursor(6, os.stat(log).st_ino)
+        os.rename(log, tmp_path / "messages.1")
+        log.write_text("new\n" * 10)
+        assert restore_log_cursor(log, cursor) == (0, os.stat(log).st_ino)
+
+    def test_truncated_file_starts_over(self, tmp_path):
+        log = tmp_path / "messages"
+        log.write_text("x" * 100)
+        cursor = log_cursor(100, os.stat(log).st_ino)
+        log.write_text("y")
+        assert restore_log_cursor(log, cursor)[0] == 0
+
+    def test_unknown(self, tmp_path):
+        assert restore_log_cursor(tmp_path / "missing", {"position": 5, "inode": 1}) is None
+        assert restore_log_cursor(tmp_path / "missing", None) is None
+
+
+class TestObserverState:
+    def test_alarm_type_resumes_and_keeps_active_alarms(self, tmp_path):
+        from observation_points.observers.alarm_type import AlarmTypeObserver
+        log = tmp_path / "alarm.txt"
+        log.write_text("old line\n")
+        config = {"log_path": str(log)}
+
+        first = AlarmTypeObserver("alarm_type", config)
+        first.check()
+        with open(log, "a") as f:
+            f.write("2026-01-01 10:00:00 AlarmType:1 fault AlarmId:0xA1 objType:PORT\n")
+        first.check()
+        state = json.loads(json.dumps(first.get_state()))
+
+        # 停机期间写入的恢复事件
+        with open(log, "a") as f:
+            f.write("2026-01-01 10:05:00 AlarmType:2 resume AlarmId:0xA1 objType:PORT\n")
+
+        second = AlarmTypeObserver("alarm_type", config)
+        second.restore_state(state)
+        assert list(second._active_alarms) == ["0xA1"]
+        second.check()
+        assert second._active_alarms == {}
+        assert second._total_send_count == 1
+        assert second._total_resume_count == 1
+
+    def test_sig_monitor_reads_gap_lines(self, tmp_path):
+        from observation_points.observers.sig_monitor import SigMonitorObserver
+        log = tmp_path / "messages"
+        log.write_text("boot\n")
+        first = SigMonitorObserver("sig_monitor", {"log_path": str(log)})
+        first.check()
+        state = first.get_state()
+
+        with open(log, "a") as f:
+            f.write("2026-01-01 10:00:00 app_data receive sig 11\n")
+
+        second = SigMonitorObserver("sig_monitor", {"log_path": str(log)})
+        second.restore_state(state)
+        assert second.check().has_alert is True
+
+    def test_rotation_before_save_keeps_new_log(self, tmp_path):
+        from observation_points.observers.sig_monitor import SigMonitorObserver
+        log = tmp_path / "messages"
+        log.write_text("boot line one\n")
+        first = SigMonitorObserver("sig_monitor", {"log_path": str(log)})
+        first.check()
+
+        # 上次读取之后、保存检查点之前日志轮转，新文件已有新内容
+        os.rename(log, tmp_path / "messages.1")
+        log.write_text("2026-01-01 10:00:00 app_data receive sig 11\n")
+        state = json.loads(json.dumps(first.get_state()))
+
+        second = SigMonitorObserver("sig_monitor", {"log_path": str(log)})
+        second.restore_state(state)
+        assert second._file_position == 0
+        assert second.check().has_alert is True
+
+    def test_process_crash_does_not_rescan(self, tmp_path):
+        from unittest.mock import patch
+        from observation_points.observers.process_crash import ProcessCrashObserver
+        log = tmp_path / "messages"
+        log.write_text("app[12]: segfault at 0 ip 0\n")
+        config = {"log_paths": [str(log)]}
+        with patch("observation_points.observers.process_crash.run_command", return_value=(1, "", "")):
+            first = ProcessCrashObserver("process_crash", config)
+            assert first.check().has_alert is True
+            second = ProcessCrashObserver("process_crash", config)
+            second.restore_state(json.loads(json.dumps(first.get_state())))
+            assert second.check().has_alert is False
+
+
+def test_reporter_cooldown_survives_restart():
+    result = ObserverResult(observer_name="obs", timestamp=datetime.now(), has_alert=True,
+                            alert_level=AlertLevel.ERROR, message="port down")
+    first = Reporter({"output": "console", "cooldown_seconds": 300})
+    first.report(result)
+    state = json.loads(json.dumps(first.get_state()))
+
+    second = Reporter({"output": "console", "cooldown_seconds": 300}, dry_run=True)
+    second.restore_state(state)
+    assert second._is_in_cooldown(result) is True
+
+    expired = {"obs": {k: (datetime.now() - timedelta(hours=1)).isoformat() for k in state["obs"]}}
+    third = Reporter({"output": "console", "cooldown_seconds": 300}, dry_run=True)
+    third.restore_state(expired)
+    assert third._is_in_cooldown(result) is False
+
+
+def test_reporter_restore_parses_both_isoformat_shapes():
+    reporter = Reporter({"output": "console", "cooldown_seconds": 300}, dry_run=True)
+    whole = datetime.now().replace(microsecond=0)
+    frac = datetime.now().replace(microsecond=123456)
+    reporter.restore_state({"obs": {"a": whole.isoformat(), "b": frac.isoformat(), "c": "garbage", "d": None}})
+    assert reporter._cooldown_cache["obs"] == {"a": whole, "b": frac}
+
+
+def test_scheduler_checkpoint_round_trip(tmp_path):
+    from observation_points.core.scheduler import Scheduler
+    log = tmp_path / "messages"
+    log.write_text("boot\n")
+    config = {
+        "global": {"checkpoint_path": str(tmp_path / "cp.json")},
+        "observers": {"sig_monitor": {"log_path": str(log)}},
+    }
+    reporter = Reporter({"output": "console"}, dry_run=True)
+    sched = Scheduler(config, reporter)
+    sched._observers[0][0].check()
+    assert sched.save_checkpoint() is True
+
+    with open(log, "a") as f:
+        f.write("app receive sig 6\n")
+    restarted = Scheduler(config, Reporter({"output": "console"}, dry_run=True))
+    assert restarted._observers[0][0].check().has_alert is True
@@ -0,0 +1,115 @@
+"""Tests for core/timeseries.py and the local query CLI."""
+import json
+
+import pytest
+
+from observation_points.core.reporter import Reporter
+from observation_points.core.timeseries import TimeSeriesStore, summarize
+
+
+@pytest.fixture
+def store(tmp_path):
+    s = TimeSeriesStore(tmp_path / "metrics.ring", max_series=4, capacity=5)
+    yield s
+    s.close()
+
+
+class TestTimeSeriesStore:
+    def test_append_and_query(self, store):
+        for i in range(3):
+            store.append("cpu_usage/cpu0", 100 + i, i * 10)
+        assert store.query("cpu_usage/cpu0") == [(100, 0), (101, 10), (102, 20)]
+        assert store.query("cpu_usage/cpu0", since=101) == [(101, 10), (102, 20)]
+        assert store.query("cpu_usage/cpu0", until=101, last=1) == [(101, 10)]
+        assert store.query("missing") == []
+
+    def test_wraps_and_keeps_newest(self, store):
+        for i in range(12):
+            store.append("s", i, i)
+        assert [p[0] for p in store.query("s")] == [7, 8, 9, 10, 11]
+
+    def test_series_limit(self, store):
+        for i in range(4):
+            assert store.append(f"obs/m{i}", 1, 1) is True
+        assert store.append("obs/overflow", 1, 1) is False
+        assert store.append("x" * 200, 1, 1) is False
+        assert len(store.series()) == 4
+
+    def test_record_skips_non_numeric(self, store):
+        assert store.record("cpu_usage", {"cpu0": 12.5, "observer": "cpu_usage", "ok": True}, 10) == 1
+        assert store.series() == ["cpu_usage/cpu0"]
+
+    def test_aggregate(self, store):
+        for ts, v in [(0, 1), (30, 3), (60, 10), (90, 20)]:
+            store.append("s", ts, v)
+        total = store.aggregate("s")
+        assert total["count"] == 4 and total["min"] == 1 and total["max"] == 20
+        assert total["avg"] == 8.5 and total["last"] == 20
+        buckets = store.aggregate("s", step=60)
+        assert [(b["ts"], b["count"], b["avg"]) for b in buckets] == [(0, 2, 2.0), (60, 2, 15.0)]
+        assert summarize([])["count"] == 0
+
+    def test_readonly_sees_writer_and_survives_reopen(self, tmp_path, store):
+        store.append("a/x", 1, 1)
+        reader = TimeSeriesStore(store.path, readonly=True)
+        try:
+            assert reader.query("a/x") == [(1, 1)]
+            store.append("b/y", 2, 2)  # 新序列在读取方首次访问时被发现
+            assert reader.query("b/y") == [(2, 2)]
+        finally:
+            reader.close()
+        store.close()
+        reopened = TimeSeriesStore(store.path, max_series=4, capacity=5)
+        assert reopened.query("a/x") == [(1, 1)]
+        reopened.close()
+
+    def test_resized_file_is_rebuilt(self, tmp_path, store):
+        store.append("a/x", 1, 1)
+        store.close()
+        bigger = TimeSeriesStore(store.path, max_series=8, capacity=5)
+        assert bigger.series() == []
+        bigger.close()
+
+    def test_readonly_rejects_foreign_file(self, tmp_path):
+        path = tmp_path / "junk"
+        path.write_bytes(b"x" * 128)
+        with pytest.raises(ValueError):
+            TimeSeriesStore(path, readonly=True)
+
+
+def test_reporter_records_series(tmp_path):
+    r = Reporter({"output": "console", "file_path": str(tmp_path / "alerts.log")})
+    r.record_metrics({"mem_used_mb": 3200, "mem_total_mb": 8000, "observer": "memory_leak"})
+    r.close()
+    reader = TimeSeriesStore(tmp_path / "metrics.ring", readonly=True)
+    try:
+        assert reader.series() == ["memory_leak/mem_total_mb", "memory_leak/mem_used_mb"]
+        assert reader.query("memory_leak/mem_used_mb")[0][1] == 3200
+    finally:
+        reader.close()
+
+
+def test_query_cli(tmp_path, capsys):
+    from observation_points.query import main
+    path = tmp_path / "metrics.ring"
+    s = TimeSeriesStore(path, max_series=8, capacity=16)
+    s.record("cpu_usage", {"cpu0": 10.5, "cpu_total": 7}, 1000)
+    s.record("cpu_usage", {"cpu0": 20.0, "cpu_total": 8}, 1060)
+    s.record("memory_leak", {"mem_used_mb": 3200}, 1030)
+    s.close()
+
+    assert main(["--path", str(path), "--format", "records", "--start", "1000"]) == 0
+    records = json.loads(capsys.readouterr().out)["records"]
+    assert [r["observer"] for r in records] == ["cpu_usage", "memory_leak", "cpu_usage"]
+    assert records[0]["cpu0"] == 10.5 and records[0]["cpu_total"] == 7
+    assert records[2]["cpu0"] == 20
+
+    assert main(["--path", str(path), "--series", "cpu_usage/*", "--last", "1"]) == 0
+    out = json.loads(capsys.readouterr().out)["series"]
+    assert out == {"cpu_usage/cpu0": [[1060, 20]], "cpu_usage/cpu_total": [[1060, 8]]}
+
+    assert main(["--path", str(path), "--series", "memory_leak/*", "--agg"]) == 0
+    agg = json.loads(capsys.readouterr().out)["series"]["memory_leak/mem_used_mb"]
+    assert agg["count"] == 1 and agg["max"] == 3200
+
+    assert main(["--path", str(tmp_path / "missing.ring")]) == 2
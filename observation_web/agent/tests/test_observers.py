@@ -141,6 +141,38 @@ class TestMemoryLeakObserver:
         mock_reporter = MagicMock()
         result = obs.check(reporter=mock_reporter)
 
+    def _run_trend(self, used_series, config=None):
+        from agent.observers.memory_leak import MemoryLeakObserver
+        from agent.utils.sysstats import SystemStats
+        obs = MemoryLeakObserver("memory_leak", dict({"window_size": 8}, **(config or {})))
+        results = []
+        for i, used_mb in enumerate(used_series):
+            stats = SystemStats({}, {"MemTotal": 16000 * 1024, "MemFree": (16000 - used_mb) * 1024}, None)
+            with patch("agent.observers.memory_leak.get_system_stats", return_value=stats), \
+                    patch("agent.observers.memory_leak.time.time", return_value=i * 5400.0):
+                results.append(obs.check())
+        return results
+
+    def test_slow_leak_with_dips_alerts(self):
+        # 每 1.5h 约增长 12MB，中间有回落：旧的“连续增长”判定会被清零
+        series = [8000, 8014, 8010, 8040, 8050, 8046, 8075, 8090]
+        results = self._run_trend(series)
+        assert all(not r.has_alert for r in results[:4])
+        assert results[4].has_alert is True
+        assert results[4].details["trend"]["slope_per_hour"] > 5
+
+    def test_noise_does_not_alert(self):
+        series = [8000, 8300, 7900, 8250, 7950, 8200, 7980, 8100]
+        assert not any(r.has_alert for r in self._run_trend(series))
+
+    def test_recovers_after_trend_stops(self):
+        series = [8000, 8100, 8200, 8300, 8400] + [8400] * 8
+        results = self._run_trend(series, {"recovery_threshold": 3})
+        assert results[4].has_alert is True
+        recovered = [r for r in results if r.details.get("recovered")]
+        assert len(recovered) == 1
+        assert recovered[0].alert_level == AlertLevel.INFO
+
 
 # ---------- CpuUsageObserver ----------
 
@@ -189,6 +221,45 @@ class TestCmdResponseObserver:
         result = obs.check()
         assert result.has_alert is True
 
+    @patch("observation_points.observers.cmd_response.session_for")
+    def test_session_excludes_startup_time(self, mock_session_for):
+        session = MagicMock()
+        session.last_command_seconds = 0.002
+
+        def slow_first_start(cmd, timeout):
+            import time
+            time.sleep(0.1)  # 会话启动与登录
+            return (0, "output", "")
+        session.run.side_effect = slow_first_start
+        mock_session_for.return_value = session
+        from observation_points.observers.cmd_response import CmdResponseObserver
+        obs = CmdResponseObserver("cmd_response", {
+            "timeout_seconds": 0.05,
+            "commands": ["show system"],
+            "cli_session": "os_cli",
+        })
+        result = obs.check()
+        assert result.has_alert is False
+        assert result.details["results"][0]["elapsed_seconds"] == 0.002
+
+
+# ---------- AbnormalResetObserver ----------
+
+class TestAbnormalResetObserver:
+    @patch("agent.observers.abnormal_reset.get_cli_session")
+    def test_uses_persistent_session(self, mock_get_session):
+        mock_get_session.return_value.run.return_value = (
+            0, "reason: watchDog reset\ntime: 2026-01-01 10:00:00\n", "")
+        from agent.observers.abnormal_reset import AbnormalResetObserver
+        obs = AbnormalResetObserver("abnormal_reset", {"os_cli_cmd": "os_cli"})
+        result = obs.check()
+        assert result.has_alert is True
+        mock_get_session.assert_called_once()
+        assert mock_get_session.call_args[0][0] == "os_cli"
+        mock_get_session.return_value.run.assert_called_once_with("cat log_reset.txt", timeout=30)
+        # 同一复位记录不重复上报
+        assert obs.check().has_alert is False
+
 
 # ---------- CardRecoveryObserver ----------
 
@@ -376,3 +447,125 @@ class TestErrorCodeObserver:
         obs = PortCountersObserver("error_code", {"ports": [], "threshold": 10, "anytest_enabled": False, "pcie_enabled": False})
         # Simulate previous baseline
         obs._last_sysfs["eth0"] = {"rx_errors": 100}
+
+
+# ---------- Process table observers ----------
+
+def _table(*procs):
+    from agent.utils.proctable import ProcessInfo, ProcessTable
+    return ProcessTable([ProcessInfo(*p) for p in procs])
+
+
+class TestZombieProcessesObserver:
+    @patch("agent.observers.zombie_processes.get_process_table")
+    def test_zombies_from_snapshot(self, mock_table):
+        mock_table.return_value = _table(
+            (1, 0, "S", "init", "/sbin/init", 0),
+            (50, 1, "Z", "child", "", 0),
+        )
+        from agent.observers.zombie_processes import ZombieProcessesObserver
+        obs = ZombieProcessesObserver("zombie_processes", {"consecutive_threshold": 1})
+        result = obs.check()
+        assert result.has_alert is True
+        zombie = result.details["zombies"][0]
+        assert zombie["pid"] == "50"
+        assert zombie["ppid"] == "1"
+        assert zombie["command"] == "[child] <defunct>"
+
+    @patch("agent.observers.zombie_processes.get_process_table", return_value=None)
+    def test_proc_unavailable(self, _):
+        from agent.observers.zombie_processes import ZombieProcessesObserver
+        result = ZombieProcessesObserver("zombie_processes", {}).check()
+        assert result.has_alert is False
+        assert "error" in result.details
+
+
+class TestProcessRestartObserver:
+    @patch("agent.observers.process_restart.get_process_table")
+    def test_v_param_increase_alerts(self, mock_table):
+        from agent.observers.process_restart import ProcessRestartObserver
+        obs = ProcessRestartObserver("process_restart", {"processes": ["devm"]})
+        mock_table.return_value = _table((10, 1, "S", "devm", "/bin/devm -v 1", 0))
+        assert obs.check().has_alert is False
+        mock_table.return_value = _table(
+            (11, 1, "S", "devm", "/bin/devm -v 2", 0),
+            (12, 1, "S", "devm", "/bin/devm -v 1", 0),
+        )
+        result = obs.check()
+        assert result.has_alert is True
+        assert "-v 1 -> 2" in result.message
+
+
+# ---------- PortTrafficObserver ----------
+
+class TestPortTrafficObserver:
+    def _make(self, tmp_path, **kwargs):
+        from agent.observers.port_traffic import PortTrafficObserver
+        config = {"net_root": str(tmp_path / "net"), "output_path": str(tmp_path / "traffic.jsonl"), **kwargs}
+        return PortTrafficObserver("port_traffic", config)
+
+    def _set(self, tmp_path, port, rx_bytes, tx_bytes, rx_packets=0, tx_packets=0):
+        stats = tmp_path / "net" / port / "statistics"
+        stats.mkdir(parents=True, exist_ok=True)
+        for name, value in (("rx_bytes", rx_bytes), ("tx_bytes", tx_bytes),
+                            ("rx_packets", rx_packets), ("tx_packets", tx_packets)):
+            (stats / name).write_text(f"{value}\n")
+
+    def test_burst_visible_in_peak_and_percentiles(self, tmp_path):
+        obs = self._make(tmp_path)
+        rx = 0
+        self._set(tmp_path, "eth0", rx, 0)
+        obs.sample(now=0.0)
+        # 10 samples at 200ms: one 1 MB burst, otherwise 10 kB per sample
+        for i in range(1, 11):
+            rx += 1_000_000 if i == 5 else 10_000
+            self._set(tmp_path, "eth0", rx, 0, rx_packets=i * 10)
+            obs.sample(now=i * 0.2)
+
+        (summary,) = obs.summarize()
+        assert summary["port"] == "eth0"
+        assert summary["samples"] == 10
+        assert summary["window_s"] == 2.0
+        assert summary["rx_peak_bps"] == 40_000_000.0
+        assert summary["rx_p50_bps"] == 400_000.0
+        assert summary["rx_rate_bps"] == round(rx * 8 / 2.0, 1)
+        assert summary["rx_pps"] == 50.0
+        assert summary["tx_peak_bps"] == 0.0
+
+    def test_windows_are_contiguous(self, tmp_path):
+        obs = self._make(tmp_path)
+        self._set(tmp_path, "eth0", 0, 0)
+        obs.sample(now=0.0)
+        self._set(tmp_path, "eth0", 1000, 0)
+        obs.sample(now=1.0)
+        obs.summarize()
+        self._set(tmp_path, "eth0", 3000, 0)
+        obs.sample(now=2.0)
+        (summary,) = obs.summarize()
+        assert summary["rx_rate_bps"] == 16000.0
+        assert summary["window_s"] == 1.0
+
+    def test_counter_reset_interval_dropped(self, tmp_path):
+        obs = self._make(tmp_path)
+        self._set(tmp_path, "eth0", 5000, 0)
+        obs.sample(now=0.0)
+        self._set(tmp_path, "eth0", 100, 0)
+        obs.sample(now=0.2)
+        (summary,) = obs.summarize()
+        assert summary["samples"] == 0
+        assert summary["rx_rate_bps"] == 0.0
+
+    def test_check_writes_compatible_records(self, tmp_path):
+        obs = self._make(tmp_path)
+        self._set(tmp_path, "eth0", 0, 0)
+        obs.sample(now=0.0)
+        self._set(tmp_path, "eth0", 0, 2500)
+        obs.sample(now=1.0)
+        with patch.object(obs, "_ensure_sampler"):
+            result = obs.check()
+        assert result.has_alert is False
+        lines = (tmp_path / "traffic.jsonl").read_text().splitlines()
+        record = json.loads(lines[0])
+        for key in ("ts", "port", "tx_bytes", "rx_bytes", "tx_rate_bps", "rx_rate_bps", "mode", "protocol"):
+            assert key in record
+        assert record["tx_rate_bps"] == 20000.0
@@ -65,3 +65,72 @@ class TestScheduler:
         sched._observers.append((obs, time.time()))
         sched.stop()
         assert sched._running is False
+
+
+class TestLazyObserverLoading:
+    def _imported_observer_modules(self, observers_config):
+        """在独立进程中构造调度器，返回已导入的观察点模块"""
+        import json
+        import subprocess
+        import sys
+        from pathlib import Path
+        script = (
+            "import json, sys\n"
+            "from agent.core.scheduler import Scheduler\n"
+            "from agent.core.reporter import Reporter\n"
+            "config = {'global': {'checkpoint_enabled': False}, 'observers': json.loads(sys.argv[1])}\n"
+            "sched = Scheduler(config, Reporter({'output': 'console'}, dry_run=True))\n"
+            "print(json.dumps({'registered': [o.name for o, _ in sched._observers],\n"
+            "                  'modules': sorted(m for m in sys.modules if m.startswith('agent.observers.'))}))\n"
+        )
+        out = subprocess.run(
+            [sys.executable, "-c", script, json.dumps(observers_config)],
+            cwd=str(Path(__file__).parent.parent.parent),
+            stdout=subprocess.PIPE, check=True,
+        ).stdout
+        return json.loads(out.decode())
+
+    def test_only_enabled_observers_are_imported(self):
+        result = self._imported_observer_modules({
+            "cpu_usage": {"enabled": True},
+            "sensitive_info": {"enabled": False},
+            "alarm_type": {"enabled": False},
+        })
+        assert result["registered"] == ["cpu_usage"]
+        assert result["modules"] == ["agent.observers.cpu_usage", "agent.observers.registry"]
+
+    def test_legacy_alias_skips_deprecated_module(self):
+        result = self._imported_observer_modules({"error_code": {}})
+        assert result["registered"] == ["error_code"]
+        assert "agent.observers.error_code" not in result["modules"]
+        assert "agent.observers.port_counters" in result["modules"]
+
+    def test_unknown_observer_skipped(self):
+        assert self._imported_observer_modules({"no_such": {}})["registered"] == []
+
+
+def test_registry_entries_resolve():
+    from observation_points.core.base import BaseObserver
+    from observation_points.observers.registry import available_observers, load_observer_class
+    for name in available_observers():
+        assert issubclass(load_observer_class(name), BaseObserver), name
+    assert load_observer_class("no_such") is None
+
+
+def test_package_level_class_access():
+    import importlib
+    observers = importlib.import_module("agent.observers")
+    port_counters = importlib.import_module("agent.observers.port_counters")
+    assert observers.NetworkErrorsObserver is port_counters.PortCountersObserver
+    with pytest.raises(AttributeError):
+        observers.NoSuchObserver
+
+
+def test_package_from_import_and_star():
+    from agent.observers import CpuUsageObserver
+    from agent.observers.cpu_usage import CpuUsageObserver as direct
+    assert CpuUsageObserver is direct
+    namespace = {}
+    exec("from agent.observers import *", namespace)
+    import importlib
+    assert set(importlib.import_module("agent.observers").__all__) <= set(namespace)
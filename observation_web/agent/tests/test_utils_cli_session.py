@@ -0,0 +1,168 @@
+"""Tests for utils/cli_session.py — persistent pty-driven CLI session."""
+import importlib
+import sys
+import textwrap
+import threading
+
+import pytest
+
+from agent.utils.cli_session import CliSession, run_cli_command
+
+# 直接取 sys.modules 中的模块：observation_points 别名导入会重绑 agent.utils.cli_session 属性
+cli_session = importlib.import_module("agent.utils.cli_session")
+
+pytestmark = pytest.mark.skipif(cli_session.pty is None, reason="pty not available")
+
+FAKE_CLI = textwrap.dedent("""
+    import os, sys, time
+    prompt = sys.argv[1] if len(sys.argv) > 1 else ''
+    print("login succeed", flush=True)
+    while True:
+        sys.stdout.write(prompt)
+        sys.stdout.flush()
+        line = sys.stdin.readline()
+        if not line:
+            break
+        cmd = line.strip()
+        if cmd == 'exit':
+            break
+        if cmd == 'pid':
+            print(os.getpid())
+        elif cmd.startswith('sleep '):
+            time.sleep(float(cmd.split()[1]))
+            print('woke')
+        elif cmd.startswith('slow '):
+            time.sleep(float(cmd.split()[1]))
+            print('done:' + cmd)
+            print('line2')
+        elif cmd == 'crash':
+            sys.exit(3)
+        elif cmd:
+            print('out:' + cmd)
+            print('line2')
+        sys.stdout.flush()
+""")
+
+
+@pytest.fixture
+def fake_cli(tmp_path):
+    script = tmp_path / "fake_cli.py"
+    script.write_text(FAKE_CLI)
+    return f"{sys.executable} {script}"
+
+
+@pytest.fixture
+def session(fake_cli):
+    s = CliSession(f"{fake_cli} 'admin:/>'", ensure_path=False, ready_timeout=5)
+    yield s
+    s.close()
+
+
+class TestCliSession:
+    def test_prompt_learned_and_output_clean(self, session):
+        ret, out, err = session.run("show disk")
+        assert ret == 0 and err == ""
+        assert out == "out:show disk\nline2"
+        assert session.stats()["prompt"] == "admin:/>"
+
+    def test_process_is_reused(self, session):
+        _, pid1, _ = session.run("pid")
+        _, pid2, _ = session.run("pid")
+        assert pid1 == pid2
+        assert session.starts == 1 and session.commands == 2
+
+    def test_timeout_restarts_session(self, session):
+        _, pid1, _ = session.run("pid")
+        ret, _, err = session.run("sleep 2", timeout=0.5)
+        assert ret == -1 and err == "Timeout"
+        assert not session.alive
+        _, pid2, _ = session.run("pid")
+        assert pid2 != pid1
+        assert session.starts == 2
+
+    def test_exited_process_is_restarted(self, session):
+        session.run("crash", timeout=1)
+        ret, out, _ = session.run("hello")
+        assert ret == 0 and out.startswith("out:hello")
+
+    def test_commands_are_queued(self, session):
+        results = {}
+
+        def worker(i):
+            results[i] = session.run(f"cmd{i}")
+
+        threads = [threading.Thread(target=worker, args=(i,)) for i in range(5)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join(10)
+        assert {i: r[1].split("\n")[0] for i, r in results.items()} == {i: f"out:cmd{i}" for i in range(5)}
+        assert session.stats()["queued"] == 0
+
+    def test_health_check_after_idle(self, session):
+        session.run("pid")
+        session.health_interval = 0
+        ret, out, _ = session.run("again")
+        assert ret == 0 and out.startswith("out:again")
+        assert session.starts == 1
+
+    def test_quiet_mode_without_prompt(self, fake_cli):
+        s = CliSession(fake_cli, ensure_path=False, ready_timeout=5)
+        try:
+            ret, out, _ = s.run("abc", timeout=5)
+            assert ret == 0 and out == "out:abc\nline2"
+            assert s.stats()["prompt"] is None
+        finally:
+            s.close()
+
+    def test_quiet_mode_waits_for_slow_output(self, fake_cli):
+        s = CliSession(fake_cli, ensure_path=False, ready_timeout=5)
+        try:
+            ret, out, _ = s.run("slow 1.0", timeout=5)
+            assert ret == 0 and out == "done:slow 1.0\nline2"
+            ret, out, _ = s.run("abc", timeout=5)
+            assert out == "out:abc\nline2"
+        finally:
+            s.close()
+
+    def test_quiet_mode_no_output_is_timeout(self, fake_cli):
+        s = CliSession(fake_cli, ensure_path=False, ready_timeout=5)
+        try:
+            ret, out, err = s.run("slow 3", timeout=0.8)
+            assert (ret, out, err) == (-1, "", "Timeout")
+        finally:
+            s.close()
+
+    def test_not_ready_backs_off(self, tmp_path):
+        s = CliSession(f"{sys.executable} -c 'print(1)'", ensure_path=False, ready_timeout=1)
+        ret, _, err = s.run("x")
+        assert ret == -1 and err
+        ret, _, err = s.run("x")
+        assert ret == -1 and "后重试" in err
+        assert s.starts == 1
+        s.close()
+
+
+def test_run_cli_command_routes_by_config(fake_cli, monkeypatch):
+    monkeypatch.setattr(cli_session, "run_command", lambda cmd, shell, timeout: (0, f"shell:{cmd}", ""))
+    assert run_cli_command("show x") == (0, "shell:show x", "")
+
+    config = {"command": f"{fake_cli} 'cli>'", "ready_keyword": "succeed"}
+    try:
+        ret, out, _ = run_cli_command("show x", config, timeout=5)
+        assert ret == 0 and out == "out:show x\nline2"
+        assert cli_session.session_for(config).commands == 1
+    finally:
+        cli_session.close_all_sessions()
+
+
+def test_sessions_keyed_by_options():
+    try:
+        a = cli_session.get_cli_session("os_cli", ready_keywords=["succeed"], ready_timeout=10)
+        b = cli_session.get_cli_session("os_cli", ready_timeout=10, ready_keywords=["succeed"])
+        c = cli_session.get_cli_session("os_cli", ready_keywords=["ok"], ready_timeout=30)
+        assert a is b
+        assert c is not a
+        assert (c.ready_keywords, c.ready_timeout) == (["ok"], 30)
+    finally:
+        cli_session.close_all_sessions()
@@ -0,0 +1,167 @@
+"""Tests for utils/counters.py — persistent-fd sysfs/procfs counter reader."""
+import os
+import re
+
+from agent.utils.counters import (
+    DISKSTATS, FILE_NR, CounterReader, parse_int, parse_text,
+)
+
+
+class TestCounterReader:
+    def test_reuses_open_fd(self, tmp_path):
+        f = tmp_path / "rx_bytes"
+        f.write_text("100\n")
+        reader = CounterReader()
+        try:
+            assert parse_int(reader.read(str(f))) == 100
+            assert parse_int(reader.read(str(f))) == 100
+            assert reader.opens == 1
+            assert reader.reads == 2
+        finally:
+            reader.close()
+
+    def test_pread_sees_rewritten_content(self, tmp_path):
+        f = tmp_path / "temp"
+        f.write_text("41000\n")
+        reader = CounterReader()
+        try:
+            assert parse_int(reader.read(str(f))) == 41000
+            # 原地改写（同一 inode），模拟内核重新生成属性内容
+            with open(f, "r+") as fh:
+                fh.write("52000\n")
+            assert parse_int(reader.read(str(f))) == 52000
+            assert reader.opens == 1
+        finally:
+            reader.close()
+
+    def test_missing_file_returns_none(self, tmp_path):
+        reader = CounterReader()
+        assert reader.read(str(tmp_path / "nope")) is None
+        assert reader.open_count() == 0
+
+    def test_large_file_grows_buffer(self, tmp_path):
+        f = tmp_path / "diskstats"
+        content = b"x" * 10000
+        f.write_bytes(content)
+        reader = CounterReader()
+        try:
+            assert reader.read(str(f)) == content
+            assert reader.read(str(f)) == content
+        finally:
+            reader.close()
+
+    def test_short_reads_continue_to_eof(self, tmp_path, monkeypatch):
+        f = tmp_path / "diskstats"
+        content = b"".join(b"   8 %4d sd%d 1 0 2 0 3 0 4 0 0 5 0\n" % (i, i) for i in range(300))
+        f.write_bytes(content)
+        real_pread = os.pread
+        calls = []
+
+        # 模拟 seq_file：无论请求多大，每次最多返回 100 字节
+        def short_pread(fd, size, offset):
+            calls.append(offset)
+            return real_pread(fd, min(size, 100), offset)
+
+        monkeypatch.setattr("agent.utils.counters.os.pread", short_pread)
+        reader = CounterReader()
+        try:
+            data = reader.read(str(f))
+        finally:
+            reader.close()
+        assert data == content
+        assert len(DISKSTATS.parse(data)) == 300
+        assert calls[-1] == len(content)
+
+    def test_lru_cap(self, tmp_path):
+        reader = CounterReader(max_open=3)
+        try:
+            paths = []
+            for i in range(5):
+                p = tmp_path / f"c{i}"
+                p.write_text(str(i))
+                paths.append(str(p))
+            values = reader.read_many(paths)
+            assert [parse_int(values[p]) for p in paths] == [0, 1, 2, 3, 4]
+            assert reader.open_count() == 3
+            # 最近使用的仍命中，最早的需要重新打开
+            reader.read(paths[4])
+            assert reader.opens == 5
+            reader.read(paths[0])
+            assert reader.opens == 6
+        finally:
+            reader.close()
+        assert reader.open_count() == 0
+
+    def test_eviction_waits_for_inflight_read(self, tmp_path):
+        a, b = tmp_path / "a", tmp_path / "b"
+        a.write_text("1\n")
+        b.write_text("2\n")
+        reader = CounterReader(max_open=1)
+        # 模拟另一线程正在 pread a 时 a 被 LRU 淘汰
+        entry = reader._acquire(str(a))
+        assert parse_int(reader.read(str(b))) == 2
+        assert reader.open_count() == 1
+        assert parse_int(os.pread(entry.fd, 16, 0)) == 1
+        reader._release(entry)
+        try:
+            os.fstat(entry.fd)
+            still_open = True
+        except OSError:
+            still_open = False
+        reader.close()
+        assert still_open is False
+
+    def test_close_releases_fds(self, tmp_path):
+        f = tmp_path / "speed"
+        f.write_text("25000\n")
+        reader = CounterReader()
+        reader.read(str(f))
+        reader.close()
+        assert reader.open_count() == 0
+        assert parse_text(reader.read(str(f))) == "25000"
+        reader.close()
+
+
+class TestSchemas:
+    def test_diskstats(self):
+        data = (
+            b"   8       0 sda 100 0 2000 0 50 0 800 0 0 300 0 0 0 0 0\n"
+            b"   8       1 sda1 10 0 200 0 5 0 80 0 0 30 0\n"
+            b"   7       0 loop0 1 0 2 0 0 0 0 0 0 0 0 0\n"
+            b"   short line\n"
+        )
+        rows = DISKSTATS.parse(data, re.compile(r"^(sd[a-z]+)$"))
+        assert list(rows) == ["sda"]
+        assert rows["sda"] == {
+            "reads": 100, "read_sectors": 2000, "writes": 50,
+            "write_sectors": 800, "io_time_ms": 300,
+        }
+        assert set(DISKSTATS.parse(data)) == {"sda", "sda1", "loop0"}
+
+    def test_file_nr(self):
+        assert FILE_NR.parse(b"1024\t0\t9223372036854775807\n") == {
+            "allocated": 1024, "free": 0, "max": 9223372036854775807,
+        }
+        assert FILE_NR.parse(b"1 2") is None
+        assert FILE_NR.parse(None) is None
+
+    def test_parse_int(self):
+        assert parse_int(b"42\n") == 42
+        assert parse_int(b"-1\n") == -1
+        assert parse_int(b"") is None
+        assert parse_int(b"unknown") is None
+        assert parse_int(None) is None
+
+
+def test_reads_real_procfs():
+    if not os.path.exists("/proc/sys/fs/file-nr"):
+        return
+    reader = CounterReader()
+    try:
+        first = FILE_NR.parse(reader.read("/proc/sys/fs/file-nr"))
+        second = FILE_NR.parse(reader.read("/proc/sys/fs/file-nr"))
+        assert first is not None and second is not None
+        assert first["max"] == second["max"]
+        assert reader.opens == 1
+    finally:
+        reader.close()
@@ -115,6 +115,17 @@ class TestTailFile:
         finally:
             os.unlink(fname)
 
+    def test_with_inode_reports_file_read(self):
+        with tempfile.NamedTemporaryFile(mode="w", suffix=".log", delete=False) as f:
+            f.write("a\n")
+            fname = f.name
+        try:
+            lines, pos, inode = tail_file(fname, with_inode=True)
+            assert (lines, pos, inode) == (["a"], 2, os.stat(fname).st_ino)
+            assert tail_file(fname + ".missing", with_inode=True) == ([], 0, None)
+        finally:
+            os.unlink(fname)
+
 
 class TestParseKeyValue:
     def test_basic(self):
@@ -0,0 +1,242 @@
+"""Tests for utils/netlink.py — netlink link monitor and its observers.
+
+Kernel messages are stood in for by crafted RTM_NEWLINK / RTM_DELLINK packets
+for a dummy interface; when the sandbox allows it, one test also drives a
+real veth pair.
+"""
+import errno
+import shutil
+import socket
+import struct
+import subprocess
+import threading
+import time
+from unittest.mock import patch
+
+import pytest
+
+from agent.utils import netlink
+from agent.utils.netlink import LinkMonitor, parse_messages
+
+
+def _attr(rta_type, payload):
+    length = 4 + len(payload)
+    return struct.pack("=HH", length, rta_type) + payload + b"\0" * ((4 - length % 4) % 4)
+
+
+def link_msg(name, carrier, operstate=None, msg_type=netlink.RTM_NEWLINK, index=7, master=None):
+    flags = 0x1 | (netlink.IFF_LOWER_UP if carrier else 0)
+    operstate = (6 if carrier else 2) if operstate is None else operstate
+    attrs = _attr(netlink.IFLA_IFNAME, name.encode() + b"\0")
+    attrs += _attr(netlink.IFLA_OPERSTATE, bytes([operstate]))
+    attrs += _attr(netlink.IFLA_CARRIER, bytes([1 if carrier else 0]))
+    if master is not None:
+        attrs += _attr(netlink.IFLA_MASTER, struct.pack("=I", master))
+    body = netlink.IFINFOMSG.pack(0, 1, index, flags, 0) + attrs
+    return netlink.NLMSG_HDR.pack(16 + len(body), msg_type, 0, 0, 0) + body
+
+
+@pytest.fixture
+def sysfs(tmp_path):
+    def set_speed(port, speed):
+        d = tmp_path / port
+        d.mkdir(exist_ok=True)
+        (d / "speed").write_text(str(speed))
+        (d / "duplex").write_text("full")
+    set_speed.root = tmp_path
+    return set_speed
+
+
+@pytest.fixture
+def monitor(sysfs):
+    return LinkMonitor(sysfs_root=str(sysfs.root))
+
+
+class TestParse:
+    def test_parse_multiple_messages(self):
+        data = link_msg("dummy0", True) + link_msg("dummy1", False, master=3)
+        msgs = parse_messages(data)
+        assert [m[1]["ifname"] for m in msgs] == ["dummy0", "dummy1"]
+        assert msgs[0][1]["carrier"] == 1 and msgs[0][1]["operstate"] == "up"
+        assert msgs[1][1]["operstate"] == "down" and msgs[1][1]["master"] == 3
+
+    def test_truncated_packet_ignored(self):
+        assert parse_messages(link_msg("dummy0", True)[:10]) == []
+
+
+class TestLinkMonitor:
+    def test_flap_recorded_with_timestamps(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True), now=1000.0)
+        monitor.handle(link_msg("dummy0", False), now=1000.2)
+        monitor.handle(link_msg("dummy0", True), now=1000.4)
+        events, seq = monitor.events_since(0)
+        assert [(e["kind"], e["state"]["carrier"]) for e in events] == [
+            ("new", "1"), ("change", "0"), ("change", "1"),
+        ]
+        assert events[1]["state"]["timestamp"] != events[2]["state"]["timestamp"]
+        assert seq == 3
+
+    def test_unrelated_newlink_ignored(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True))
+        monitor.handle(link_msg("dummy0", True))  # e.g. MTU change
+        assert monitor.seq == 1
+
+    def test_speed_drop_while_up_recorded(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True))
+        sysfs("dummy0", 10000)
+        monitor.handle(link_msg("dummy0", True))  # renegotiated, carrier unchanged
+        events, _ = monitor.events_since(1)
+        assert [(e["kind"], e["state"]["speed"]) for e in events] == [("change", "10000")]
+
+    def test_dellink_records_removal(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True))
+        monitor.handle(link_msg("dummy0", True, msg_type=netlink.RTM_DELLINK))
+        events, _ = monitor.events_since(1)
+        assert events[0]["kind"] == "removed"
+        assert monitor.snapshot() == {}
+
+
+class _FakeSock(object):
+    """recv 依次抛出给定错误，之后一直超时"""
+
+    def __init__(self, errors=()):
+        self.errors = list(errors)
+        self.sent = []
+        self.closed = False
+
+    def recv(self, size):
+        if self.errors:
+            raise self.errors.pop(0)
+        time.sleep(0.01)
+        raise socket.timeout()
+
+    def send(self, data):
+        self.sent.append(data)
+
+    def close(self):
+        self.closed = True
+
+
+def _run_listener(monitor, sock):
+    monitor._sock = sock
+    monitor._running = True
+    monitor._thread = threading.Thread(target=monitor._run, daemon=True)
+    monitor._thread.start()
+
+
+class TestListenerFailure:
+    def test_recv_error_reopens_socket(self, monitor):
+        broken, fresh = _FakeSock([OSError(errno.EIO, "io")]), _FakeSock()
+        with patch.object(LinkMonitor, "_open_socket", return_value=fresh):
+            _run_listener(monitor, broken)
+            deadline = time.time() + 2
+            while not fresh.sent and time.time() < deadline:
+                time.sleep(0.01)
+            try:
+                assert fresh.sent  # 重建后请求全量同步
+                assert broken.closed
+                assert monitor.is_alive()
+            finally:
+                monitor.stop()
+
+    def test_dead_listener_falls_back_to_polling(self, monitor, monkeypatch):
+        with patch.object(LinkMonitor, "_open_socket", side_effect=OSError(errno.EMFILE, "fds")):
+            _run_listener(monitor, _FakeSock([OSError(errno.EIO, "io")]))
+            monitor._thread.join(timeout=2)
+        assert monitor.is_alive() is False
+
+        monkeypatch.setattr(netlink, "_monitor", monitor)
+        monkeypatch.setattr(netlink, "_monitor_failed", False)
+        assert netlink.get_link_monitor() is None
+        assert netlink.get_link_monitor() is None
+
+
+class TestLinkStatusWithNetlink:
+    def _observer(self, **config):
+        from agent.observers.link_status import LinkStatusObserver
+        return LinkStatusObserver("link_status", config)
+
+    def test_flap_within_interval_reported(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True))
+        with patch("agent.observers.link_status.get_link_monitor", return_value=monitor):
+            obs = self._observer()
+            assert obs.check().has_alert is False
+            monitor.handle(link_msg("dummy0", False))
+            monitor.handle(link_msg("dummy0", True))
+            result = obs.check()
+        assert result.has_alert is True
+        changes = [c["change"] for c in result.details["changes"]]
+        assert changes[0] == "dummy0 link DOWN"
+        assert "dummy0 link UP" in changes
+        assert result.details["source"] == "netlink"
+
+    def test_whitelist_and_slaves_skipped(self, monitor, sysfs):
+        sysfs("dummy0", 25000)
+        sysfs("dummy1", 25000)
+        monitor.handle(link_msg("dummy0", True) + link_msg("dummy1", True, master=9))
+        with patch("agent.observers.link_status.get_link_monitor", return_value=monitor):
+            obs = self._observer(whitelist=["dummy0"])
+            obs.check()
+            monitor.handle(link_msg("dummy0", False) + link_msg("dummy1", False, master=9))
+            assert obs.check().has_alert is False
+
+    def test_falls_back_to_polling(self):
+        from agent.observers.link_status import LinkStatusObserver
+        with patch("agent.observers.link_status.get_link_monitor", return_value=None), \
+                patch.object(LinkStatusObserver, "_check_polling") as polling:
+            LinkStatusObserver("link_status", {}).check()
+        polling.assert_called_once()
+
+
+class TestPortSpeedWithNetlink:
+    def test_speed_change_across_flap(self, monitor, sysfs):
+        from agent.observers.port_speed import PortSpeedObserver
+        sysfs("dummy0", 25000)
+        monitor.handle(link_msg("dummy0", True))
+        with patch("agent.observers.port_speed.get_link_monitor", return_value=monitor):
+            obs = PortSpeedObserver("port_speed", {})
+            assert obs.check().has_alert is False
+            sysfs("dummy0", -1)
+            monitor.handle(link_msg("dummy0", False))
+            sysfs("dummy0", 10000)
+            monitor.handle(link_msg("dummy0", True))
+            result = obs.check()
+        assert result.has_alert is True
+        change = result.details["changes"][0]
+        assert (change["old_speed"], change["new_speed"]) == ("25000Mb/s", "10000Mb/s")
+
+
+def _ip(*args):
+    return subprocess.run(["ip", "link"] + list(args), capture_output=True).returncode == 0
+
+
+@pytest.mark.skipif(shutil.which("ip") is None, reason="iproute2 not installed")
+def test_real_veth_pair_transitions():
+    if not _ip("add", "obsnl0", "type", "veth", "peer", "name", "obsnl1"):
+        pytest.skip("cannot create veth pair (needs CAP_NET_ADMIN)")
+    monitor = LinkMonitor()
+    try:
+        if not monitor.start():
+            pytest.skip("netlink unavailable")
+        _ip("set", "obsnl1", "up")
+        _ip("set", "obsnl0", "up")
+        _ip("set", "obsnl1", "down")
+        _ip("set", "obsnl1", "up")
+
+        deadline = time.time() + 3
+        carriers = []
+        while time.time() < deadline:
+            events, _ = monitor.events_since(0)
+            carriers = [e["state"]["carrier"] for e in events if e["port"] == "obsnl0"]
+            if carriers[-3:] == ["1", "0", "1"]:
+                break
+            time.sleep(0.05)
+        assert carriers[-3:] == ["1", "0", "1"]
+    finally:
+        monitor.stop()
+        _ip("del", "obsnl0")
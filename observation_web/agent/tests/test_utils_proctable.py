@@ -0,0 +1,68 @@
+"""Tests for utils/proctable.py — shared /proc process table snapshot."""
+import os
+
+import pytest
+
+from agent.utils import proctable
+from agent.utils.proctable import ProcessTable
+
+
+def _make_proc(root, pid, comm, state, ppid, cmdline=b""):
+    d = root / str(pid)
+    d.mkdir()
+    (d / "stat").write_text(f"{pid} ({comm}) {state} {ppid} 1 1 0 -1 4194560 100 0 0 0\n")
+    (d / "cmdline").write_bytes(cmdline)
+
+
+@pytest.fixture
+def fake_proc(tmp_path):
+    _make_proc(tmp_path, 1, "systemd", "S", 0, b"/sbin/init\0")
+    _make_proc(tmp_path, 100, "app_data", "S", 1, b"/opt/bin/app_data\0-v\0003\0")
+    _make_proc(tmp_path, 101, "worker (x)", "S", 100, b"worker\0")
+    _make_proc(tmp_path, 102, "defunct_child", "Z", 100)
+    (tmp_path / "self").mkdir()
+    (tmp_path / "meminfo").write_text("")
+    return tmp_path
+
+
+class TestProcessTable:
+    def test_scan_indexes(self, fake_proc):
+        table = ProcessTable.scan(str(fake_proc))
+        assert len(table) == 4
+        assert table.get(100).cmdline == "/opt/bin/app_data -v 3"
+        assert {p.pid for p in table.children(100)} == {101, 102}
+        assert table.by_name("worker (x)")[0].pid == 101
+        assert [p.pid for p in table.zombies()] == [102]
+
+    def test_zombie_command_uses_comm(self, fake_proc):
+        table = ProcessTable.scan(str(fake_proc))
+        assert table.get(102).command == "[defunct_child]"
+
+    def test_search_matches_cmdline_case_insensitive(self, fake_proc):
+        table = ProcessTable.scan(str(fake_proc))
+        assert [p.pid for p in table.search("APP_DATA")] == [100]
+        assert table.search("(unbalanced") == []
+
+    def test_snapshot_shared_within_tick(self, fake_proc, monkeypatch):
+        scans = []
+        real_scan = ProcessTable.scan.__func__
+
+        def counting_scan(cls, proc_root=None):
+            scans.append(proc_root)
+            return real_scan(cls, str(fake_proc))
+
+        monkeypatch.setattr(ProcessTable, "scan", classmethod(counting_scan))
+        proctable.new_tick()
+        first = proctable.get_process_table()
+        assert proctable.get_process_table() is first
+        assert len(scans) == 1
+
+        proctable.new_tick()
+        assert proctable.get_process_table() is not first
+        assert len(scans) == 2
+
+    def test_real_proc_contains_self(self):
+        if not os.path.isdir("/proc/self"):
+            pytest.skip("no /proc")
+        table = ProcessTable.scan()
+        assert table.get(os.getpid()) is not None
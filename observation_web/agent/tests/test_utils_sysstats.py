@@ -0,0 +1,104 @@
+"""Tests for utils/sysstats.py — shared /proc/stat, meminfo, loadavg snapshot."""
+from agent.utils import sysstats
+from agent.utils.counters import CounterReader
+from agent.utils.sysstats import (
+    SystemStats, parse_loadavg, parse_meminfo, parse_stat,
+)
+
+STAT = (
+    b"cpu  400 0 100 1400 100 0 0 0 0 0\n"
+    b"cpu0 300 0 50 600 50 0 0 0 0 0\n"
+    b"cpu1 100 0 50 800 50 0 0 0 0 0\n"
+    b"intr 12345 0 0\n"
+    b"ctxt 999\n"
+)
+
+MEMINFO = (
+    b"MemTotal:       16000000 kB\n"
+    b"MemFree:         4000000 kB\n"
+    b"MemAvailable:    9000000 kB\n"
+    b"Buffers:          500000 kB\n"
+    b"Cached:          3000000 kB\n"
+    b"SwapCached:            0 kB\n"
+    b"SwapTotal:       2000000 kB\n"
+    b"SwapFree:        1500000 kB\n"
+    b"SReclaimable:     500000 kB\n"
+    b"HugePages_Total:       0\n"
+)
+
+
+def _proc(tmp_path, stat=STAT, meminfo=MEMINFO, loadavg=b"0.50 1.00 1.50 2/300 4242\n"):
+    (tmp_path / "stat").write_bytes(stat)
+    (tmp_path / "meminfo").write_bytes(meminfo)
+    (tmp_path / "loadavg").write_bytes(loadavg)
+    return tmp_path
+
+
+class TestParsers:
+    def test_parse_stat_per_core(self):
+        cpus = parse_stat(STAT)
+        assert set(cpus) == {"cpu", "cpu0", "cpu1"}
+        assert cpus["cpu0"].total == 1000
+        assert cpus["cpu0"].idle == 650
+
+    def test_parse_meminfo(self):
+        info = parse_meminfo(MEMINFO)
+        assert info["MemTotal"] == 16000000
+        assert info["SwapFree"] == 1500000
+        assert info["HugePages_Total"] == 0
+
+    def test_parse_loadavg(self):
+        assert parse_loadavg(b"0.50 1.00 1.50 2/300 4242\n") == (0.5, 1.0, 1.5)
+        assert parse_loadavg(b"") is None
+
+
+class TestSystemStats:
+    def test_read_and_per_core_usage(self, tmp_path):
+        proc = _proc(tmp_path)
+        reader = CounterReader()
+        try:
+            first = SystemStats.read(str(proc), reader)
+            (proc / "stat").write_bytes(
+                b"cpu  500 0 150 1450 100 0 0 0 0 0\n"
+                b"cpu0 390 0 60 610 50 0 0 0 0 0\n"
+                b"cpu1 150 0 50 850 50 0 0 0 0 0\n"
+            )
+            second = SystemStats.read(str(proc), reader)
+        finally:
+            reader.close()
+
+        usage = second.cpu_usage(first)
+        assert usage["cpu0"] == 100.0 * 100 / 110
+        assert usage["cpu1"] == 50.0
+        assert second.cores == ["cpu0", "cpu1"]
+        assert second.cpu_usage(None) == {}
+
+    def test_mem_used_matches_free(self, tmp_path):
+        stats = SystemStats.read(str(_proc(tmp_path)), CounterReader())
+        # total - free - buffers - cached - sreclaimable
+        assert stats.mem_used_kb == 8000000
+        assert stats.mem_total_kb == 16000000
+        assert stats.loadavg == (0.5, 1.0, 1.5)
+
+
+def test_snapshot_shared_within_tick(monkeypatch, tmp_path):
+    proc = _proc(tmp_path)
+    reads = []
+    real_read = SystemStats.read.__func__
+
+    def fake_read(cls, proc_root=None, reader=None):
+        reads.append(1)
+        return real_read(cls, str(proc), CounterReader())
+
+    monkeypatch.setattr(SystemStats, "read", classmethod(fake_read))
+    monkeypatch.setattr(sysstats, "_snapshot", None)
+    monkeypatch.setattr(sysstats, "_tick", 0)
+    monkeypatch.setattr(sysstats, "_snapshot_tick", -1)
+
+    sysstats.new_tick()
+    a = sysstats.get_system_stats()
+    b = sysstats.get_system_stats()
+    assert a is b and len(reads) == 1
+    sysstats.new_tick()
+    assert sysstats.get_system_stats() is not a
+    assert len(reads) == 2
@@ -0,0 +1,36 @@
+"""Tests for utils/trend.py — sliding-window linear regression."""
+from agent.utils.trend import TrendWindow, linear_fit
+
+
+def test_perfect_line():
+    fit = linear_fit([(0, 100), (3600, 110), (7200, 120)])
+    assert abs(fit.slope * 3600 - 10) < 1e-9
+    assert abs(fit.r2 - 1.0) < 1e-9
+    assert fit.span == 7200
+
+
+def test_flat_and_degenerate():
+    fit = linear_fit([(0, 5), (10, 5), (20, 5)])
+    assert fit.slope == 0 and fit.r2 == 1.0
+    assert linear_fit([(0, 1)]) is None
+    assert linear_fit([(5, 1), (5, 2)]) is None
+
+
+def test_noise_has_low_r2():
+    fit = linear_fit([(0, 100), (1, 140), (2, 90), (3, 150), (4, 95), (5, 120)])
+    assert fit.r2 < 0.3
+
+
+def test_large_timestamps_keep_precision():
+    t0 = 1.8e9
+    fit = linear_fit([(t0 + i * 5400, 1000 + i * 7.5) for i in range(8)])
+    assert abs(fit.slope * 5400 - 7.5) < 1e-6
+    assert fit.r2 > 0.999999
+
+
+def test_window_slides():
+    window = TrendWindow(3)
+    for i, v in enumerate([1, 2, 3, 10]):
+        window.add(i, v)
+    assert len(window) == 3
+    assert window.values() == [2, 3, 10]
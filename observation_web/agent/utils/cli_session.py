@@ -0,0 +1,442 @@
+"""
+常驻 CLI 会话
+
+os_cli 等阵列 CLI 启动并登录需要数秒，观察点每个周期重新拉起进程代价很高。
+CliSession 通过伪终端（pty）保持一个长期存活的 CLI 进程：
+- 启动后等待就绪关键字（succeed / success），随后学习提示符；
+- 命令按 FIFO 排队串行执行，以提示符重新出现判定命令结束；
+  CLI 不输出提示符时退化为：等到命令有输出后，再按输出静默时长判定；
+- 空闲超过 health_interval 时先发送空行做健康检查；
+- 进程退出、命令超时或健康检查失败时关闭会话，下次调用自动重启（失败退避）。
+
+启动命令与会话选项都相同的会话由 get_cli_session() 全局共享；run_cli_command()
+按观察点配置选择走常驻会话或一次性 run_command。
+"""
+
+import logging
+import os
+import re
+import select
+import signal
+import subprocess
+import threading
+import time
+from typing import Any, Dict, List, Optional, Sequence, Tuple, Union
+
+from .helpers import _ENV_PATH_PREFIX, run_command
+
+logger = logging.getLogger(__name__)
+
+try:
+    import pty
+    import termios
+except ImportError:  # 非 POSIX 平台
+    pty = None
+    termios = None
+
+DEFAULT_READY_KEYWORDS = ('succeed', 'success')
+
+# 就绪后输出静默多久视为提示符已打印完整（秒）
+PROMPT_SETTLE = 0.3
+
+# 无提示符模式下，命令开始输出后静默多久视为结束（秒）
+QUIET_SETTLE = 0.5
+
+# 常见提示符结尾：admin:/>、[root@host ~]#、$、%
+PROMPT_HINT = re.compile(r'[>#$%]\s*$')
+
+# 重启失败退避上限（秒）
+MAX_RESTART_BACKOFF = 60
+
+_ANSI_ESCAPE = re.compile(r'\x1b\[[0-9;?]*[A-Za-z]|\x1b\][^\x07]*\x07')
+
+
+def _clean(text):
+    # type: (str) -> str
+    return _ANSI_ESCAPE.sub('', text).replace('\r', '')
+
+
+class CliSession(object):
+    """
+    pty 驱动的常驻 CLI 会话
+
+    Args:
+        command: 启动 CLI 的 shell 命令（如 os_cli）
+        ready_keywords: 就绪关键字（忽略大小写），为空则启动即就绪
+        prompt: 提示符正则；为空时从就绪后的最后一行自动学习
+        ready_timeout: 等待就绪的超时（秒）
+        health_interval: 空闲超过该时长后执行命令前先做健康检查（秒）
+        ensure_path: 启动命令前补充 PATH（同 run_command）
+        exit_command: 关闭会话时发送的退出命令
+    """
+
+    def __init__(self, command, ready_keywords=DEFAULT_READY_KEYWORDS, prompt=None,
+                 ready_timeout=10, health_interval=60, ensure_path=True, exit_command='exit'):
+        # type: (str, Sequence[str], Optional[str], float, float, bool, str) -> None
+        self.command = command
+        self.ready_keywords = [k.lower() for k in ready_keywords if k]
+        self.ready_timeout = ready_timeout
+        self.health_interval = health_interval
+        self.ensure_path = ensure_path
+        self.exit_command = exit_command
+
+        self._prompt_re = re.compile(prompt) if prompt else None
+        self._learned_prompt = None  # type: Optional[str]
+
+        self._proc = None  # type: Optional[subprocess.Popen]
+        self._fd = None  # type: Optional[int]
+        self._last_used = 0.0
+        self._failures = 0
+        self._next_start_at = 0.0
+
+        # FIFO 排队：按取号顺序依次执行
+        self._cond = threading.Condition()
+        self._next_ticket = 0
+        self._serving = 0
+
+        self.starts = 0
+        self.commands = 0
+        # 最近一条命令的执行耗时（不含会话启动），供响应时间类观察点使用
+        self.last_command_seconds = 0.0
+
+    # ---------- 生命周期 ----------
+
+    @property
+    def alive(self):
+        # type: () -> bool
+        return self._proc is not None and self._proc.poll() is None
+
+    def _spawn(self):
+        # type: () -> Tuple[bool, str]
+        """启动 CLI 并等待就绪，返回 (是否成功, 启动输出或错误)"""
+        if pty is None:
+            return False, "当前平台不支持 pty"
+
+        cmd = self.command
+        if self.ensure_path:
+            cmd = _ENV_PATH_PREFIX + cmd
+
+        master, slave = pty.openpty()
+        # 关闭回显，输出中不混入发送的命令
+        attrs = termios.tcgetattr(slave)
+        attrs[3] &= ~termios.ECHO
+        termios.tcsetattr(slave, termios.TCSANOW, attrs)
+        try:
+            proc = subprocess.Popen(
+                cmd, shell=True,
+                stdin=slave, stdout=slave, stderr=slave,
+                start_new_session=True, close_fds=True,
+            )
+        except OSError as e:
+            os.close(master)
+            return False, f"启动失败: {e}"
+        finally:
+            os.close(slave)
+
+        self._proc, self._fd = proc, master
+        self.starts += 1
+
+        if self.ready_keywords:
+            ok, output = self._read_until(
+                lambda buf: any(k in buf.lower() for k in self.ready_keywords),
+                self.ready_timeout,
+            )
+            if not ok:
+                self.close()
+                return False, output or "未检测到就绪关键字"
+        else:
+            output = ''
+
+        # 提示符通常紧随就绪信息输出：等待静默后取最后一行
+        _, tail = self._read_quiet(PROMPT_SETTLE, self.ready_timeout)
+        output += tail
+        if self._prompt_re is None:
+            last_line = _clean(output).rstrip('\n').rsplit('\n', 1)[-1]
+            if last_line.strip() and PROMPT_HINT.search(last_line):
+                self._learned_prompt = last_line.strip()
+        logger.info(
+            f"[CliSession] {self.command} 已就绪 (pid={proc.pid}, "
+            f"提示符={self._prompt_re.pattern if self._prompt_re else self._learned_prompt!r})"
+        )
+        return True, output
+
+    def close(self):
+        """关闭会话（尽量优雅退出，随后强制结束进程组）"""
+        proc, fd = self._proc, self._fd
+        self._proc, self._fd = None, None
+        self._learned_prompt = None
+        if proc is not None and proc.poll() is None:
+            try:
+                if fd is not None and self.exit_command:
+                    os.write(fd, (self.exit_command + '\n').encode())
+                proc.wait(timeout=1)
+            except (OSError, subprocess.TimeoutExpired):
+                try:
+                    os.killpg(proc.pid, signal.SIGKILL)
+                except OSError:
+                    pass
+                try:
+                    proc.wait(timeout=2)
+                except subprocess.TimeoutExpired:
+                    pass
+        if fd is not None:
+            try:
+                os.close(fd)
+            except OSError:
+                pass
+
+    def _ensure_started(self):
+        # type: () -> Optional[str]
+        """确保会话可用，返回错误信息或 None"""
+        if self.alive:
+            if time.time() - self._last_used >= self.health_interval and not self._health_check():
+                logger.warning(f"[CliSession] {self.command} 健康检查失败，重启会话")
+                self.close()
+            else:
+                return None
+        elif self._proc is not None:
+            logger.warning(f"[CliSession] {self.command} 进程已退出，重启会话")
+            self.close()
+
+        now = time.time()
+        if now < self._next_start_at:
+            return f"会话启动失败，{self._next_start_at - now:.0f}s 后重试"
+        ok, output = self._spawn()
+        if not ok:
+            self._failures += 1
+            self._next_start_at = now + min(MAX_RESTART_BACKOFF, 2 ** self._failures)
+            return _clean(output)[-500:]
+        self._failures = 0
+        self._last_used = time.time()
+        return None
+
+    def _health_check(self):
+        # type: () -> bool
+        """发送空行，确认 CLI 仍在响应"""
+        if not self._has_prompt():
+            return self.alive
+        self._drain()
+        ok, _ = self._exchange('', min(5.0, self.ready_timeout))
+        return ok
+
+    # ---------- 读写 ----------
+
+    def _read_until(self, predicate, timeout):
+        # type: (Any, float) -> Tuple[bool, str]
+        """读取输出直到 predicate(已读内容) 为真或超时/EOF"""
+        chunks = []  # type: List[str]
+        deadline = time.time() + timeout
+        while True:
+            if predicate(''.join(chunks)):
+                return True, ''.join(chunks)
+            remaining = deadline - time.time()
+            if remaining <= 0:
+                return False, ''.join(chunks)
+            chunk = self._read_chunk(remaining)
+            if chunk is None:
+                return False, ''.join(chunks)
+            chunks.append(chunk)
+
+    def _read_quiet(self, settle, timeout):
+        # type: (float, float) -> Tuple[bool, str]
+        """读取输出直到静默 settle 秒，返回 (是否静默结束, 内容)"""
+        chunks = []  # type: List[str]
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            chunk = self._read_chunk(min(settle, max(0.0, deadline - time.time())))
+            if chunk is None:
+                return False, ''.join(chunks)
+            if chunk == '':
+                return True, ''.join(chunks)
+            chunks.append(chunk)
+        return False, ''.join(chunks)
+
+    def _read_chunk(self, wait):
+        # type: (float) -> Optional[str]
+        """等待最多 wait 秒读取一块输出；无输出返回 ''，EOF/出错返回 None"""
+        fd = self._fd
+        if fd is None:
+            return None
+        try:
+            readable, _, _ = select.select([fd], [], [], wait)
+            if not readable:
+                return ''
+            data = os.read(fd, 65536)
+        except OSError:
+            return None  # 子进程退出后 pty 读取返回 EIO
+        if not data:
+            return None
+        return data.decode('utf-8', 'replace')
+
+    def _drain(self):
+        """丢弃上一条命令之后残留的输出"""
+        while self._read_chunk(0) not in ('', None):
+            pass
+
+    def _has_prompt(self):
+        # type: () -> bool
+        return self._prompt_re is not None or self._learned_prompt is not None
+
+    def _ends_with_prompt(self, buf):
+        # type: (str) -> bool
+        text = _clean(buf).rstrip()
+        if self._prompt_re is not None:
+            last_line = text.rsplit('\n', 1)[-1]
+            return bool(self._prompt_re.search(last_line))
+        return text.endswith(self._learned_prompt)
+
+    def _strip_prompt(self, text):
+        # type: (str) -> str
+        lines = text.rstrip().split('\n')
+        if lines and self._has_prompt() and self._ends_with_prompt(lines[-1]):
+            lines.pop()
+        return '\n'.join(lines).strip('\n')
+
+    def _exchange(self, command, timeout):
+        # type: (str, float) -> Tuple[bool, str]
+        try:
+            os.write(self._fd, (command + '\n').encode())
+        except OSError as e:
+            return False, f"写入命令失败: {e}"
+        if self._has_prompt():
+            return self._read_until(self._ends_with_prompt, timeout)
+        # 无提示符：输出出现前的静默只说明命令仍在执行，不能当作结束；
+        # 一直无输出则按超时处理，不把空结果当成功返回
+        deadline = time.time() + timeout
+        ok, head = self._read_until(lambda buf: _clean(buf).strip() != '', timeout)
+        if not ok:
+            return False, head
+        ok, tail = self._read_quiet(QUIET_SETTLE, max(0.0, deadline - time.time()))
+        return ok, head + tail
+
+    # ---------- 对外接口 ----------
+
+    def run(self, command, timeout=30):
+        # type: (str, float) -> Tuple[int, str, str]
+        """
+        在会话中执行一条命令
+
+        Returns:
+            (返回码, stdout, stderr)，与 run_command 一致；会话不可用或超时返回 -1
+        """
+        with self._cond:
+            ticket = self._next_ticket
+            self._next_ticket += 1
+            while ticket != self._serving:
+                self._cond.wait()
+        try:
+            error = self._ensure_started()
+            if error is not None:
+                return -1, '', error
+
+            self._drain()
+            started = time.time()
+            ok, output = self._exchange(command, timeout)
+            self.commands += 1
+            self._last_used = time.time()
+            self.last_command_seconds = self._last_used - started
+            output = self._strip_prompt(_clean(output))
+            if not ok:
+                # 会话状态未知（命令仍在执行或 CLI 已退出）：关闭，下次重启
+                logger.warning(f"[CliSession] {self.command} 执行 {command!r} 超时或中断，关闭会话")
+                self.close()
+                return -1, output, 'Timeout'
+            return 0, output, ''
+        finally:
+            with self._cond:
+                self._serving += 1
+                self._cond.notify_all()
+
+    def stats(self):
+        # type: () -> Dict[str, Any]
+        return {
+            'command': self.command,
+            'alive': self.alive,
+            'pid': self._proc.pid if self.alive else None,
+            'prompt': self._prompt_re.pattern if self._prompt_re else self._learned_prompt,
+            'starts': self.starts,
+            'commands': self.commands,
+            'queued': self._next_ticket - self._serving,
+        }
+
+
+_sessions = {}  # type: Dict[Tuple[str, Tuple[Tuple[str, Any], ...]], CliSession]
+_sessions_lock = threading.Lock()
+
+
+def _session_key(command, options):
+    # type: (str, Dict[str, Any]) -> Tuple[str, Tuple[Tuple[str, Any], ...]]
+    return command, tuple(sorted(
+        (name, tuple(value) if isinstance(value, list) else value)
+        for name, value in options.items()
+    ))
+
+
+def get_cli_session(command, **options):
+    # type: (str, Any) -> CliSession
+    """
+    获取（首次调用时创建）全局共享会话
+
+    按启动命令及选项区分：就绪关键字、超时等不同的调用方各用各的会话，
+    不会被先创建者的选项覆盖。
+    """
+    key = _session_key(command, options)
+    with _sessions_lock:
+        session = _sessions.get(key)
+        if session is None:
+            session = _sessions[key] = CliSession(command, **options)
+        return session
+
+
+def close_all_sessions():
+    """关闭全部常驻会话（调度器停止时调用）"""
+    with _sessions_lock:
+        sessions = list(_sessions.values())
+        _sessions.clear()
+    for session in sessions:
+        try:
+            session.close()
+        except Exception as e:
+            logger.error(f"[CliSession] 关闭 {session.command} 失败: {e}")
+
+
+def session_options(session_config):
+    # type: (Union[str, Dict[str, Any]]) -> Tuple[str, Dict[str, Any]]
+    """
+    解析观察点的 cli_session 配置
+
+    支持字符串（CLI 启动命令）或字典：
+    {"command": "os_cli", "ready_keyword": "succeed", "prompt": "...", "ready_timeout": 10}
+    """
+    if isinstance(session_config, str):
+        return session_config, {}
+    options = {}  # type: Dict[str, Any]
+    keyword = session_config.get('ready_keyword')
+    if keyword:
+        keywords = [keyword]
+        if keyword.lower() != 'success':
+            keywords.append('success')
+        options['ready_keywords'] = keywords
+    for key in ('prompt', 'ready_timeout', 'health_interval', 'exit_command'):
+        if key in session_config:
+            options[key] = session_config[key]
+    return session_config.get('command', 'os_cli'), options
+
+
+def session_for(session_config):
+    # type: (Union[str, Dict[str, Any]]) -> CliSession
+    """按 cli_session 配置获取共享会话"""
+    cli_command, options = session_options(session_config)
+    return get_cli_session(cli_command, **options)
+
+
+def run_cli_command(command, session_config=None, timeout=30):
+    # type: (str, Optional[Union[str, Dict[str, Any]]], float) -> Tuple[int, str, str]
+    """
+    执行阵列 CLI 查询命令
+
+    配置了 cli_session 时在常驻会话中执行，否则每次通过 shell 一次性执行。
+    """
+    if not session_config:
+        return run_command(command, shell=True, timeout=timeout)
+    return session_for(session_config).run(command, timeout=timeout)
@@ -0,0 +1,278 @@
+"""
+共享计数器读取层
+
+各观察点读取 sysfs / procfs 计数器时统一经由 CounterReader：
+- 文件描述符打开一次后长期保持，每次用 os.pread 从偏移 0 起读到 EOF，
+  内核会重新生成内容，省去反复 open/close 的路径解析开销；
+- read_many() 一次遍历读取一批文件；
+- 预编译的解析模式（Schema）把原始内容直接转换为数值，避免各观察点重复
+  split / 正则解析。
+
+接口/设备消失时（ENOENT、ENODEV 等）自动关闭并在下次读取时重新打开。
+"""
+
+import errno
+import logging
+import os
+import re
+import threading
+from collections import OrderedDict
+from typing import Any, Callable, Dict, Iterable, List, Optional, Pattern, Sequence, Tuple
+
+logger = logging.getLogger(__name__)
+
+# 单次 pread 的缓冲大小；sysfs 属性不超过一页。seq_file 实现的 procfs
+# 文件（/proc/diskstats、/proc/net/dev 等）每次最多返回约一页，
+# 不论缓冲多大，因此总是按偏移续读直到返回空
+READ_SIZE = 4096
+# 单个文件读取总量上限
+MAX_READ_SIZE = 1 << 20
+
+# 同时保持打开的文件数上限（LRU 淘汰）
+MAX_OPEN_FDS = 512
+
+# 需要关闭并重新打开的错误（设备/接口被移除或替换）
+_REOPEN_ERRNOS = {errno.ENOENT, errno.ENODEV, errno.ESTALE, errno.ENXIO}
+
+
+class _OpenFile(object):
+    """打开的文件描述符及正在使用它的读取数"""
+
+    __slots__ = ('fd', 'refs', 'detached')
+
+    def __init__(self, fd):
+        # type: (int) -> None
+        self.fd = fd
+        self.refs = 0
+        self.detached = False  # 已被淘汰/丢弃，最后一个读取结束时关闭
+
+
+class CounterReader(object):
+    """保持文件描述符打开、以 pread 读取计数器文件"""
+
+    def __init__(self, max_open=MAX_OPEN_FDS):
+        # type: (int) -> None
+        self.max_open = max_open
+        self._fds = OrderedDict()  # type: OrderedDict[str, _OpenFile]
+        # 采样线程与调度线程可能并发读取。fd 按引用计数关闭：淘汰时若另一线程
+        # 正在 pread 该 fd，由它读完后关闭，避免 EBADF 或读到复用该 fd 号的其他文件
+        self._lock = threading.Lock()
+        self.opens = 0
+        self.reads = 0
+
+    @staticmethod
+    def _close(fd):
+        # type: (int) -> None
+        try:
+            os.close(fd)
+        except OSError:
+            pass
+
+    @staticmethod
+    def _detach(entry):
+        # type: (_OpenFile) -> Optional[int]
+        """已从表中移除（持锁调用）：没有读取在用时返回需关闭的 fd"""
+        entry.detached = True
+        return entry.fd if entry.refs == 0 else None
+
+    def _acquire(self, path):
+        # type: (str) -> _OpenFile
+        with self._lock:
+            entry = self._fds.get(path)
+            if entry is not None:
+                self._fds.move_to_end(path)
+                entry.refs += 1
+                return entry
+        fd = os.open(path, os.O_RDONLY | getattr(os, 'O_CLOEXEC', 0))
+        to_close = []
+        with self._lock:
+            entry = self._fds.get(path)
+            if entry is not None:
+                to_close.append(fd)
+            else:
+                entry = _OpenFile(fd)
+                self._fds[path] = entry
+                self.opens += 1
+            entry.refs += 1
+            while len(self._fds) > self.max_open:
+                _, old = self._fds.popitem(last=False)
+                old_fd = self._detach(old)
+                if old_fd is not None:
+                    to_close.append(old_fd)
+        for old_fd in to_close:
+            self._close(old_fd)
+        return entry
+
+    def _release(self, entry):
+        # type: (_OpenFile) -> None
+        with self._lock:
+            entry.refs -= 1
+            fd = entry.fd if entry.detached and entry.refs == 0 else None
+        if fd is not None:
+            self._close(fd)
+
+    def _drop(self, path, entry):
+        # type: (str, _OpenFile) -> None
+        fd = None
+        with self._lock:
+            if self._fds.get(path) is entry:
+                del self._fds[path]
+                fd = self._detach(entry)
+        if fd is not None:
+            self._close(fd)
+
+    @staticmethod
+    def _pread_all(fd):
+        # type: (int) -> bytes
+        """从偏移 0 读到 EOF；短读不代表结束（seq_file 每次只给一页左右）"""
+        chunks = []  # type: List[bytes]
+        offset = 0
+        while offset < MAX_READ_SIZE:
+            data = os.pread(fd, READ_SIZE, offset)
+            if not data:
+                break
+            chunks.append(data)
+            offset += len(data)
+        if len(chunks) == 1:
+            return chunks[0]
+        return b''.join(chunks)
+
+    def read(self, path):
+        # type: (str) -> Optional[bytes]
+        """读取文件全部内容，失败返回 None"""
+        for attempt in (0, 1):
+            try:
+                entry = self._acquire(path)
+            except OSError:
+                return None
+            try:
+                data = self._pread_all(entry.fd)
+                self.reads += 1
+                return data
+            except OSError as e:
+                error = e
+            finally:
+                self._release(entry)
+            self._drop(path, entry)
+            if error.errno in _REOPEN_ERRNOS and attempt == 0:
+                continue  # 文件被替换：重新打开再试一次
+            return None
+        return None
+
+    def read_many(self, paths):
+        # type: (Iterable[str]) -> Dict[str, Optional[bytes]]
+        """一次遍历读取一批文件"""
+        return {path: self.read(path) for path in paths}
+
+    def close(self):
+        with self._lock:
+            entries, self._fds = list(self._fds.values()), OrderedDict()
+            fds = [self._detach(entry) for entry in entries]
+        for fd in fds:
+            if fd is not None:
+                self._close(fd)
+
+    def open_count(self):
+        # type: () -> int
+        with self._lock:
+            return len(self._fds)
+
+
+# ---------- 预编译解析模式 ----------
+
+def parse_int(data):
+    # type: (Optional[bytes]) -> Optional[int]
+    """单值整数文件（sysfs 计数器、thermal temp 等）"""
+    if not data:
+        return None
+    try:
+        return int(data)
+    except ValueError:
+        return None
+
+
+def parse_text(data):
+    # type: (Optional[bytes]) -> Optional[str]
+    if data is None:
+        return None
+    return data.decode('utf-8', 'replace').strip()
+
+
+class FieldsSchema(object):
+    """单行空白分隔的整数字段，如 /proc/sys/fs/file-nr"""
+
+    def __init__(self, names):
+        # type: (Sequence[str]) -> None
+        self.names = tuple(names)
+
+    def parse(self, data):
+        # type: (Optional[bytes]) -> Optional[Dict[str, int]]
+        if not data:
+            return None
+        parts = data.split()
+        if len(parts) < len(self.names):
+            return None
+        try:
+            return {name: int(parts[i]) for i, name in enumerate(self.names)}
+        except ValueError:
+            return None
+
+
+class TableSchema(object):
+    """
+    按行的表格文件，如 /proc/diskstats
+
+    Args:
+        key_column: 作为行键的列下标
+        columns: {字段名: 列下标}
+        min_columns: 少于该列数的行跳过
+    """
+
+    def __init__(self, key_column, columns, min_columns=0):
+        # type: (int, Dict[str, int], int) -> None
+        self.key_column = key_column
+        self.columns = tuple(columns.items())
+        self.min_columns = max(min_columns, key_column + 1, max(columns.values()) + 1)
+
+    def parse(self, data, key_filter=None):
+        # type: (Optional[bytes], Optional[Pattern]) -> Dict[str, Dict[str, int]]
+        rows = {}  # type: Dict[str, Dict[str, int]]
+        if not data:
+            return rows
+        for line in data.splitlines():
+            parts = line.split()
+            if len(parts) < self.min_columns:
+                continue
+            key = parts[self.key_column].decode('utf-8', 'replace')
+            if key_filter is not None and not key_filter.match(key):
+                continue
+            try:
+                rows[key] = {name: int(parts[idx]) for name, idx in self.columns}
+            except ValueError:
+                continue
+        return rows
+
+
+DISKSTATS = TableSchema(2, {
+    'reads': 3,
+    'read_sectors': 5,
+    'writes': 7,
+    'write_sectors': 9,
+    'io_time_ms': 12,
+}, min_columns=14)
+
+FILE_NR = FieldsSchema(('allocated', 'free', 'max'))
+
+
+_reader = None  # type: Optional[CounterReader]
+_reader_lock = threading.Lock()
+
+
+def get_counter_reader():
+    # type: () -> CounterReader
+    """全局共享的计数器读取器"""
+    global _reader
+    with _reader_lock:
+        if _reader is None:
+            _reader = CounterReader()
+        return _reader
@@ -5,6 +5,7 @@
 """
 
 import logging
+import os
 import re
 import subprocess
 import sys
@@ -104,8 +105,9 @@ def tail_file(
     last_position: int = 0,
     max_lines: int = 1000,
     skip_existing: bool = False,
+    with_inode: bool = False,
 ):
-    # type: (...) -> Tuple[List[str], int]
+    # type: (...) -> Tuple
     """
     读取文件新增内容（类似 tail -f）
     
@@ -114,24 +116,32 @@ def tail_file(
         last_position: 上次读取的位置
         max_lines: 最大返回行数
         skip_existing: 若为 True 且 last_position=0，则跳到文件末尾（用于启动时不读历史）
+        with_inode: 若为 True，额外返回本次实际读取文件的 inode（检查点记录游标用）
         
     Returns:
-        (新增行列表, 新的位置)
+        (新增行列表, 新的位置)，with_inode 时为 (新增行列表, 新的位置, inode)
     """
-    path = Path(path)
-    
+    lines, position, inode = _tail_file(Path(path), last_position, max_lines, skip_existing)
+    if with_inode:
+        return lines, position, inode
+    return lines, position
+
+
+def _tail_file(path, last_position, max_lines, skip_existing):
+    # type: (Path, int, int, bool) -> Tuple[List[str], int, Optional[int]]
     if not path.exists():
-        return [], 0
+        return [], 0, None
     
     try:
         with open(path, 'r', encoding='utf-8', errors='ignore') as f:
+            inode = os.fstat(f.fileno()).st_ino
             # 获取文件大小
             f.seek(0, 2)  # 移到文件末尾
             file_size = f.tell()
             
             # 如果 skip_existing=True 且首次运行，直接返回末尾位置
             if skip_existing and last_position == 0:
-                return [], file_size
+                return [], file_size, inode
             
             # 如果文件变小了（可能被轮转），从头开始
             if file_size < last_position:
@@ -152,11 +162,11 @@ def tail_file(
             
             new_position = f.tell()
             
-            return lines, new_position
+            return lines, new_position, inode
             
     except Exception as e:
         logger.error(f"读取文件失败: {path}, 错误: {e}")
-        return [], last_position
+        return [], last_position, None
 
 
 def parse_key_value(text: str, sep: str = ':', strip: bool = True) -> Dict[str, str]:
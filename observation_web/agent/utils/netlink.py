@@ -0,0 +1,340 @@
+"""
+Netlink 链路事件监听
+
+后台线程订阅 rtnetlink 的 RTMGRP_LINK 组，接收内核推送的 RTM_NEWLINK /
+RTM_DELLINK 消息，记录每一次 carrier / operstate / speed 变化及其精确时间戳。
+相比按固定周期轮询 /sys/class/net，不会漏掉周期内的短暂闪断，开销也不随
+端口数量增长。
+
+观察点通过游标增量读取事件（events_since），并可获取当前各端口状态快照。
+netlink 不可用（非 Linux、权限受限等），或监听线程出错且无法重建套接字时，
+get_link_monitor() 返回 None，由观察点回退到 sysfs 轮询。
+"""
+
+import errno
+import logging
+import socket
+import struct
+import threading
+import time
+from collections import deque
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple
+
+from .helpers import read_sysfs
+
+logger = logging.getLogger(__name__)
+
+# ---------- rtnetlink 常量 ----------
+
+NETLINK_ROUTE = 0
+RTMGRP_LINK = 0x1
+
+NLMSG_NOOP = 1
+NLMSG_ERROR = 2
+NLMSG_DONE = 3
+RTM_NEWLINK = 16
+RTM_DELLINK = 17
+RTM_GETLINK = 18
+
+NLM_F_REQUEST = 0x1
+NLM_F_DUMP = 0x300
+
+IFLA_IFNAME = 3
+IFLA_MASTER = 10
+IFLA_OPERSTATE = 16
+IFLA_CARRIER = 33
+
+IFF_LOWER_UP = 0x10000
+
+NLMSG_HDR = struct.Struct('=IHHII')     # len, type, flags, seq, pid
+IFINFOMSG = struct.Struct('=BxHiII')    # family, type, index, flags, change
+RTATTR = struct.Struct('=HH')           # len, type
+
+OPERSTATES = {
+    0: 'unknown',
+    1: 'notpresent',
+    2: 'down',
+    3: 'lowerlayerdown',
+    4: 'testing',
+    5: 'dormant',
+    6: 'up',
+}
+
+# 事件环形缓冲上限，观察点周期内的事件远小于此值
+MAX_EVENTS = 4096
+
+RECV_BUFSIZE = 1 << 16
+SOCKET_RCVBUF = 1 << 20
+
+
+def _align(n):
+    # type: (int) -> int
+    return (n + 3) & ~3
+
+
+def parse_messages(data):
+    # type: (bytes) -> List[Tuple[int, Dict[str, Any]]]
+    """
+    解析一个 netlink 数据包中的链路消息
+
+    Returns:
+        [(消息类型, {'index', 'ifname', 'flags', 'carrier', 'operstate', 'master'})]
+    """
+    messages = []
+    offset = 0
+    while offset + NLMSG_HDR.size <= len(data):
+        msg_len, msg_type, _flags, _seq, _pid = NLMSG_HDR.unpack_from(data, offset)
+        if msg_len < NLMSG_HDR.size or offset + msg_len > len(data):
+            break
+        if msg_type in (RTM_NEWLINK, RTM_DELLINK):
+            body = offset + NLMSG_HDR.size
+            _family, _type, index, flags, _change = IFINFOMSG.unpack_from(data, body)
+            link = {
+                'index': index,
+                'flags': flags,
+                'ifname': None,
+                'carrier': None,
+                'operstate': None,
+                'master': None,
+            }
+            attr = body + IFINFOMSG.size
+            end = offset + msg_len
+            while attr + RTATTR.size <= end:
+                rta_len, rta_type = RTATTR.unpack_from(data, attr)
+                if rta_len < RTATTR.size:
+                    break
+                payload = data[attr + RTATTR.size:attr + rta_len]
+                if rta_type == IFLA_IFNAME:
+                    link['ifname'] = payload.split(b'\0', 1)[0].decode('utf-8', 'replace')
+                elif rta_type == IFLA_OPERSTATE and payload:
+                    link['operstate'] = OPERSTATES.get(payload[0], 'unknown')
+                elif rta_type == IFLA_CARRIER and payload:
+                    link['carrier'] = payload[0]
+                elif rta_type == IFLA_MASTER and len(payload) >= 4:
+                    link['master'] = struct.unpack_from('=I', payload)[0]
+                attr += _align(rta_len)
+            messages.append((msg_type, link))
+        offset += _align(msg_len)
+    return messages
+
+
+class LinkMonitor(object):
+    """rtnetlink 链路状态监听器"""
+
+    def __init__(self, sysfs_root='/sys/class/net'):
+        # type: (str) -> None
+        self.sysfs_root = Path(sysfs_root)
+        self._lock = threading.Lock()
+        self._states = {}  # type: Dict[str, Dict[str, Any]]
+        self._events = deque(maxlen=MAX_EVENTS)  # type: deque
+        self._seq = 0
+        self._sock = None  # type: Optional[socket.socket]
+        self._thread = None  # type: Optional[threading.Thread]
+        self._running = False
+        self.overruns = 0
+
+    # ---------- 生命周期 ----------
+
+    @staticmethod
+    def _open_socket():
+        # type: () -> socket.socket
+        sock = socket.socket(socket.AF_NETLINK, socket.SOCK_RAW, NETLINK_ROUTE)
+        try:
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, SOCKET_RCVBUF)
+            sock.bind((0, RTMGRP_LINK))
+            sock.settimeout(1.0)
+        except OSError:
+            sock.close()
+            raise
+        return sock
+
+    def start(self):
+        # type: () -> bool
+        """打开 netlink 套接字并启动监听线程，失败返回 False"""
+        try:
+            sock = self._open_socket()
+        except (AttributeError, OSError) as e:
+            logger.info(f"netlink 不可用，链路监测回退到轮询: {e}")
+            return False
+
+        self._sock = sock
+        self._running = True
+        self._request_dump()
+        self._thread = threading.Thread(target=self._run, name='netlink-link', daemon=True)
+        self._thread.start()
+        return True
+
+    def is_alive(self):
+        # type: () -> bool
+        """监听线程仍在接收事件"""
+        thread = self._thread
+        return self._running and thread is not None and thread.is_alive()
+
+    def stop(self):
+        self._running = False
+        if self._thread is not None:
+            self._thread.join(timeout=2)
+            self._thread = None
+        if self._sock is not None:
+            self._sock.close()
+            self._sock = None
+
+    def _request_dump(self):
+        """请求全量链路信息（启动时及事件丢失后重新同步）"""
+        body = IFINFOMSG.pack(socket.AF_UNSPEC, 0, 0, 0, 0)
+        header = NLMSG_HDR.pack(NLMSG_HDR.size + len(body), RTM_GETLINK,
+                                NLM_F_REQUEST | NLM_F_DUMP, int(time.time()), 0)
+        try:
+            self._sock.send(header + body)
+        except OSError as e:
+            logger.warning(f"netlink 链路全量请求失败: {e}")
+
+    def _run(self):
+        while self._running:
+            try:
+                data = self._sock.recv(RECV_BUFSIZE)
+            except socket.timeout:
+                continue
+            except OSError as e:
+                if e.errno == errno.ENOBUFS:
+                    # 内核缓冲溢出，事件有丢失：全量重新同步，差异仍会记为变化
+                    self.overruns += 1
+                    logger.warning("netlink 事件缓冲溢出，重新同步链路状态")
+                    self._request_dump()
+                    continue
+                if not self._running:
+                    break
+                logger.error(f"netlink 接收失败: {e}")
+                if not self._reopen():
+                    # 监听结束；get_link_monitor() 据此让观察点回退到轮询
+                    self._running = False
+                    break
+                continue
+            self.handle(data)
+
+    def _reopen(self):
+        # type: () -> bool
+        """重建套接字并全量重新同步（期间的变化由差异记为事件）"""
+        try:
+            sock = self._open_socket()
+        except OSError as e:
+            logger.error(f"netlink 套接字重建失败，链路监测回退到轮询: {e}")
+            return False
+        old, self._sock = self._sock, sock
+        if old is not None:
+            old.close()
+        self._request_dump()
+        return True
+
+    # ---------- 事件处理 ----------
+
+    def handle(self, data, now=None):
+        # type: (bytes, Optional[float]) -> None
+        """处理一个 netlink 数据包（监听线程调用，测试可直接注入）"""
+        now = time.time() if now is None else now
+        for msg_type, link in parse_messages(data):
+            name = link['ifname']
+            if not name:
+                continue
+            if msg_type == RTM_DELLINK:
+                self._remove(name, now)
+            else:
+                self._update(name, link, now)
+
+    def _read_speed(self, name):
+        # type: (str) -> Tuple[Optional[str], Optional[str]]
+        port_path = self.sysfs_root / name
+        return read_sysfs(port_path / 'speed'), read_sysfs(port_path / 'duplex')
+
+    def _update(self, name, link, now):
+        # type: (str, Dict[str, Any], float) -> None
+        carrier = link['carrier']
+        if carrier is None:
+            carrier = 1 if link['flags'] & IFF_LOWER_UP else 0
+        state = {
+            'carrier': '1' if carrier else '0',
+            'operstate': link['operstate'] or 'unknown',
+            'is_slave': bool(link['master']),
+        }
+        # 每条 NEWLINK 都重读速率：链路保持 up 时的降速重协商不会改变 carrier
+        state['speed'], state['duplex'] = self._read_speed(name)
+        with self._lock:
+            last = self._states.get(name)
+        if last is not None and all(last.get(k) == v for k, v in state.items()):
+            return  # 与链路状态无关的 NEWLINK（如 MTU、地址变化）
+
+        state['timestamp'] = datetime.fromtimestamp(now).isoformat()
+        with self._lock:
+            self._states[name] = state
+            self._append_event(name, 'new' if last is None else 'change', state)
+
+    def _remove(self, name, now):
+        # type: (str, float) -> None
+        with self._lock:
+            if self._states.pop(name, None) is None:
+                return
+            state = {
+                'carrier': '0',
+                'operstate': 'notpresent',
+                'speed': None,
+                'duplex': None,
+                'timestamp': datetime.fromtimestamp(now).isoformat(),
+            }
+            self._append_event(name, 'removed', state)
+
+    def _append_event(self, name, kind, state):
+        # type: (str, str, Dict[str, Any]) -> None
+        self._seq += 1
+        self._events.append({'seq': self._seq, 'port': name, 'kind': kind, 'state': dict(state)})
+
+    # ---------- 查询 ----------
+
+    @property
+    def seq(self):
+        # type: () -> int
+        with self._lock:
+            return self._seq
+
+    def events_since(self, seq):
+        # type: (int) -> Tuple[List[Dict[str, Any]], int]
+        """返回序号大于 seq 的事件及最新序号（游标）"""
+        with self._lock:
+            events = [e for e in self._events if e['seq'] > seq]
+            return events, self._seq
+
+    def snapshot(self):
+        # type: () -> Dict[str, Dict[str, Any]]
+        """当前各端口状态"""
+        return self.checkpoint()[0]
+
+    def checkpoint(self):
+        # type: () -> Tuple[Dict[str, Dict[str, Any]], int]
+        """当前各端口状态及对应的事件序号（观察点初始化基线用）"""
+        with self._lock:
+            return {name: dict(state) for name, state in self._states.items()}, self._seq
+
+
+_monitor = None  # type: Optional[LinkMonitor]
+_monitor_failed = False
+_monitor_lock = threading.Lock()
+
+
+def get_link_monitor():
+    # type: () -> Optional[LinkMonitor]
+    """获取全局链路监听器（首次调用时启动），netlink 不可用或监听已终止时返回 None"""
+    global _monitor, _monitor_failed
+    with _monitor_lock:
+        if _monitor is not None and not _monitor.is_alive():
+            logger.warning("netlink 链路监听已终止，链路监测回退到轮询")
+            _monitor.stop()
+            _monitor = None
+            _monitor_failed = True
+        if _monitor is None and not _monitor_failed:
+            monitor = LinkMonitor()
+            if monitor.start():
+                _monitor = monitor
+            else:
+                _monitor_failed = True
+        return _monitor
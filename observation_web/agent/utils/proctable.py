@@ -0,0 +1,212 @@
+"""
+进程表快照
+
+每个调度周期从 /proc 单次扫描构建一份进程表，供所有进程类观察点共享，
+替代各观察点各自执行 ps / ps | grep（每次 fork/exec 一个子进程）。
+快照支持按 pid、ppid、进程名索引查询。
+"""
+
+import logging
+import os
+import pwd
+import re
+import threading
+import time
+from typing import Dict, List, Optional
+
+logger = logging.getLogger(__name__)
+
+PROC_ROOT = '/proc'
+
+# 未由调度器推进周期时（如单独运行观察点），快照最长复用时间（秒）
+SNAPSHOT_MAX_AGE = 1.0
+
+
+class ProcessInfo(object):
+    """单个进程的快照信息"""
+
+    __slots__ = ('pid', 'ppid', 'state', 'comm', 'cmdline', 'uid')
+
+    def __init__(self, pid, ppid, state, comm, cmdline, uid):
+        # type: (int, int, str, str, str, int) -> None
+        self.pid = pid
+        self.ppid = ppid
+        self.state = state
+        self.comm = comm
+        self.cmdline = cmdline
+        self.uid = uid
+
+    @property
+    def is_zombie(self):
+        # type: () -> bool
+        return self.state == 'Z'
+
+    @property
+    def command(self):
+        # type: () -> str
+        """与 ps 的 COMMAND 列一致：无 cmdline 时（内核线程、僵尸）显示 [comm]"""
+        return self.cmdline or '[{}]'.format(self.comm)
+
+    @property
+    def user(self):
+        # type: () -> str
+        return _user_name(self.uid)
+
+
+_user_cache = {}  # type: Dict[int, str]
+
+
+def _user_name(uid):
+    # type: (int) -> str
+    name = _user_cache.get(uid)
+    if name is None:
+        try:
+            name = pwd.getpwuid(uid).pw_name
+        except (KeyError, OverflowError):
+            name = str(uid)
+        _user_cache[uid] = name
+    return name
+
+
+def _read_process(proc_root, pid):
+    # type: (str, int) -> Optional[ProcessInfo]
+    base = os.path.join(proc_root, str(pid))
+    try:
+        with open(os.path.join(base, 'stat'), 'rb') as f:
+            stat = f.read().decode('utf-8', 'replace')
+        uid = os.stat(base).st_uid
+    except (IOError, OSError):
+        return None  # 进程已退出
+
+    # comm 可能包含空格和括号，以最后一个 ')' 为界
+    lpar = stat.find('(')
+    rpar = stat.rfind(')')
+    if lpar < 0 or rpar < lpar:
+        return None
+    comm = stat[lpar + 1:rpar]
+    fields = stat[rpar + 2:].split()
+    if len(fields) < 2:
+        return None
+    state = fields[0]
+    try:
+        ppid = int(fields[1])
+    except ValueError:
+        ppid = 0
+
+    cmdline = ''
+    if state != 'Z':
+        try:
+            with open(os.path.join(base, 'cmdline'), 'rb') as f:
+                raw = f.read()
+            cmdline = raw.rstrip(b'\0').replace(b'\0', b' ').decode('utf-8', 'replace')
+        except (IOError, OSError):
+            pass
+
+    return ProcessInfo(pid, ppid, state, comm, cmdline, uid)
+
+
+class ProcessTable(object):
+    """一次 /proc 扫描得到的进程表"""
+
+    def __init__(self, processes, taken_at=None):
+        # type: (List[ProcessInfo], Optional[float]) -> None
+        self.taken_at = taken_at if taken_at is not None else time.time()
+        self._by_pid = {}  # type: Dict[int, ProcessInfo]
+        self._by_ppid = {}  # type: Dict[int, List[ProcessInfo]]
+        self._by_comm = {}  # type: Dict[str, List[ProcessInfo]]
+        for p in processes:
+            self._by_pid[p.pid] = p
+            self._by_ppid.setdefault(p.ppid, []).append(p)
+            self._by_comm.setdefault(p.comm, []).append(p)
+
+    @classmethod
+    def scan(cls, proc_root=PROC_ROOT):
+        # type: (str) -> ProcessTable
+        processes = []
+        for entry in os.listdir(proc_root):
+            if not entry.isdigit():
+                continue
+            info = _read_process(proc_root, int(entry))
+            if info is not None:
+                processes.append(info)
+        return cls(processes)
+
+    def __len__(self):
+        return len(self._by_pid)
+
+    def __iter__(self):
+        return iter(self._by_pid.values())
+
+    def get(self, pid):
+        # type: (int) -> Optional[ProcessInfo]
+        return self._by_pid.get(pid)
+
+    def children(self, ppid):
+        # type: (int) -> List[ProcessInfo]
+        return list(self._by_ppid.get(ppid, ()))
+
+    def by_name(self, name):
+        # type: (str) -> List[ProcessInfo]
+        """按进程名（comm）精确查找"""
+        return list(self._by_comm.get(name, ()))
+
+    def zombies(self):
+        # type: () -> List[ProcessInfo]
+        return [p for p in self._by_pid.values() if p.is_zombie]
+
+    def search(self, pattern):
+        # type: (str) -> List[ProcessInfo]
+        """
+        按正则（忽略大小写）匹配进程名或命令行，语义等同 ps aux | grep -iE
+
+        非法正则按字面字符串匹配。
+        """
+        try:
+            regex = re.compile(pattern, re.IGNORECASE)
+        except re.error:
+            regex = re.compile(re.escape(pattern), re.IGNORECASE)
+        return [
+            p for p in self._by_pid.values()
+            if regex.search(p.cmdline) or regex.search(p.comm)
+        ]
+
+
+_lock = threading.Lock()
+_snapshot = None  # type: Optional[ProcessTable]
+_tick = 0
+_snapshot_tick = -1
+
+
+def new_tick():
+    """调度器每轮开始时调用：本轮首次查询时重新扫描 /proc"""
+    global _tick
+    with _lock:
+        _tick += 1
+
+
+def get_process_table(max_age=SNAPSHOT_MAX_AGE):
+    # type: (float) -> Optional[ProcessTable]
+    """
+    获取本轮共享的进程表快照
+
+    Returns:
+        ProcessTable，/proc 不可用时返回 None
+    """
+    global _snapshot, _snapshot_tick
+    with _lock:
+        # 调度器驱动时整轮复用同一快照；否则按 max_age 复用
+        fresh = (
+            _snapshot is not None
+            and _snapshot_tick == _tick
+            and (_tick > 0 or time.time() - _snapshot.taken_at < max_age)
+        )
+        if fresh:
+            return _snapshot
+        try:
+            _snapshot = ProcessTable.scan()
+        except (IOError, OSError) as e:
+            logger.warning(f"扫描 /proc 失败: {e}")
+            _snapshot = None
+            return None
+        _snapshot_tick = _tick
+        return _snapshot
@@ -0,0 +1,208 @@
+"""
+系统统计快照
+
+每个调度周期单次读取 /proc/stat、/proc/meminfo、/proc/loadavg，构建一份
+系统统计快照，供 cpu_usage、memory_leak、swap_usage、load_average 等观察点
+共享，替代各观察点各自读取文件或执行 free -m / top。
+/proc/stat 按核解析，观察点可据此给出每核利用率。
+"""
+
+import logging
+import threading
+import time
+from typing import Dict, List, Optional, Tuple
+
+from .counters import CounterReader, get_counter_reader
+
+logger = logging.getLogger(__name__)
+
+PROC_ROOT = '/proc'
+
+# 未由调度器推进周期时（如单独运行观察点），快照最长复用时间（秒）
+SNAPSHOT_MAX_AGE = 1.0
+
+
+class CpuTimes(object):
+    """一行 cpu/cpuN 的累计时间（jiffies）"""
+
+    __slots__ = ('total', 'idle')
+
+    def __init__(self, total, idle):
+        # type: (int, int) -> None
+        self.total = total
+        self.idle = idle
+
+    def usage_since(self, prev):
+        # type: (CpuTimes) -> Optional[float]
+        """相对上一份快照的利用率（%），计数器未前进时返回 None"""
+        total_delta = self.total - prev.total
+        if total_delta <= 0:
+            return None
+        idle_delta = self.idle - prev.idle
+        usage = (total_delta - idle_delta) * 100.0 / total_delta
+        return max(0.0, min(100.0, usage))
+
+
+def parse_stat(data):
+    # type: (Optional[bytes]) -> Dict[str, CpuTimes]
+    """
+    解析 /proc/stat 的 cpu 行
+
+    格式: cpuN user nice system idle iowait irq softirq steal guest guest_nice
+    guest 时间已计入 user，只累加前 8 列；空闲 = idle + iowait。
+    """
+    cpus = {}  # type: Dict[str, CpuTimes]
+    if not data:
+        return cpus
+    for line in data.splitlines():
+        if not line.startswith(b'cpu'):
+            if cpus:
+                break  # cpu 行位于文件开头且连续
+            continue
+        parts = line.split()
+        if len(parts) < 5:
+            continue
+        try:
+            values = [int(v) for v in parts[1:9]]
+        except ValueError:
+            continue
+        idle = values[3] + (values[4] if len(values) > 4 else 0)
+        cpus[parts[0].decode('ascii', 'replace')] = CpuTimes(sum(values), idle)
+    return cpus
+
+
+def parse_meminfo(data):
+    # type: (Optional[bytes]) -> Dict[str, int]
+    """解析 /proc/meminfo，数值单位 kB"""
+    info = {}  # type: Dict[str, int]
+    if not data:
+        return info
+    for line in data.splitlines():
+        key, sep, rest = line.partition(b':')
+        if not sep:
+            continue
+        parts = rest.split()
+        if not parts:
+            continue
+        try:
+            info[key.strip().decode('ascii', 'replace')] = int(parts[0])
+        except ValueError:
+            continue
+    return info
+
+
+def parse_loadavg(data):
+    # type: (Optional[bytes]) -> Optional[Tuple[float, float, float]]
+    if not data:
+        return None
+    parts = data.split()
+    if len(parts) < 3:
+        return None
+    try:
+        return float(parts[0]), float(parts[1]), float(parts[2])
+    except ValueError:
+        return None
+
+
+class SystemStats(object):
+    """一次读取得到的系统统计快照"""
+
+    def __init__(self, cpus, meminfo, loadavg, taken_at=None):
+        # type: (Dict[str, CpuTimes], Dict[str, int], Optional[Tuple[float, float, float]], Optional[float]) -> None
+        self.taken_at = taken_at if taken_at is not None else time.time()
+        self.cpus = cpus
+        self.meminfo = meminfo
+        self.loadavg = loadavg
+
+    @classmethod
+    def read(cls, proc_root=PROC_ROOT, reader=None):
+        # type: (str, Optional[CounterReader]) -> SystemStats
+        reader = reader or get_counter_reader()
+        return cls(
+            parse_stat(reader.read(f'{proc_root}/stat')),
+            parse_meminfo(reader.read(f'{proc_root}/meminfo')),
+            parse_loadavg(reader.read(f'{proc_root}/loadavg')),
+        )
+
+    @property
+    def cores(self):
+        # type: () -> List[str]
+        """各核名称（cpu0, cpu1, ...），按编号排序"""
+        names = [n for n in self.cpus if n != 'cpu']
+        return sorted(names, key=lambda n: int(n[3:]) if n[3:].isdigit() else 0)
+
+    def cpu_usage(self, prev):
+        # type: (Optional[SystemStats]) -> Dict[str, float]
+        """相对上一份快照的利用率：{'cpu': 总体, 'cpu0': ..., ...}"""
+        usage = {}  # type: Dict[str, float]
+        if prev is None:
+            return usage
+        for name, times in self.cpus.items():
+            last = prev.cpus.get(name)
+            if last is None:
+                continue
+            value = times.usage_since(last)
+            if value is not None:
+                usage[name] = value
+        return usage
+
+    @property
+    def mem_total_kb(self):
+        # type: () -> Optional[int]
+        return self.meminfo.get('MemTotal')
+
+    @property
+    def mem_used_kb(self):
+        # type: () -> Optional[int]
+        """与 free 的 used 列口径一致：total - free - buffers - cache(含 SReclaimable)"""
+        total = self.meminfo.get('MemTotal')
+        free = self.meminfo.get('MemFree')
+        if total is None or free is None:
+            return None
+        cache = (
+            self.meminfo.get('Buffers', 0)
+            + self.meminfo.get('Cached', 0)
+            + self.meminfo.get('SReclaimable', 0)
+        )
+        used = total - free - cache
+        return used if used >= 0 else total - free
+
+
+_lock = threading.Lock()
+_snapshot = None  # type: Optional[SystemStats]
+_tick = 0
+_snapshot_tick = -1
+
+
+def new_tick():
+    """调度器每轮开始时调用：本轮首次查询时重新读取"""
+    global _tick
+    with _lock:
+        _tick += 1
+
+
+def get_system_stats(max_age=SNAPSHOT_MAX_AGE):
+    # type: (float) -> Optional[SystemStats]
+    """
+    获取本轮共享的系统统计快照
+
+    Returns:
+        SystemStats，/proc/stat 与 /proc/meminfo 均不可读时返回 None
+    """
+    global _snapshot, _snapshot_tick
+    with _lock:
+        # 调度器驱动时整轮复用同一快照；否则按 max_age 复用
+        fresh = (
+            _snapshot is not None
+            and _snapshot_tick == _tick
+            and (_tick > 0 or time.time() - _snapshot.taken_at < max_age)
+        )
+        if fresh:
+            return _snapshot
+        stats = SystemStats.read()
+        if not stats.cpus and not stats.meminfo:
+            logger.warning("读取 /proc/stat、/proc/meminfo 失败")
+            _snapshot = None
+            return None
+        _snapshot, _snapshot_tick = stats, _tick
+        return _snapshot
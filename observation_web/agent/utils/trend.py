@@ -0,0 +1,79 @@
+"""
+滑动窗口线性趋势
+
+对窗口内 (时间, 数值) 样本做最小二乘线性回归，给出斜率与拟合优度 R²。
+相比“连续 N 次增长”判定，单次回落不会清零，缓慢但持续的增长也能更早识别，
+而无规律的波动因 R² 低不会误报。
+"""
+
+from collections import deque
+from typing import List, Optional, Tuple
+
+
+class TrendFit(object):
+    """一次拟合结果"""
+
+    __slots__ = ('slope', 'intercept', 'r2', 'samples', 'span')
+
+    def __init__(self, slope, intercept, r2, samples, span):
+        # type: (float, float, float, int, float) -> None
+        self.slope = slope          # 数值单位 / 秒
+        self.intercept = intercept
+        self.r2 = r2
+        self.samples = samples
+        self.span = span            # 窗口覆盖时长（秒）
+
+    def to_dict(self):
+        return {
+            'slope_per_hour': round(self.slope * 3600, 3),
+            'r2': round(self.r2, 3),
+            'samples': self.samples,
+            'span_hours': round(self.span / 3600, 2),
+        }
+
+
+def linear_fit(points):
+    # type: (List[Tuple[float, float]]) -> Optional[TrendFit]
+    """最小二乘拟合 y = slope * x + intercept，样本不足或时间无跨度时返回 None"""
+    n = len(points)
+    if n < 2:
+        return None
+    # 以首个时间点为原点，避免大时间戳带来的精度损失
+    x0 = points[0][0]
+    xs = [p[0] - x0 for p in points]
+    ys = [float(p[1]) for p in points]
+    mean_x = sum(xs) / n
+    mean_y = sum(ys) / n
+    sxx = sum((x - mean_x) ** 2 for x in xs)
+    if sxx <= 0:
+        return None
+    sxy = sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys))
+    syy = sum((y - mean_y) ** 2 for y in ys)
+    slope = sxy / sxx
+    intercept = mean_y - slope * (mean_x + x0)
+    # 数值完全不变时视为完美拟合的水平线
+    r2 = (sxy * sxy) / (sxx * syy) if syy > 0 else 1.0
+    return TrendFit(slope, intercept, r2, n, xs[-1])
+
+
+class TrendWindow(object):
+    """固定样本数的滑动窗口"""
+
+    def __init__(self, size):
+        # type: (int) -> None
+        self._points = deque(maxlen=max(2, size))  # type: deque
+
+    def add(self, ts, value):
+        # type: (float, float) -> None
+        self._points.append((ts, value))
+
+    def __len__(self):
+        return len(self._points)
+
+    def values(self):
+        # type: () -> List[float]
+        return [v for _, v in self._points]
+
+    def fit(self):
+        # type: () -> Optional[TrendFit]
+        return linear_fit(list(self._points))
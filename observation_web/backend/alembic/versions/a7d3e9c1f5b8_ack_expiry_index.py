@@ -0,0 +1,38 @@
+"""alert_acknowledgements.ack_expires_at index for the ack expiry timer
+
+Revision ID: a7d3e9c1f5b8
+Revises: f5c2a9d7b3e4
+Create Date: 2026-10-17 16:00:00.000000
+
+core/ack_expiry.py deletes acks the moment they lapse and sleeps until the
+earliest remaining ack_expires_at; both are range scans on this column.
+"""
+from typing import Sequence, Union
+
+from alembic import op
+import sqlalchemy as sa
+
+
+# revision identifiers, used by Alembic.
+revision: str = 'a7d3e9c1f5b8'
+down_revision: Union[str, None] = 'f5c2a9d7b3e4'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    bind = op.get_bind()
+    inspector = sa.inspect(bind)
+    if 'alert_acknowledgements' not in set(inspector.get_table_names()):
+        return  # create_all builds the table with the index
+    indexes = {i['name'] for i in inspector.get_indexes('alert_acknowledgements')}
+    if 'ix_ack_expires_at' in indexes:
+        return
+
+    op.create_index(
+        'ix_ack_expires_at', 'alert_acknowledgements', ['ack_expires_at'], unique=False
+    )
+
+
+def downgrade() -> None:
+    op.drop_index('ix_ack_expires_at', table_name='alert_acknowledgements')
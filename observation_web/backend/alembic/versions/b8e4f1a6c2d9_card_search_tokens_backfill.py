@@ -0,0 +1,60 @@
+"""card_search_tokens backfill for indexed card inventory search
+
+Revision ID: b8e4f1a6c2d9
+Revises: a7d3e9c1f5b8
+Create Date: 2026-10-17 17:00:00.000000
+
+GET /card-inventory?q= now matches keywords against card_search_tokens
+(created by create_all, along with card_inventory_journal) instead of
+filtering every card row in Python.  Cards synced before this revision have
+no tokens yet; index them here so search keeps finding them before the next
+sync rewrites their rows.
+"""
+from typing import Sequence, Union
+
+from alembic import op
+import sqlalchemy as sa
+
+
+# revision identifiers, used by Alembic.
+revision: str = 'b8e4f1a6c2d9'
+down_revision: Union[str, None] = 'a7d3e9c1f5b8'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def _search_tokens(*values):
+    # Frozen copy of core/card_inventory.search_tokens
+    tokens = set()
+    for value in values:
+        for word in (value or '').lower().split():
+            for i in range(len(word)):
+                tokens.add(word[i:])
+    return tokens
+
+
+def upgrade() -> None:
+    bind = op.get_bind()
+    inspector = sa.inspect(bind)
+    tables = set(inspector.get_table_names())
+    if 'card_inventory' not in tables or 'card_search_tokens' not in tables:
+        return  # create_all builds both; there is nothing to backfill yet
+
+    cards = bind.execute(sa.text("""
+        SELECT id, card_no, board_id, model FROM card_inventory
+        WHERE id NOT IN (SELECT card_id FROM card_search_tokens)
+    """)).fetchall()
+    rows = [
+        {'token': token, 'card_id': card.id}
+        for card in cards
+        for token in _search_tokens(card.card_no, card.board_id, card.model)
+    ]
+    if rows:
+        bind.execute(
+            sa.text("INSERT OR IGNORE INTO card_search_tokens (token, card_id) VALUES (:token, :card_id)"),
+            rows,
+        )
+
+
+def downgrade() -> None:
+    op.execute('DELETE FROM card_search_tokens')
@@ -0,0 +1,46 @@
+"""ai_interpretations.content_key for content-keyed interpretation reuse
+
+Revision ID: d3a8f1c5e6b2
+Revises: c7e9d2b4f81a
+Create Date: 2026-10-17 10:00:00.000000
+
+Alerts with identical normalized content (see core/ai_cache.py) share one
+stored interpretation.  Existing rows keep an empty key and are only
+reachable by alert_id, as before.
+"""
+from typing import Sequence, Union
+
+from alembic import op
+import sqlalchemy as sa
+
+
+# revision identifiers, used by Alembic.
+revision: str = 'd3a8f1c5e6b2'
+down_revision: Union[str, None] = 'c7e9d2b4f81a'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    bind = op.get_bind()
+    inspector = sa.inspect(bind)
+    if 'ai_interpretations' not in set(inspector.get_table_names()):
+        return  # create_all builds the table with the column
+    columns = {c['name'] for c in inspector.get_columns('ai_interpretations')}
+    if 'content_key' in columns:
+        return
+
+    with op.batch_alter_table('ai_interpretations') as batch_op:
+        batch_op.add_column(
+            sa.Column('content_key', sa.String(64), nullable=True,
+                      server_default=sa.text("''"))
+        )
+        batch_op.create_index(
+            'ix_ai_interpretations_content_key', ['content_key'], unique=False
+        )
+
+
+def downgrade() -> None:
+    with op.batch_alter_table('ai_interpretations') as batch_op:
+        batch_op.drop_index('ix_ai_interpretations_content_key')
+        batch_op.drop_column('content_key')
@@ -0,0 +1,43 @@
+"""sync_state.hash_indexed_id for the persisted history-import dedup index
+
+Revision ID: e4b6d8f2a7c1
+Revises: d3a8f1c5e6b2
+Create Date: 2026-10-17 12:00:00.000000
+
+History import dedups against alert_hashes (created by create_all) instead
+of re-hashing the last 30 days of alerts on every run.  hash_indexed_id is
+the per-array watermark up to which alerts rows have been folded into that
+index; existing rows start at 0 and are indexed on their next import.
+"""
+from typing import Sequence, Union
+
+from alembic import op
+import sqlalchemy as sa
+
+
+# revision identifiers, used by Alembic.
+revision: str = 'e4b6d8f2a7c1'
+down_revision: Union[str, None] = 'd3a8f1c5e6b2'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    bind = op.get_bind()
+    inspector = sa.inspect(bind)
+    if 'sync_state' not in set(inspector.get_table_names()):
+        return  # create_all builds the table with the column
+    columns = {c['name'] for c in inspector.get_columns('sync_state')}
+    if 'hash_indexed_id' in columns:
+        return
+
+    with op.batch_alter_table('sync_state') as batch_op:
+        batch_op.add_column(
+            sa.Column('hash_indexed_id', sa.Integer(), nullable=True,
+                      server_default=sa.text('0'))
+        )
+
+
+def downgrade() -> None:
+    with op.batch_alter_table('sync_state') as batch_op:
+        batch_op.drop_column('hash_indexed_id')
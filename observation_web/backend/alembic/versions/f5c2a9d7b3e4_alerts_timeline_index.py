@@ -0,0 +1,40 @@
+"""alerts covering index for keyset-paged timeline
+
+Revision ID: f5c2a9d7b3e4
+Revises: e4b6d8f2a7c1
+Create Date: 2026-10-17 14:00:00.000000
+
+The timeline endpoint pages by (timestamp, id) cursors and filters by
+observer/category; (array_id, timestamp, observer_name, level) lets SQLite
+answer the page scan and the window count from the index alone.
+"""
+from typing import Sequence, Union
+
+from alembic import op
+import sqlalchemy as sa
+
+
+# revision identifiers, used by Alembic.
+revision: str = 'f5c2a9d7b3e4'
+down_revision: Union[str, None] = 'e4b6d8f2a7c1'
+branch_labels: Union[str, Sequence[str], None] = None
+depends_on: Union[str, Sequence[str], None] = None
+
+
+def upgrade() -> None:
+    bind = op.get_bind()
+    inspector = sa.inspect(bind)
+    if 'alerts' not in set(inspector.get_table_names()):
+        return  # create_all builds the table with the index
+    indexes = {i['name'] for i in inspector.get_indexes('alerts')}
+    if 'ix_alerts_timeline' in indexes:
+        return
+
+    op.create_index(
+        'ix_alerts_timeline', 'alerts',
+        ['array_id', 'timestamp', 'observer_name', 'level'], unique=False
+    )
+
+
+def downgrade() -> None:
+    op.drop_index('ix_alerts_timeline', table_name='alerts')
@@ -9,15 +9,17 @@ Allows users to acknowledge alerts with different types:
 Track who acknowledged (by client IP), and undo acknowledgements.
 """
 
+import json
 import logging
 from datetime import datetime, timedelta
-from typing import List, Optional
+from typing import Dict, Iterable, List, Optional, Tuple
 
 from fastapi import APIRouter, Depends, HTTPException, Request, Query, status, Body
 from pydantic import BaseModel
-from sqlalchemy import select, delete, exists, update
+from sqlalchemy import DateTime, Select, func, insert, literal, select, delete, exists, update
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from ..core.ack_expiry import get_ack_expiry_scheduler
 from ..db.database import get_db
 from ..middleware.user_session import get_client_ip
 from ..models.alert import (
@@ -29,6 +31,60 @@ router = APIRouter(prefix="/alerts", tags=["acknowledgements"])
 
 # Default expiry hours for dismiss type
 _DISMISS_DEFAULT_HOURS = 24
+_DEFERRED_DEFAULT_HOURS = 72
+_CONFIRMED_OK_HOURS = (2, 4, 6, 8, 12, 24)
+
+# Columns filled by the set-based INSERT ... SELECT
+_ACK_INSERT_COLUMNS = ['alert_id', 'acked_by_ip', 'comment', 'ack_type', 'ack_expires_at', 'note']
+
+
+def _normalize_ack_type(ack_type: str) -> str:
+    valid_types = {t.value for t in AckType}
+    return ack_type if ack_type in valid_types else AckType.DISMISS.value
+
+
+def _ack_expiry(
+    ack_type: str, expires_hours: Optional[int] = None, confirmed_ok_default: Optional[int] = None
+) -> Optional[datetime]:
+    """Expiry for an ack type; confirmed_ok never expires unless hours are given"""
+    if ack_type == AckType.DISMISS.value:
+        return datetime.now() + timedelta(hours=_DISMISS_DEFAULT_HOURS)
+    if ack_type == AckType.DEFERRED.value:
+        return datetime.now() + timedelta(hours=expires_hours or _DEFERRED_DEFAULT_HOURS)
+    if ack_type == AckType.CONFIRMED_OK.value:
+        h = expires_hours or confirmed_ok_default
+        if h:
+            # confirmed_ok with optional expiry: 2/4/6/8/12/24 hours
+            return datetime.now() + timedelta(hours=h if h in _CONFIRMED_OK_HOURS else 24)
+    return None
+
+
+def _id_set(alert_ids: Iterable[int]) -> Select:
+    """
+    Alert IDs as a subquery bound through one JSON parameter (SQLite
+    json_each), so batches of any size stay clear of the bound-parameter
+    limit and compile to a single statement.
+    """
+    ids = func.json_each(json.dumps([int(i) for i in alert_ids])).table_valued("value")
+    return select(ids.c.value)
+
+
+def _ack_rows_from(source: Select, client_ip: str, ack_type: str,
+                   expires_at: Optional[datetime], comment: str, note: str):
+    """INSERT ... SELECT of ack rows for every unacked alert id in ``source``"""
+    select_ids = (
+        select(
+            AlertModel.id,
+            literal(client_ip),
+            literal(comment),
+            literal(ack_type),
+            literal(expires_at, DateTime),
+            literal(note),
+        )
+        .where(AlertModel.id.in_(source))
+        .where(~exists().where(AlertAckModel.alert_id == AlertModel.id))
+    )
+    return insert(AlertAckModel).from_select(_ACK_INSERT_COLUMNS, select_ids)
 
 
 @router.post("/ack", response_model=List[AlertAckResponse])
@@ -52,66 +108,49 @@ async def ack_alerts(
             detail="alert_ids must not be empty",
         )
 
-    # Validate ack_type
-    valid_types = {t.value for t in AckType}
-    ack_type = body.ack_type if body.ack_type in valid_types else AckType.DISMISS.value
+    ack_type = _normalize_ack_type(body.ack_type)
+    expires_at = _ack_expiry(ack_type, body.expires_hours)
+    requested = list(dict.fromkeys(body.alert_ids))
 
-    # Compute expiry
-    expires_at = None
-    if ack_type == AckType.DISMISS.value:
-        expires_at = datetime.now() + timedelta(hours=_DISMISS_DEFAULT_HOURS)
-    elif ack_type == AckType.DEFERRED.value:
-        hours = body.expires_hours or 72  # default 3 days for deferred
-        expires_at = datetime.now() + timedelta(hours=hours)
-    elif ack_type == AckType.CONFIRMED_OK.value and body.expires_hours:
-        # confirmed_ok with optional expiry: 2/4/6/8/12/24 hours
-        h = body.expires_hours
-        if h not in (2, 4, 6, 8, 12, 24):
-            h = 24
-        expires_at = datetime.now() + timedelta(hours=h)
-
-    # Verify all alert IDs exist
+    # Verify all alert IDs exist (ids are only listed when some are missing)
     result = await db.execute(
-        select(AlertModel.id).where(AlertModel.id.in_(body.alert_ids))
+        select(func.count()).select_from(AlertModel).where(AlertModel.id.in_(_id_set(requested)))
     )
-    existing_ids = {row[0] for row in result.all()}
-    missing = set(body.alert_ids) - existing_ids
-    if missing:
+    if (result.scalar() or 0) != len(requested):
+        result = await db.execute(
+            select(AlertModel.id).where(AlertModel.id.in_(_id_set(requested)))
+        )
+        missing = set(requested) - {row[0] for row in result.all()}
         raise HTTPException(
             status_code=status.HTTP_404_NOT_FOUND,
             detail=f"Alert IDs not found: {sorted(missing)}",
         )
 
-    # Find which are already acked (skip those)
+    # Already-acked alerts are skipped by the INSERT ... SELECT itself
     result = await db.execute(
-        select(AlertAckModel.alert_id).where(
-            AlertAckModel.alert_id.in_(body.alert_ids)
+        _ack_rows_from(_id_set(requested), client_ip, ack_type, expires_at,
+                       body.comment, body.comment)
+        .returning(
+            AlertAckModel.id, AlertAckModel.alert_id, AlertAckModel.acked_by_ip,
+            AlertAckModel.acked_at, AlertAckModel.comment, AlertAckModel.ack_type,
+            AlertAckModel.ack_expires_at, AlertAckModel.note,
         )
     )
-    already_acked = {row[0] for row in result.all()}
-    to_ack = [aid for aid in body.alert_ids if aid not in already_acked]
-
-    created = []
-    for alert_id in to_ack:
-        ack = AlertAckModel(
-            alert_id=alert_id,
-            acked_by_ip=client_ip,
-            comment=body.comment,
-            ack_type=ack_type,
-            ack_expires_at=expires_at,
-            note=body.comment,
-        )
-        db.add(ack)
-        created.append(ack)
+    order = {aid: i for i, aid in enumerate(requested)}
+    created = sorted(
+        (AlertAckResponse(**row._mapping) for row in result.all()),
+        key=lambda ack: order[ack.alert_id],
+    )
 
     if created:
         await db.commit()
-        for ack in created:
-            await db.refresh(ack)
+        get_ack_expiry_scheduler().schedule(expires_at)
 
         # Attempt to clear matching active issues from in-memory cache
         try:
-            await _clear_acked_active_issues(db, to_ack)
+            await _clear_acked_active_issues(
+                db, {ack.alert_id: (client_ip, expires_at) for ack in created}
+            )
         except Exception:
             logger.debug("Failed to clear active issues cache (non-critical)")
 
@@ -129,54 +168,34 @@ async def ack_all_visible(
     Batch acknowledge all currently unacked alerts within the time range.
     Used by the banner "全部忽略 24 小时" to clear all visible alerts.
     """
-    from datetime import datetime
-
     client_ip = get_client_ip(request)
-    valid_types = {t.value for t in AckType}
-    ack_type_val = ack_type if ack_type in valid_types else AckType.DISMISS.value
-
-    expires_at = None
-    if ack_type_val == AckType.DISMISS.value:
-        expires_at = datetime.now() + timedelta(hours=_DISMISS_DEFAULT_HOURS)
-    elif ack_type_val == AckType.DEFERRED.value:
-        expires_at = datetime.now() + timedelta(hours=72)
-    elif ack_type_val == AckType.CONFIRMED_OK.value:
-        expires_at = datetime.now() + timedelta(hours=24)  # ack-all default 24h for confirmed_ok
+    ack_type_val = _normalize_ack_type(ack_type)
+    # ack-all default 24h for confirmed_ok
+    expires_at = _ack_expiry(ack_type_val, confirmed_ok_default=24)
 
-    # Find unacked alerts in time range
+    # Ack every unacked alert in the time range in one statement
     since = datetime.now() - timedelta(hours=hours)
-    ack_exists = exists().where(AlertAckModel.alert_id == AlertModel.id)
-    stmt = (
-        select(AlertModel.id)
-        .where(AlertModel.timestamp >= since)
-        .where(~ack_exists)
+    in_range = select(AlertModel.id).where(AlertModel.timestamp >= since)
+    result = await db.execute(
+        _ack_rows_from(in_range, client_ip, ack_type_val, expires_at,
+                       "", "Batch ack (ack-all-visible)")
+        .returning(AlertAckModel.alert_id)
     )
-    result = await db.execute(stmt)
-    unacked_ids = [row[0] for row in result.all()]
+    acked_ids = [row[0] for row in result.all()]
 
-    if not unacked_ids:
+    if not acked_ids:
         return {"acked_count": 0, "message": "No unacked alerts in range"}
 
-    created = []
-    for alert_id in unacked_ids:
-        ack = AlertAckModel(
-            alert_id=alert_id,
-            acked_by_ip=client_ip,
-            comment="",
-            ack_type=ack_type_val,
-            ack_expires_at=expires_at,
-            note="Batch ack (ack-all-visible)",
-        )
-        db.add(ack)
-        created.append(ack)
-
     await db.commit()
+    get_ack_expiry_scheduler().schedule(expires_at)
     try:
-        await _clear_acked_active_issues(db, unacked_ids)
+        await _clear_acked_active_issues(
+            db, {aid: (client_ip, expires_at) for aid in acked_ids}
+        )
     except Exception:
         logger.debug("Failed to clear active issues cache (non-critical)")
 
-    return {"acked_count": len(created), "message": f"Acknowledged {len(created)} alerts"}
+    return {"acked_count": len(acked_ids), "message": f"Acknowledged {len(acked_ids)} alerts"}
 
 
 @router.delete("/ack/{alert_id}")
@@ -199,6 +218,10 @@ async def unack_alert(
         )
     await db.delete(ack)
     await db.commit()
+    try:
+        await _clear_acked_active_issues(db, {alert_id: None})
+    except Exception:
+        logger.debug("Failed to restore active issues cache (non-critical)")
     return {"status": "unacknowledged", "alert_id": alert_id}
 
 
@@ -220,13 +243,19 @@ async def batch_undo_ack(
     """Batch revoke acknowledgements for multiple alerts."""
     if not body.alert_ids:
         return {"undone_count": 0, "message": "No alert IDs provided"}
-    result = await db.execute(delete(AlertAckModel).where(AlertAckModel.alert_id.in_(body.alert_ids)))
+    result = await db.execute(
+        delete(AlertAckModel)
+        .where(AlertAckModel.alert_id.in_(_id_set(body.alert_ids)))
+        .returning(AlertAckModel.alert_id)
+        .execution_options(synchronize_session=False)
+    )
+    undone_ids = [row[0] for row in result.all()]
     await db.commit()
-    undone = result.rowcount
+    undone = len(undone_ids)
     try:
-        await _clear_acked_active_issues(db, [])  # Cache invalidation not needed for undo
+        await _clear_acked_active_issues(db, dict.fromkeys(undone_ids))
     except Exception:
-        pass
+        logger.debug("Failed to restore active issues cache (non-critical)")
     return {"undone_count": undone, "message": f"Revoked {undone} acknowledgements"}
 
 
@@ -239,27 +268,26 @@ async def batch_modify_ack(
     """Batch change ack type for multiple alerts. Updates existing ack records."""
     if not body.alert_ids:
         return {"modified_count": 0, "message": "No alert IDs provided"}
-    valid_types = {t.value for t in AckType}
-    ack_type = body.new_ack_type if body.new_ack_type in valid_types else AckType.DISMISS.value
-    expires_at = None
-    if ack_type == AckType.DISMISS.value:
-        expires_at = datetime.now() + timedelta(hours=_DISMISS_DEFAULT_HOURS)
-    elif ack_type == AckType.DEFERRED.value:
-        hours = body.expires_hours or 72
-        expires_at = datetime.now() + timedelta(hours=hours)
-    elif ack_type == AckType.CONFIRMED_OK.value and body.expires_hours:
-        h = body.expires_hours
-        if h not in (2, 4, 6, 8, 12, 24):
-            h = 24
-        expires_at = datetime.now() + timedelta(hours=h)
+    ack_type = _normalize_ack_type(body.new_ack_type)
+    expires_at = _ack_expiry(ack_type, body.expires_hours)
 
     result = await db.execute(
         update(AlertAckModel)
-        .where(AlertAckModel.alert_id.in_(body.alert_ids))
+        .where(AlertAckModel.alert_id.in_(_id_set(body.alert_ids)))
         .values(ack_type=ack_type, ack_expires_at=expires_at)
+        .returning(AlertAckModel.alert_id, AlertAckModel.acked_by_ip)
+        .execution_options(synchronize_session=False)
     )
+    modified_rows = result.all()
     await db.commit()
-    modified = result.rowcount
+    get_ack_expiry_scheduler().schedule(expires_at)
+    modified = len(modified_rows)
+    try:
+        await _clear_acked_active_issues(
+            db, {aid: (ip, expires_at) for aid, ip in modified_rows}
+        )
+    except Exception:
+        logger.debug("Failed to clear active issues cache (non-critical)")
     return {"modified_count": modified, "message": f"Modified {modified} acknowledgements"}
 
 
@@ -296,56 +324,76 @@ async def get_alert_ack_details(
 # Helper: clear active issues from in-memory cache after ack
 # ---------------------------------------------------------------------------
 
-async def _clear_acked_active_issues(db: AsyncSession, acked_alert_ids: List[int]):
+async def _clear_acked_active_issues(
+    db: AsyncSession,
+    acks: Dict[int, Optional[Tuple[str, Optional[datetime]]]],
+):
     """
-    After acknowledging alerts, update matching entries in the in-memory
-    active_issues cache to mark them as suppressed (仍显示，灰色样式).
-    Fetches ack details (acked_by_ip, ack_expires_at, acked_by_nickname) and merges into issues.
+    After (un)acknowledging alerts, update matching entries in the in-memory
+    active_issues cache: acked alerts are marked suppressed (仍显示，灰色样式),
+    entries mapped to None (undo) lose their suppression.
+
+    ``acks`` maps alert_id -> (acked_by_ip, ack_expires_at) as written by the
+    bulk statement, so the whole batch costs one alert lookup, one nickname
+    lookup and a single pass over each affected array's issues.
     """
     from .arrays import _array_status_cache, _resolve_ips_to_nicknames
 
-    if not acked_alert_ids:
+    if not acks:
         return
 
-    # Fetch alert + ack info for acked alerts
     result = await db.execute(
-        select(
-            AlertModel.id,
-            AlertModel.array_id,
-            AlertModel.observer_name,
-            AlertAckModel.acked_by_ip,
-            AlertAckModel.ack_expires_at,
-        )
-        .join(AlertAckModel, AlertAckModel.alert_id == AlertModel.id)
-        .where(AlertModel.id.in_(acked_alert_ids))
+        select(AlertModel.id, AlertModel.array_id, AlertModel.observer_name)
+        .where(AlertModel.id.in_(_id_set(acks)))
     )
     rows = result.all()
-    ips = list({r[3] for r in rows if r[3]})
-    nick_map = await _resolve_ips_to_nicknames(db, ips)
-    ack_info = {
-        r[0]: {
-            'acked_by_ip': r[3],
-            'ack_expires_at': r[4].isoformat() if r[4] else None,
-            'acked_by_nickname': nick_map.get(r[3]) or None,
-        }
-        for r in rows
+    ips = list({ack[0] for ack in acks.values() if ack and ack[0]})
+    nick_map = await _resolve_ips_to_nicknames(db, ips) if ips else {}
+
+    # array_id -> ({alert_id: update}, {observer_name: update})
+    per_array: Dict[str, Tuple[Dict[int, dict], Dict[str, dict]]] = {}
+    for alert_id, array_id, observer_name in rows:
+        ack = acks.get(alert_id)
+        if ack is None:
+            change = {'suppressed': False, 'acked_by_ip': None,
+                      'ack_expires_at': None, 'acked_by_nickname': None}
+        else:
+            ip, expires_at = ack
+            change = {
+                'suppressed': True,
+                'acked_by_ip': ip,
+                'ack_expires_at': expires_at.isoformat() if expires_at else None,
+                'acked_by_nickname': nick_map.get(ip) or None,
+            }
+        by_id, by_observer = per_array.setdefault(array_id, ({}, {}))
+        by_id[alert_id] = change
+        by_observer.setdefault(observer_name, change)
+
+    # An undo only lifts an observer-level issue when no other ack on that
+    # observer is still in effect (ack rows are exactly the effective acks)
+    undone = {
+        (array_id, observer_name)
+        for array_id, (_, by_observer) in per_array.items()
+        for observer_name, change in by_observer.items()
+        if not change['suppressed']
     }
+    if undone:
+        result = await db.execute(
+            select(AlertModel.array_id, AlertModel.observer_name).distinct()
+            .join(AlertAckModel, AlertAckModel.alert_id == AlertModel.id)
+            .where(AlertModel.array_id.in_({a for a, _ in undone}))
+            .where(AlertModel.observer_name.in_({o for _, o in undone}))
+        )
+        for array_id, observer_name in result.all():
+            if (array_id, observer_name) in undone:
+                del per_array[array_id][1][observer_name]
 
-    for _id, array_id, observer_name, _, _ in rows:
+    for array_id, (by_id, by_observer) in per_array.items():
         status_obj = _array_status_cache.get(array_id)
         if not status_obj or not status_obj.active_issues:
             continue
-        info = ack_info.get(_id, {})
-        suppressed = {
-            'suppressed': True,
-            'acked_by_ip': info.get('acked_by_ip'),
-            'ack_expires_at': info.get('ack_expires_at'),
-            'acked_by_nickname': info.get('acked_by_nickname'),
-        }
         for issue in status_obj.active_issues:
-            if issue.get('alert_id') == _id:
-                issue.update(suppressed)
-                break
-            if not issue.get('alert_id') and issue.get('observer') == observer_name:
-                issue.update(suppressed)
-                break
+            alert_id = issue.get('alert_id')
+            change = by_id.get(alert_id) if alert_id else by_observer.get(issue.get('observer'))
+            if change:
+                issue.update(change)
@@ -10,10 +10,12 @@ import httpx
 from fastapi import APIRouter, Depends, HTTPException
 from pydantic import BaseModel
 from sqlalchemy import select
+from sqlalchemy.exc import IntegrityError
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..config import get_config
-from ..core.ai_service import interpret_alert, is_ai_available, _get_httpx_client_kwargs
+from ..core.ai_cache import interpretation_key
+from ..core.ai_service import get_http_client, interpret_alert, is_ai_available, reset_http_client
 from ..api.auth import require_admin
 from ..db.database import get_db
 from ..models.alert import AlertModel
@@ -131,6 +133,9 @@ async def update_ai_config(
         logger.error("Failed to save AI config: %s", e)
         raise HTTPException(status_code=500, detail=f"Failed to save config: {e}")
 
+    # Timeout / proxy mode are bound to the pooled client
+    await reset_http_client()
+
     return AIConfigResponse(
         enabled=config.ai.enabled,
         api_url=config.ai.api_url,
@@ -164,10 +169,9 @@ async def list_ai_models(admin: dict = Depends(require_admin)):
         headers["Authorization"] = f"Bearer {api_key}"
 
     try:
-        async with httpx.AsyncClient(timeout=10, **_get_httpx_client_kwargs()) as client:
-            resp = await client.get(models_url, headers=headers)
-            resp.raise_for_status()
-            data = resp.json()
+        resp = await get_http_client().get(models_url, headers=headers, timeout=10)
+        resp.raise_for_status()
+        data = resp.json()
 
         models = data.get("data", [])
         return [
@@ -193,7 +197,8 @@ async def interpret_alert_endpoint(
 ):
     """
     Get AI interpretation for an alert.
-    Returns cached result if available; otherwise calls AI API and caches.
+    Returns cached result if available (by alert_id, then by alert content);
+    otherwise calls AI API and caches.
     Returns 404 if alert not found. Returns 503 if AI unavailable and no cache.
     """
     alert_id = body.alert_id
@@ -216,14 +221,6 @@ async def interpret_alert_endpoint(
     if not alert:
         raise HTTPException(status_code=404, detail=f"Alert {alert_id} not found")
 
-    # 3. AI not available -> return 503 (graceful: frontend shows "暂不可用")
-    if not is_ai_available():
-        raise HTTPException(
-            status_code=503,
-            detail="AI service is not available. Enable it in config and ensure API is reachable.",
-        )
-
-    # 4. Call AI
     details = {}
     if alert.details:
         try:
@@ -231,6 +228,35 @@ async def interpret_alert_endpoint(
         except (json.JSONDecodeError, TypeError):
             pass
 
+    config = get_config()
+    content_key = interpretation_key(
+        config.ai.model, alert.observer_name, alert.level, alert.message or "", details,
+    )
+
+    # 3. Another alert with the same content was already interpreted
+    result = await db.execute(
+        select(AIInterpretationModel)
+        .where(AIInterpretationModel.content_key == content_key)
+        .order_by(AIInterpretationModel.id.desc())
+        .limit(1)
+    )
+    shared = result.scalar_one_or_none()
+    if shared:
+        await _save_interpretation(db, alert_id, content_key, shared.interpretation, shared.model_name)
+        return InterpretAlertResponse(
+            interpretation=shared.interpretation,
+            cached=True,
+            model_name=shared.model_name or None,
+        )
+
+    # 4. AI not available -> return 503 (graceful: frontend shows "暂不可用")
+    if not is_ai_available():
+        raise HTTPException(
+            status_code=503,
+            detail="AI service is not available. Enable it in config and ensure API is reachable.",
+        )
+
+    # 5. Call AI (in-memory content cache + coalescing of concurrent identical alerts)
     interpretation = await interpret_alert(
         observer_name=alert.observer_name,
         level=alert.level,
@@ -244,18 +270,27 @@ async def interpret_alert_endpoint(
             detail="AI interpretation failed. API may be unreachable or returned an error.",
         )
 
-    # 5. Cache result
-    config = get_config()
-    ai_record = AIInterpretationModel(
-        alert_id=alert_id,
-        interpretation=interpretation,
-        model_name=config.ai.model,
-    )
-    db.add(ai_record)
-    await db.commit()
+    # 6. Cache result
+    await _save_interpretation(db, alert_id, content_key, interpretation, config.ai.model)
 
     return InterpretAlertResponse(
         interpretation=interpretation,
         cached=False,
         model_name=config.ai.model,
     )
+
+
+async def _save_interpretation(
+    db: AsyncSession, alert_id: int, content_key: str, interpretation: str, model_name: str,
+):
+    """Persist an interpretation for alert_id; a concurrent insert for the same alert wins."""
+    db.add(AIInterpretationModel(
+        alert_id=alert_id,
+        content_key=content_key,
+        interpretation=interpretation,
+        model_name=model_name or "",
+    ))
+    try:
+        await db.commit()
+    except IntegrityError:
+        await db.rollback()
@@ -9,18 +9,22 @@ import logging
 from datetime import datetime, timedelta
 from typing import List, Optional
 
-from fastapi import APIRouter, Depends, HTTPException, Query
+from fastapi import APIRouter, Depends, HTTPException, Query, Request
 from fastapi.responses import StreamingResponse
 from sqlalchemy import select
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..core.alert_store import get_alert_store, AlertStore
+from ..core.response_cache import get_response_cache
 from ..db.database import get_db
 from ..models.alert import AlertResponse, AlertStats, AlertLevel
 
 logger = logging.getLogger(__name__)
 router = APIRouter(prefix="/alerts", tags=["alerts"])
 
+# Tables the cached dashboard alert responses are derived from
+_ALERT_TABLES = ("alerts", "alert_acknowledgements")
+
 
 @router.get("")
 async def list_alerts(
@@ -111,21 +115,35 @@ async def list_alerts(
 
 @router.get("/stats", response_model=AlertStats)
 async def get_alert_stats(
+    request: Request,
     hours: int = Query(24, description="Time range in hours"),
     db: AsyncSession = Depends(get_db),
 ):
-    """Get alert statistics"""
+    """Get alert statistics (ETag-cached until the alerts table changes)"""
     store = get_alert_store()
-    return await store.get_stats(db, hours=hours)
+
+    async def build():
+        return await store.get_stats(db, hours=hours)
+
+    return await get_response_cache().serve(request, _ALERT_TABLES, build)
 
 
 @router.get("/recent")
 async def get_recent_alerts(
+    request: Request,
     limit: int = Query(20, ge=1, le=100),
     hours: int = Query(2, ge=1, le=168, description="Only return alerts within this many hours"),
     db: AsyncSession = Depends(get_db),
 ):
     """Get most recent alerts for dashboard"""
+    return await get_response_cache().serve(
+        request,
+        _ALERT_TABLES + ("arrays", "baseline_stats"),
+        lambda: _build_recent_alerts(db, limit, hours),
+    )
+
+
+async def _build_recent_alerts(db: AsyncSession, limit: int, hours: int):
     store = get_alert_store()
     
     alerts = await store.get_alerts(
@@ -181,6 +199,7 @@ async def get_recent_alerts(
 
 @router.get("/aggregated")
 async def get_aggregated_alerts(
+    request: Request,
     array_id: Optional[str] = Query(None),
     hours: int = Query(24, ge=1, le=168),
     limit: int = Query(200, ge=1, le=1000),
@@ -190,6 +209,14 @@ async def get_aggregated_alerts(
     Get alerts with aggregation (time-window, root-cause, storm detection).
     Returns a mix of individual and grouped alerts.
     """
+    return await get_response_cache().serve(
+        request,
+        _ALERT_TABLES + ("arrays",),
+        lambda: _build_aggregated_alerts(db, array_id, hours, limit),
+    )
+
+
+async def _build_aggregated_alerts(db: AsyncSession, array_id: Optional[str], hours: int, limit: int):
     from ..core.alert_aggregator import aggregate_alerts
     store = get_alert_store()
     start_time = datetime.now() - timedelta(hours=hours)
@@ -126,7 +126,6 @@ async def _auto_ack_new_alerts(
         return
 
     from sqlalchemy import func
-    now = datetime.now()
 
     confirmed_result = await db.execute(
         select(AlertModel.observer_name).distinct()
@@ -149,7 +148,8 @@ async def _auto_ack_new_alerts(
         .where(
             AlertModel.array_id == array_id,
             AlertAckModel.ack_type == "dismiss",
-            AlertAckModel.ack_expires_at > now,
+            # Lapsed acks are deleted by core/ack_expiry.py, so every row is in effect
+            AlertAckModel.ack_expires_at.isnot(None),
         )
         .group_by(AlertModel.observer_name)
     )
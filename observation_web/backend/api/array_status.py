@@ -15,13 +15,14 @@ from collections import defaultdict
 from datetime import datetime
 from typing import Any, Dict, List, Optional
 
-from fastapi import APIRouter, Depends, HTTPException, Query, status as http_status
+from fastapi import APIRouter, Depends, HTTPException, Query, Request, status as http_status
 from pydantic import BaseModel
 from sqlalchemy import select, func
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..db.database import get_db
 from ..core.ssh_pool import get_ssh_pool, SSHPool
+from ..core.response_cache import ARRAY_STATUS_STATE, get_response_cache
 from ..models.array import ArrayModel, ArrayStatus, ConnectionState
 from ..models.alert import AlertModel, AlertAckModel
 from ..models.user_session import UserSessionModel
@@ -36,6 +37,12 @@ status_router = APIRouter()
 
 _array_status_cache: Dict[str, ArrayStatus] = {}
 
+# GET /arrays/statuses is cached until one of these changes.  Runtime status
+# pushed over the WebSocket bumps ARRAY_STATUS_STATE; transport state and
+# heartbeat age drift silently, hence the short max age.
+_STATUS_TABLES = ("arrays", "tags", "alerts", "alert_acknowledgements", ARRAY_STATUS_STATE)
+STATUSES_CACHE_MAX_AGE = 10.0
+
 
 def _get_array_status(array_id: str) -> ArrayStatus:
     """Get or create array status from the in-memory cache."""
@@ -653,11 +660,21 @@ async def search_arrays(
 
 @status_router.get("/statuses", response_model=List[ArrayStatus])
 async def list_array_statuses(
+    request: Request,
     tag_id: Optional[int] = Query(None, description="Filter by tag ID"),
     db: AsyncSession = Depends(get_db),
     ssh_pool: SSHPool = Depends(get_ssh_pool),
 ):
-    """Get all array statuses with connection state"""
+    """Get all array statuses with connection state (ETag-cached)"""
+    return await get_response_cache().serve(
+        request,
+        _STATUS_TABLES,
+        lambda: _build_array_statuses(db, ssh_pool, tag_id),
+        max_age=STATUSES_CACHE_MAX_AGE,
+    )
+
+
+async def _build_array_statuses(db: AsyncSession, ssh_pool: SSHPool, tag_id: Optional[int]) -> List[ArrayStatus]:
     from ..models.tag import TagModel
 
     query = select(ArrayModel)
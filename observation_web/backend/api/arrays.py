@@ -13,6 +13,7 @@ Backward-compat re-exports are at the bottom so existing importers
 import asyncio
 import json
 import logging
+import posixpath
 import uuid
 from datetime import datetime
 from typing import Any, Dict, List, Optional
@@ -25,6 +26,7 @@ from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..config import get_config
 from ..core.agent_deployer import AgentDeployer
+from ..core.downsample import MAX_CHART_POINTS, minmax_rows
 from ..core.ssh_pool import get_ssh_pool, SSHPool
 from ..core.system_alert import sys_error, sys_info
 from ..db.database import get_db, AsyncSessionLocal
@@ -819,25 +821,39 @@ async def disconnect_array(
 # Metrics
 # ---------------------------------------------------------------------------
 
-@router.get("/{array_id}/metrics")
-async def get_array_metrics(
-    array_id: str,
-    minutes: int = Query(60, description="Time range in minutes"),
-    ssh_pool: SSHPool = Depends(get_ssh_pool),
-):
-    """Get performance metrics (CPU, memory) from the remote array."""
-    from .ingest import get_metrics_for_ip
+# Metric columns whose extremes must survive decimation
+METRIC_VALUE_KEYS = ('cpu0', 'mem_used_mb')
+
+
+async def _query_agent_metrics(conn, minutes: int) -> Optional[List[Dict[str, Any]]]:
+    """Fetch the last ``minutes`` of metrics from the agent's ring buffer.
+
+    Returns None when the agent cannot answer (older agent without the query
+    tool, ring not created yet) so the caller can fall back to metrics.jsonl.
+    """
+    config = get_config()
+    ring_path = config.remote.agent_log_path.replace('alerts.log', 'metrics.ring')
+    deploy_parent = posixpath.dirname(config.remote.agent_deploy_path)
+    exit_code, content, _ = await _run_blocking(
+        conn.execute, 12,
+        f"cd {deploy_parent} && {config.remote.python_cmd} -m observation_points.query "
+        f"--path {ring_path} --since {int(minutes) * 60} --format records 2>/dev/null",
+        timeout=10,
+    )
+    if exit_code != 0 or not content or not content.strip():
+        return None
+    try:
+        records = json.loads(content)["records"]
+    except (ValueError, KeyError, TypeError):
+        return None
+    return records if isinstance(records, list) else None
 
-    conn = ssh_pool.get_connection(array_id)
-    if not conn or not conn.is_connected():
-        raise HTTPException(
-            status_code=status.HTTP_400_BAD_REQUEST,
-            detail="Array not connected",
-        )
 
+async def _tail_agent_metrics(conn, minutes: int, max_lines: Optional[int]) -> List[Dict[str, Any]]:
+    """Parse the tail of the agent's metrics.jsonl."""
     config = get_config()
     metrics_path = config.remote.agent_log_path.replace('alerts.log', 'metrics.jsonl')
-    lines_needed = min(minutes * 6, 2000)
+    lines_needed = max_lines or min(minutes * 6, 2000)
     metrics = []
 
     exit_code, content, _ = await _run_blocking(
@@ -855,24 +871,72 @@ async def get_array_metrics(
                 metrics.append(record)
             except Exception:
                 pass
+    return metrics
 
-    for aid, conn_obj in ssh_pool._connections.items():
-        if aid == array_id:
-            pushed = get_metrics_for_ip(conn_obj.host, minutes)
-            if pushed:
-                metrics.extend(pushed)
-            break
+
+async def collect_array_metrics(
+    ssh_pool: SSHPool,
+    array_id: str,
+    minutes: int,
+    max_lines: Optional[int] = None,
+) -> Optional[List[Dict[str, Any]]]:
+    """
+    Merge the agent's recorded metrics with pushed metrics for the array.
+
+    Agent records come from the local time-series ring (one windowed query)
+    and fall back to tailing metrics.jsonl on agents without the query tool.
+    Returns records from the last ``minutes`` sorted by ``ts``, or None when
+    the array is not connected. Shared by the REST endpoint and the live
+    metrics stream.
+    """
+    from .ingest import get_metrics_for_ip
+
+    conn = ssh_pool.get_connection(array_id)
+    if not conn or not conn.is_connected():
+        return None
+
+    metrics = await _query_agent_metrics(conn, minutes)
+    if not metrics:
+        metrics = await _tail_agent_metrics(conn, minutes, max_lines)
+
+    pushed = get_metrics_for_ip(conn.host, minutes)
+    if pushed:
+        metrics.extend(pushed)
 
     metrics.sort(key=lambda m: m.get('ts', ''))
 
     from datetime import timedelta
     cutoff = (datetime.now() - timedelta(minutes=minutes)).isoformat()
-    metrics = [m for m in metrics if m.get('ts', '') >= cutoff]
+    return [m for m in metrics if m.get('ts', '') >= cutoff]
+
+
+@router.get("/{array_id}/metrics")
+async def get_array_metrics(
+    array_id: str,
+    minutes: int = Query(60, description="Time range in minutes"),
+    max_points: Optional[int] = Query(
+        None, ge=10, le=MAX_CHART_POINTS,
+        description="Point budget; longer series are min/max-decimated",
+    ),
+    ssh_pool: SSHPool = Depends(get_ssh_pool),
+):
+    """Get performance metrics (CPU, memory) from the remote array."""
+    metrics = await collect_array_metrics(ssh_pool, array_id, minutes)
+    if metrics is None:
+        raise HTTPException(
+            status_code=status.HTTP_400_BAD_REQUEST,
+            detail="Array not connected",
+        )
+
+    raw_count = len(metrics)
+    if max_points:
+        metrics = minmax_rows(metrics, max_points, METRIC_VALUE_KEYS)
 
     return {
         "array_id": array_id,
         "minutes": minutes,
         "count": len(metrics),
+        "raw_count": raw_count,
         "metrics": metrics,
     }
 
@@ -1,29 +1,54 @@
 """Card inventory API - cards synced from connected arrays."""
 
-import json
+import asyncio
 import logging
 import re
 from datetime import datetime
-from typing import List, Optional
+from typing import List, Optional, Tuple
 
 from fastapi import APIRouter, Depends, Query
 from sqlalchemy import select, text
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from ..core.card_inventory import apply_array_cards, prune_card_journal, token_range
 from ..db.database import get_db
-from ..models.card_inventory import CardInventoryModel, CardInventoryResponse, CardSyncResult
+from ..models.card_inventory import (
+    CardInventoryModel, CardInventoryResponse, CardJournalModel, CardJournalResponse, CardSyncResult,
+)
 
 logger = logging.getLogger(__name__)
 router = APIRouter(prefix="/card-inventory", tags=["card-inventory"])
 
+# Arrays queried over SSH at the same time during a sync
+CARD_SYNC_CONCURRENCY = 8
+
 
 @router.get("", response_model=List[CardInventoryResponse])
 async def list_cards(
     q: Optional[str] = Query(None, description="Multi-keyword fuzzy search"),
     db: AsyncSession = Depends(get_db),
 ):
-    """List card inventory with array info and optional multi-keyword search."""
-    sql = text("""
+    """List card inventory with array info and optional multi-keyword search.
+
+    Every keyword must occur in the card's model / board_id / card_no (via the
+    card_search_tokens index) or in its array's name / host.
+    """
+    keywords = [kw.lower() for kw in (q or "").split()]
+    conditions = []
+    params = {}
+    for i, kw in enumerate(keywords):
+        params[f"lo{i}"], params[f"hi{i}"] = token_range(kw)
+        params[f"kw{i}"] = kw
+        conditions.append(f"""ci.id IN (
+            SELECT card_id FROM card_search_tokens WHERE token >= :lo{i} AND token < :hi{i}
+            UNION
+            SELECT ci2.id FROM arrays a2 JOIN card_inventory ci2 ON ci2.array_id = a2.array_id
+            WHERE instr(lower(COALESCE(a2.name, '')), :kw{i}) > 0
+               OR instr(lower(COALESCE(a2.host, '')), :kw{i}) > 0
+        )""")
+    where = f"WHERE {' AND '.join(conditions)}" if conditions else ""
+
+    sql = text(f"""
         SELECT
             ci.id, ci.array_id, ci.card_no, ci.board_id,
             ci.health_state, ci.running_state, ci.model,
@@ -36,14 +61,14 @@ async def list_cards(
         LEFT JOIN arrays a ON ci.array_id = a.array_id
         LEFT JOIN tags t2 ON a.tag_id = t2.id
         LEFT JOIN tags t1 ON t2.parent_id = t1.id
+        {where}
         ORDER BY ci.array_id, ci.card_no
     """)
-    result = await db.execute(sql)
+    result = await db.execute(sql, params)
     rows = result.fetchall()
 
-    cards = []
-    for r in rows:
-        cards.append(CardInventoryResponse(
+    return [
+        CardInventoryResponse(
             id=r.id,
             array_id=r.array_id,
             card_no=r.card_no or "",
@@ -57,18 +82,9 @@ async def list_cards(
             array_host=r.array_host or "",
             tag_l1=r.tag_l1 or "",
             tag_l2=r.tag_l2 or "",
-        ))
-
-    if q and q.strip():
-        keywords = [kw.strip().lower() for kw in q.strip().split() if kw.strip()]
-
-        def matches(card):
-            searchable = f"{card.model} {card.board_id} {card.card_no} {card.array_name} {card.array_host}".lower()
-            return all(kw in searchable for kw in keywords)
-
-        cards = [c for c in cards if matches(c)]
-
-    return cards
+        )
+        for r in rows
+    ]
 
 
 @router.get("/last-sync")
@@ -83,17 +99,37 @@ async def get_last_sync(db: AsyncSession = Depends(get_db)):
     return {"last_sync": row.isoformat() if row else None}
 
 
+@router.get("/journal", response_model=List[CardJournalResponse])
+async def list_card_journal(
+    array_id: Optional[str] = Query(None),
+    since: Optional[datetime] = Query(None, description="Only changes after this time"),
+    limit: int = Query(200, ge=1, le=2000),
+    db: AsyncSession = Depends(get_db),
+):
+    """Card insert / remove / state-change journal, newest first."""
+    stmt = select(CardJournalModel)
+    if array_id:
+        stmt = stmt.where(CardJournalModel.array_id == array_id)
+    if since is not None:
+        stmt = stmt.where(CardJournalModel.changed_at > since)
+    stmt = stmt.order_by(CardJournalModel.changed_at.desc(), CardJournalModel.id.desc()).limit(limit)
+    result = await db.execute(stmt)
+    return result.scalars().all()
+
+
 @router.post("/sync", response_model=CardSyncResult)
 async def sync_cards(db: AsyncSession = Depends(get_db)):
-    """Sync card inventory from all connected arrays using SSH."""
+    """Sync card inventory from all connected arrays using SSH.
+
+    SSH queries fan out across arrays (at most CARD_SYNC_CONCURRENCY at a
+    time); each array's cards are then applied in one bulk upsert and
+    committed on their own, so one failing array does not undo the others.
+    """
     from ..core.ssh_pool import get_ssh_pool
     from ..models.array import ArrayModel
 
     ssh_pool = get_ssh_pool()
-    synced = 0
-    errors = []
-    skipped_arrays = []
-    synced_arrays = []
+    sync_result = CardSyncResult()
     start_work_enabled = False
 
     try:
@@ -106,104 +142,63 @@ async def sync_cards(db: AsyncSession = Depends(get_db)):
     except Exception:
         start_work_enabled = False
 
-    result = await db.execute(select(ArrayModel))
-    arrays = result.scalars().all()
+    # Plain tuples: ORM instances expire on commit and must not lazy-load later
+    result = await db.execute(select(ArrayModel.array_id, ArrayModel.name, ArrayModel.host))
+    arrays = result.all()
 
-    for array in arrays:
-        array_id = array.array_id
-        array_name = array.name
-        array_host = array.host
+    semaphore = asyncio.Semaphore(CARD_SYNC_CONCURRENCY)
+
+    async def fetch(array_id: str):
         conn = ssh_pool.get_connection(array_id)
         if not conn or not conn.is_connected():
-            errors.append(f"{array_name} ({array_host}): SSH 未连接，跳过卡件同步")
-            skipped_arrays.append(array_name)
-            continue
-        if start_work_enabled:
-            started = await _check_start_work(conn)
-            if not started:
-                errors.append(f"{array_name} ({array_host}): 阵列未开工，跳过卡件同步")
-                skipped_arrays.append(array_name)
-                continue
+            return None, "SSH 未连接，跳过卡件同步"
+        async with semaphore:
+            return await _fetch_array_cards(conn, start_work_enabled)
 
-        try:
-            cmd = "anytest intfboardallinfo"
-            exit_code, output, err_output = await conn.execute_async(cmd, 15)
-            if exit_code != 0:
-                errors.append(f"{array_name} ({array_host}): exit={exit_code}, {err_output[:200]}")
-                skipped_arrays.append(array_name)
-                continue
-            cards_data = _parse_card_output(output)
-
-            seen_board_ids = set()
-            batch_count = 0
-            for card_data in cards_data:
-                board_id = card_data.get("board_id", "")
-                card_no = card_data.get("card_no", "")
-
-                # Deduplicate by board_id within this sync batch
-                if board_id:
-                    if board_id in seen_board_ids:
-                        continue
-                    seen_board_ids.add(board_id)
-
-                # Primary lookup by (array_id, board_id) when board_id present
-                existing_card = None
-                if board_id:
-                    result_q = await db.execute(
-                        select(CardInventoryModel).where(
-                            CardInventoryModel.array_id == array_id,
-                            CardInventoryModel.board_id == board_id,
-                        )
-                    )
-                    existing_card = result_q.scalar_one_or_none()
-
-                # Fallback to (array_id, card_no)
-                if not existing_card and card_no:
-                    result_q = await db.execute(
-                        select(CardInventoryModel).where(
-                            CardInventoryModel.array_id == array_id,
-                            CardInventoryModel.card_no == card_no,
-                        )
-                    )
-                    existing_card = result_q.scalar_one_or_none()
-
-                now = datetime.now()
-                if existing_card:
-                    existing_card.card_no = card_no
-                    existing_card.board_id = board_id
-                    existing_card.health_state = card_data.get("health_state", "")
-                    existing_card.running_state = card_data.get("running_state", "")
-                    existing_card.model = card_data.get("model", "")
-                    existing_card.raw_fields = json.dumps(card_data.get("raw_fields", {}))
-                    existing_card.last_updated = now
-                else:
-                    db.add(CardInventoryModel(
-                        array_id=array_id,
-                        card_no=card_no,
-                        board_id=board_id,
-                        health_state=card_data.get("health_state", ""),
-                        running_state=card_data.get("running_state", ""),
-                        model=card_data.get("model", ""),
-                        raw_fields=json.dumps(card_data.get("raw_fields", {})),
-                        last_updated=now,
-                    ))
-                batch_count += 1
+    fetched = await asyncio.gather(*[fetch(a.array_id) for a in arrays])
 
+    for (array_id, array_name, array_host), (cards_data, error) in zip(arrays, fetched):
+        if error is not None:
+            sync_result.errors.append(f"{array_name} ({array_host}): {error}")
+            sync_result.skipped_arrays.append(array_name)
+            continue
+        try:
+            applied = await apply_array_cards(db, array_id, cards_data)
             await db.commit()
-            synced += batch_count
-            synced_arrays.append(array_name)
         except Exception as e:
             await db.rollback()
-            errors.append(f"{array_name} ({array_host}): {str(e)}")
-            skipped_arrays.append(array_name)
+            sync_result.errors.append(f"{array_name} ({array_host}): {str(e)}")
+            sync_result.skipped_arrays.append(array_name)
             logger.warning("Card sync failed for %s: %s", array_name, e)
+            continue
+        sync_result.synced += applied.synced
+        sync_result.inserted += applied.inserted
+        sync_result.removed += applied.removed
+        sync_result.state_changed += applied.state_changed
+        sync_result.synced_arrays.append(array_name)
 
-    return CardSyncResult(
-        synced=synced,
-        errors=errors,
-        skipped_arrays=skipped_arrays,
-        synced_arrays=synced_arrays,
-    )
+    try:
+        await prune_card_journal(db)
+        await db.commit()
+    except Exception as e:
+        await db.rollback()
+        logger.warning("Card journal pruning failed: %s", e)
+
+    return sync_result
+
+
+async def _fetch_array_cards(conn, start_work_enabled: bool) -> Tuple[Optional[List[dict]], Optional[str]]:
+    """Query and parse one array's cards. Returns (cards, None) or (None, error)."""
+    try:
+        if start_work_enabled and not await _check_start_work(conn):
+            return None, "阵列未开工，跳过卡件同步"
+        exit_code, output, err_output = await conn.execute_async("anytest intfboardallinfo", 15)
+        if exit_code != 0:
+            return None, f"exit={exit_code}, {err_output[:200]}"
+        return _parse_card_output(output), None
+    except Exception as e:
+        logger.warning("Card query failed: %s", e)
+        return None, str(e)
 
 
 # Regex for agent-style output: "No001  BoardId: xxxx" (card prefix + field: value)
@@ -8,6 +8,7 @@ Handles:
 """
 
 import logging
+from datetime import datetime
 from typing import List, Optional
 
 from fastapi import APIRouter, Depends, HTTPException, Query
@@ -136,10 +137,18 @@ async def get_archive_stats(
 async def query_archive(
     array_id: Optional[str] = Query(None),
     year_month: Optional[str] = Query(None, description="Format: YYYY-MM"),
+    observer_name: Optional[str] = Query(None),
+    level: Optional[str] = Query(None),
+    start: Optional[datetime] = Query(None),
+    end: Optional[datetime] = Query(None),
+    offset: int = Query(0, ge=0),
     limit: int = Query(500, ge=1, le=5000),
     db: AsyncSession = Depends(get_db),
 ):
-    """Query archived alerts"""
+    """Query archived alerts, newest first"""
     manager = get_lifecycle_manager()
-    alerts = await manager.query_archive(db, array_id, year_month)
-    return alerts[:limit]
+    return await manager.query_archive(
+        db, array_id, year_month,
+        observer_name=observer_name, level=level,
+        start=start, end=end, offset=offset, limit=limit,
+    )
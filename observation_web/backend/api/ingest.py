@@ -13,10 +13,12 @@ from collections import deque
 from datetime import datetime
 from typing import Any, Dict, List, Optional
 
-from fastapi import APIRouter, Depends, HTTPException, Request
+from fastapi import APIRouter, Depends, HTTPException, Request, Response
 from pydantic import BaseModel
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from ..config import get_config
+from ..core.event_pipeline import RateCounter
 from ..core.system_alert import sys_info, sys_error
 from ..db.database import get_db
 
@@ -28,6 +30,25 @@ router = APIRouter(tags=["ingest"])
 MAX_METRICS_PER_ARRAY = 8640  # 24h * 60min * 6 (every 10s) = ~8640 points per day
 _metrics_store: Dict[str, deque] = {}
 
+# Back-pressure signal returned on every ingest response. Agents aggregate
+# metrics harder (2^level wider deadbands / windows / heartbeats) while the
+# fleet-wide metrics push rate stays above remote.ingest_pressure_rate.
+INGEST_PRESSURE_HEADER = "X-Ingest-Pressure"
+MAX_INGEST_PRESSURE = 3
+_metrics_rate = RateCounter()
+
+
+def ingest_pressure_level() -> int:
+    """0 below the configured rate, then one level per doubling (max 3)."""
+    limit = get_config().remote.ingest_pressure_rate
+    if limit <= 0:
+        return 0
+    rate = _metrics_rate.total()
+    level = 0
+    while level < MAX_INGEST_PRESSURE and rate >= limit * (2 ** level):
+        level += 1
+    return level
+
 
 class IngestPayload(BaseModel):
     """Payload from agent push"""
@@ -78,6 +99,7 @@ def _resolve_array_id(payload_array_id: Optional[str], source_ip: str) -> Option
 async def ingest_data(
     payload: IngestPayload,
     request: Request,
+    response: Response,
     db: AsyncSession = Depends(get_db),
 ):
     """
@@ -91,6 +113,8 @@ async def ingest_data(
     if payload.type == "alert":
         return await _handle_alert(payload, source_ip, db)
     elif payload.type == "metrics":
+        _metrics_rate.add()
+        response.headers[INGEST_PRESSURE_HEADER] = str(ingest_pressure_level())
         return await _handle_metrics(payload, source_ip)
     else:
         raise HTTPException(status_code=400, detail=f"Unknown type: {payload.type}")
@@ -99,6 +123,7 @@ async def ingest_data(
 @router.post("/ingest/batch")
 async def ingest_batch(
     request: Request,
+    response: Response,
     db: AsyncSession = Depends(get_db),
 ):
     """
@@ -125,6 +150,9 @@ async def ingest_batch(
         except Exception:
             results["errors"] += 1
     
+    if results["metrics"]:
+        _metrics_rate.add(results["metrics"])
+        response.headers[INGEST_PRESSURE_HEADER] = str(ingest_pressure_level())
     return results
 
 
@@ -0,0 +1,248 @@
+"""
+Live data streams for the status WebSocket.
+
+Replaces per-viewer frontend polling (PerformanceMonitor 15 s, PortTrafficChart
+30 s, LogViewer 5 s) with server-side pollers shared through StreamHub:
+
+- metrics  {array_id}                     — new metrics.jsonl / pushed records
+- traffic  {array_id, port?}              — new traffic.jsonl samples (ingested once)
+- log      {array_id, file_path, keyword?} — lines appended to a remote log file
+
+Each fetcher keeps its own cursor and returns only items newer than the
+previous call; clients load history through the REST endpoints first.
+"""
+
+import json
+import logging
+import shlex
+from datetime import datetime
+from typing import Any, Dict, List, Optional
+
+from ..config import get_config
+from ..core.ssh_pool import get_ssh_pool
+from ..core.stream_hub import StreamHub, StreamSpec, get_stream_hub
+from ..core.traffic_store import get_traffic_store
+from ..db import database as _db_module
+
+logger = logging.getLogger(__name__)
+
+METRICS_INTERVAL = 15
+TRAFFIC_INTERVAL = 30
+LOG_INTERVAL = 5
+
+# Lines read per metrics poll; covers one interval at any agent sample rate we ship
+METRICS_TAIL_LINES = 60
+# traffic.jsonl lines read per poll (same window as POST /traffic/{id}/sync)
+TRAFFIC_TAIL_LINES = 200
+# Max bytes of a log file shipped per poll
+LOG_MAX_CHUNK = 256 * 1024
+
+_registered = False
+
+
+def _require(params: Dict[str, Any], *keys: str):
+    for key in keys:
+        if not params.get(key):
+            raise ValueError(f"Missing stream parameter: {key}")
+
+
+# ── metrics ───────────────────────────────────────────────────
+
+def _make_metrics_fetcher(params: Dict[str, Any]):
+    from .arrays import collect_array_metrics
+
+    array_id = params["array_id"]
+    cursor = {"ts": datetime.now().isoformat()}
+
+    async def fetch() -> List[Dict[str, Any]]:
+        records = await collect_array_metrics(
+            get_ssh_pool(), array_id, minutes=5, max_lines=METRICS_TAIL_LINES,
+        )
+        if not records:
+            return []
+        new = [r for r in records if r.get("ts", "") > cursor["ts"]]
+        if new:
+            cursor["ts"] = new[-1].get("ts", cursor["ts"])
+        return new
+
+    return fetch
+
+
+# ── traffic ───────────────────────────────────────────────────
+
+def _parse_ts(value: Any) -> Optional[datetime]:
+    if isinstance(value, str):
+        try:
+            return datetime.fromisoformat(value.replace('Z', ''))
+        except ValueError:
+            return None
+    return None
+
+
+def _make_traffic_fetcher(params: Dict[str, Any]):
+    array_id = params["array_id"]
+    state: Dict[str, Any] = {"cursors": None}
+
+    async def fetch() -> List[Dict[str, Any]]:
+        conn = get_ssh_pool().get_connection(array_id)
+        if not conn or not conn.is_connected():
+            return []
+
+        store = get_traffic_store()
+        if state["cursors"] is None:
+            async with _db_module.AsyncSessionLocal() as db:
+                state["cursors"] = await store.latest_timestamps(db, array_id)
+        cursors: Dict[str, datetime] = state["cursors"]
+
+        traffic_path = get_config().remote.agent_log_path.replace('alerts.log', 'traffic.jsonl')
+        exit_code, content, _ = await conn.execute_async(
+            f"tail -n {TRAFFIC_TAIL_LINES} {traffic_path} 2>/dev/null", timeout=10,
+        )
+        if exit_code != 0 or not content or not content.strip():
+            return []
+
+        new_records = []
+        for line in content.strip().split('\n'):
+            try:
+                rec = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+            ts = _parse_ts(rec.get('ts'))
+            port = rec.get('port', 'unknown')
+            if ts is None:
+                continue
+            last = cursors.get(port)
+            if last is not None and ts <= last:
+                continue
+            cursors[port] = ts
+            new_records.append(rec)
+
+        if not new_records:
+            return []
+
+        # Persist once for all viewers, so REST history stays complete
+        async with _db_module.AsyncSessionLocal() as db:
+            await store.ingest(db, array_id, new_records)
+
+        return [
+            {
+                'ts': _parse_ts(r.get('ts')).isoformat(),
+                'port': r.get('port', 'unknown'),
+                'tx_bytes': r.get('tx_bytes', 0),
+                'rx_bytes': r.get('rx_bytes', 0),
+                'tx_rate_bps': r.get('tx_rate_bps', 0.0) or 0.0,
+                'rx_rate_bps': r.get('rx_rate_bps', 0.0) or 0.0,
+                'mode': r.get('mode', 'auto'),
+                'protocol': r.get('protocol', 'ethernet'),
+            }
+            for r in sorted(new_records, key=lambda r: r.get('ts', ''))
+        ]
+
+    return fetch
+
+
+def _traffic_filter(params: Dict[str, Any]):
+    port = params.get("port")
+    if not port:
+        return None
+    return lambda item: item.get("port") == port
+
+
+# ── log ───────────────────────────────────────────────────────
+
+def _validate_log(params: Dict[str, Any]):
+    from .array_agent_ops import ALLOWED_LOG_PREFIXES
+
+    _require(params, "array_id", "file_path")
+    file_path = params["file_path"]
+    if ".." in file_path or not any(file_path.startswith(p) for p in ALLOWED_LOG_PREFIXES):
+        raise ValueError(f"Invalid file_path: must start with {ALLOWED_LOG_PREFIXES}")
+
+
+def _make_log_fetcher(params: Dict[str, Any]):
+    array_id = params["array_id"]
+    safe_path = shlex.quote(params["file_path"])
+    # offset: bytes already shipped; partial: trailing text without newline yet
+    state: Dict[str, Any] = {"offset": None, "partial": ""}
+
+    async def fetch() -> List[str]:
+        conn = get_ssh_pool().get_connection(array_id)
+        if not conn or not conn.is_connected():
+            return []
+
+        _, size_out, _ = await conn.execute_async(
+            f"stat --format='%s' {safe_path} 2>/dev/null || sudo -n stat --format='%s' {safe_path} 2>/dev/null",
+            timeout=5,
+        )
+        try:
+            size = int(size_out.strip().split()[0])
+        except (ValueError, IndexError, AttributeError):
+            return []
+
+        if state["offset"] is None:
+            # Start at the end; the viewer already loaded the tail via REST
+            state["offset"] = size
+            return []
+        if size < state["offset"]:
+            # Truncated / rotated — restart from the beginning of the new file
+            state["offset"] = 0
+            state["partial"] = ""
+        if size == state["offset"]:
+            return []
+
+        start = state["offset"] + 1
+        length = min(size - state["offset"], LOG_MAX_CHUNK)
+        cmd = (
+            f"(sudo -n tail -c +{start} {safe_path} 2>/dev/null || tail -c +{start} {safe_path} 2>/dev/null)"
+            f" | head -c {length}"
+        )
+        exit_code, chunk, _ = await conn.execute_async(cmd, timeout=10)
+        if exit_code != 0 and not chunk:
+            return []
+        state["offset"] += length
+
+        text = state["partial"] + (chunk or "")
+        lines = text.split('\n')
+        state["partial"] = lines.pop()
+        return [line for line in lines if line.strip()]
+
+    return fetch
+
+
+def _log_filter(params: Dict[str, Any]):
+    keyword = (params.get("keyword") or "").lower()
+    if not keyword:
+        return None
+    return lambda line: keyword in line.lower()
+
+
+def register_streams(hub: StreamHub):
+    hub.register_stream("metrics", StreamSpec(
+        topic=lambda p: p["array_id"],
+        make_fetcher=_make_metrics_fetcher,
+        interval=METRICS_INTERVAL,
+        validate=lambda p: _require(p, "array_id"),
+    ))
+    hub.register_stream("traffic", StreamSpec(
+        topic=lambda p: p["array_id"],
+        make_fetcher=_make_traffic_fetcher,
+        interval=TRAFFIC_INTERVAL,
+        make_filter=_traffic_filter,
+        validate=lambda p: _require(p, "array_id"),
+    ))
+    hub.register_stream("log", StreamSpec(
+        topic=lambda p: (p["array_id"], p["file_path"]),
+        make_fetcher=_make_log_fetcher,
+        interval=LOG_INTERVAL,
+        make_filter=_log_filter,
+        validate=_validate_log,
+    ))
+
+
+def ensure_streams_registered() -> StreamHub:
+    global _registered
+    hub = get_stream_hub()
+    if not _registered:
+        register_streams(hub)
+        _registered = True
+    return hub
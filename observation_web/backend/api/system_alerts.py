@@ -11,8 +11,10 @@ from typing import List, Optional
 from fastapi import APIRouter, Depends, Query
 
 from ..core.ssh_pool import get_ssh_pool, SSHPool
+from ..core.audit import get_audit_pipeline
 from ..core.system_alert import (
     AlertLevel,
+    get_http_event_pipeline,
     get_system_alert_store,
 )
 
@@ -45,6 +47,12 @@ async def get_stats():
     return store.get_stats()
 
 
+@router.get("/pipelines")
+async def get_pipeline_stats():
+    """Queue depth, write / drop counts and event rate of the async log pipelines"""
+    return [get_http_event_pipeline().stats(), get_audit_pipeline().stats()]
+
+
 @router.delete("")
 async def clear_alerts():
     """Clear all alerts"""
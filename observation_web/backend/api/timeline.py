@@ -5,15 +5,19 @@ Provides cross-observer, time-ordered events for the timeline visualization.
 Also returns active test task windows for background marking.
 """
 
+import base64
 import json
 import logging
+import time
+from collections import OrderedDict
 from datetime import datetime, timedelta
-from typing import List, Optional
+from typing import List, Optional, Tuple
 
-from fastapi import APIRouter, Depends, Query
-from sqlalchemy import select, and_
+from fastapi import APIRouter, Depends, HTTPException, Query
+from sqlalchemy import select, and_, func, tuple_
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from ..core.response_cache import get_response_cache
 from ..db.database import get_db
 from ..models.alert import AlertModel
 from ..models.task_session import TaskSessionModel
@@ -28,6 +32,45 @@ CATEGORIES = {
     'card': ['card_recovery', 'card_info', 'pcie_bandwidth', 'controller_state', 'disk_state'],
     'system': ['alarm_type', 'memory_leak', 'cpu_usage', 'cmd_response', 'sig_monitor', 'sensitive_info', 'process_crash', 'io_timeout'],
 }
+CATEGORY_LABELS = {'port': '端口级', 'card': '卡件级', 'system': '系统级'}
+# observer_name -> category, built once; unknown observers count as system
+OBSERVER_CATEGORY = {obs: cat for cat, observers in CATEGORIES.items() for obs in observers}
+
+# Window totals are reused while alerts is unchanged, for at most this long
+TOTAL_CACHE_MAX_AGE = 30.0
+TOTAL_CACHE_MAX_ENTRIES = 256
+_total_cache: "OrderedDict[Tuple, Tuple[Tuple[int, ...], float, int]]" = OrderedDict()
+
+
+def encode_cursor(timestamp: datetime, alert_id: int) -> str:
+    """Opaque keyset cursor for the row after which the next page starts"""
+    raw = f"{timestamp.isoformat()}|{alert_id}".encode()
+    return base64.urlsafe_b64encode(raw).decode().rstrip("=")
+
+
+def decode_cursor(cursor: str) -> Tuple[datetime, int]:
+    try:
+        raw = base64.urlsafe_b64decode(cursor + "=" * (-len(cursor) % 4)).decode()
+        ts, alert_id = raw.rsplit("|", 1)
+        return datetime.fromisoformat(ts), int(alert_id)
+    except Exception:
+        raise HTTPException(status_code=400, detail="Invalid cursor")
+
+
+async def _window_total(db: AsyncSession, key: Tuple, cond: List) -> int:
+    """COUNT over the window, cached per filter until alerts changes"""
+    versions = get_response_cache().versions(("alerts",))
+    now = time.monotonic()
+    cached = _total_cache.get(key)
+    if cached and cached[0] == versions and now - cached[1] < TOTAL_CACHE_MAX_AGE:
+        return cached[2]
+    result = await db.execute(select(func.count()).where(and_(*cond)))
+    total = result.scalar() or 0
+    _total_cache[key] = (versions, now, total)
+    _total_cache.move_to_end(key)
+    while len(_total_cache) > TOTAL_CACHE_MAX_ENTRIES:
+        _total_cache.popitem(last=False)
+    return total
 
 
 @router.get("/{array_id}")
@@ -37,13 +80,15 @@ async def get_timeline(
     observer: Optional[str] = Query(None),
     category: Optional[str] = Query(None),
     limit: int = Query(20, ge=1, le=500, description="Events per page"),
-    offset: int = Query(0, ge=0, description="Offset for pagination"),
+    cursor: Optional[str] = Query(None, description="next_cursor of the previous page"),
+    offset: int = Query(0, ge=0, description="Offset pagination (used only without cursor)"),
     db: AsyncSession = Depends(get_db),
 ):
     """
     Get timeline events for a specific array.
-    Returns events sorted by time, grouped by observer category.
-    Pagination: limit (default 20) per page, offset for page navigation.
+    Returns events sorted by time (newest first), grouped by observer category.
+    Pagination: pass the returned next_cursor to get the following page;
+    every page is a bounded scan of ix_alerts_timeline regardless of depth.
 
     - observer: exact observer_name match
     - category: port/card/system - filters by observer category (expands to observer_name.in_())
@@ -60,53 +105,53 @@ async def get_timeline(
     elif category and category in CATEGORIES:
         cond.append(AlertModel.observer_name.in_(CATEGORIES[category]))
 
-    # Total count
-    from sqlalchemy import func
-    count_result = await db.execute(
-        select(func.count(AlertModel.id)).where(and_(*cond))
+    total = await _window_total(
+        db, (array_id, hours, observer, category if category in CATEGORIES else None), cond
     )
-    total = count_result.scalar() or 0
 
-    # Fetch alerts with pagination
-    result = await db.execute(
-        select(AlertModel)
+    # Page keys come from the covering index; only the page rows are fetched
+    page_query = (
+        select(AlertModel.id)
         .where(and_(*cond))
-        .order_by(AlertModel.timestamp.desc())
-        .offset(offset)
+        .order_by(AlertModel.timestamp.desc(), AlertModel.id.desc())
         .limit(limit)
     )
-    alerts = result.scalars().all()
-
-    # Group by observer category
-    CATEGORY_LABELS = {'port': '端口级', 'card': '卡件级', 'system': '系统级'}
+    if cursor:
+        cursor_ts, cursor_id = decode_cursor(cursor)
+        page_query = page_query.where(
+            tuple_(AlertModel.timestamp, AlertModel.id) < tuple_(cursor_ts, cursor_id)
+        )
+    elif offset:
+        page_query = page_query.offset(offset)
 
-    def _get_category(obs_name):
-        for cat, observers in CATEGORIES.items():
-            if obs_name in observers:
-                return cat
-        return 'system'
+    result = await db.execute(
+        select(
+            AlertModel.id, AlertModel.timestamp, AlertModel.observer_name,
+            AlertModel.level, func.substr(AlertModel.message, 1, 120), AlertModel.task_id,
+        )
+        .where(AlertModel.id.in_(page_query.scalar_subquery()))
+        .order_by(AlertModel.timestamp.desc(), AlertModel.id.desc())
+    )
+    rows = result.all()
 
     events = []
-    for a in alerts:
-        cat = _get_category(a.observer_name)
-        det = {}
-        if a.details:
-            try:
-                det = json.loads(a.details) if isinstance(a.details, str) else a.details
-            except Exception:
-                det = {}
-
+    for alert_id, ts, observer_name, level, message, task_id in rows:
+        cat = OBSERVER_CATEGORY.get(observer_name, 'system')
         events.append({
-            'id': a.id,
-            'timestamp': a.timestamp.isoformat() if a.timestamp else '',
-            'observer_name': a.observer_name,
-            'level': a.level,
+            'id': alert_id,
+            'timestamp': ts.isoformat() if ts else '',
+            'observer_name': observer_name,
+            'level': level,
             'category': cat,
             'category_label': CATEGORY_LABELS.get(cat, cat),
-            'message': (a.message or '')[:120],
-            'task_id': a.task_id,
+            'message': message or '',
+            'task_id': task_id,
         })
 
+    next_cursor = None
+    if len(rows) == limit and rows[-1][1] is not None:
+        next_cursor = encode_cursor(rows[-1][1], rows[-1][0])
+
     # Fetch overlapping test tasks
     task_result = await db.execute(
         select(TaskSessionModel)
@@ -140,4 +185,5 @@ async def get_timeline(
         'events': events,
         'task_windows': task_windows,
         'total': total,
+        'next_cursor': next_cursor,
     }
@@ -18,7 +18,8 @@ from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..config import get_config
 from ..core.ssh_pool import get_ssh_pool, SSHPool
-from ..core.traffic_store import get_traffic_store
+from ..core.downsample import MAX_CHART_POINTS
+from ..core.traffic_store import get_traffic_store, MAX_QUERY_POINTS
 from ..core.system_alert import sys_error, sys_info
 from ..db.database import get_db
 
@@ -55,16 +56,21 @@ async def get_traffic_data(
     array_id: str,
     port: str = Query(..., description="Port name"),
     minutes: int = Query(30, ge=1, le=120, description="Time range (1-120 min)"),
+    max_points: int = Query(
+        MAX_QUERY_POINTS, ge=10, le=MAX_CHART_POINTS,
+        description="Point budget; longer series are min/max-decimated",
+    ),
     db: AsyncSession = Depends(get_db),
 ):
     """
     Query traffic data for a specific port.
 
     Returns time-series data points with TX/RX rates.
-    Max 120 minutes (2 hours).
+    Max 120 minutes (2 hours). Series longer than ``max_points`` are
+    decimated with per-bucket min/max so rate peaks remain visible.
     """
     store = get_traffic_store()
-    data = await store.query(db, array_id, port, minutes)
+    data = await store.query(db, array_id, port, minutes, max_points=max_points)
     return {
         "array_id": array_id,
         "port": port,
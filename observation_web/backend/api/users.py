@@ -7,7 +7,7 @@ No authentication required.
 
 import json
 import logging
-from datetime import datetime, timedelta
+from datetime import datetime
 from typing import List, Optional
 
 from fastapi import APIRouter, Depends, HTTPException, Request, status
@@ -25,7 +25,7 @@ from ..models.user_session import (
 )
 from ..models.array_lock import ArrayLockModel
 from ..models.user_preference import UserPreferenceModel
-from ..middleware.user_session import ip_to_color, get_all_presence
+from ..middleware.user_session import ip_to_color, get_presence_tracker
 from ..core.profanity import check_nickname
 
 logger = logging.getLogger(__name__)
@@ -58,42 +58,26 @@ ONLINE_THRESHOLD_MINUTES = 5
 
 
 @router.get("/online", response_model=List[OnlineUser])
-async def get_online_users(
-    db: AsyncSession = Depends(get_db),
-):
+async def get_online_users():
     """
     Get list of currently online users.
 
     Users are considered online if they have been active in the last 5 minutes.
+    Served from the in-memory presence index (no DB query).
     """
-    cutoff = datetime.now() - timedelta(minutes=ONLINE_THRESHOLD_MINUTES)
-
-    result = await db.execute(
-        select(UserSessionModel)
-        .where(UserSessionModel.last_seen >= cutoff)
-        .where(UserSessionModel.is_active == True)
-        .order_by(UserSessionModel.last_seen.desc())
-    )
-    sessions = result.scalars().all()
-
-    # Get current presence info
-    presence = get_all_presence()
-
-    users = []
-    for session in sessions:
-        viewing_page = None
-        if session.ip in presence:
-            viewing_page = presence[session.ip].get('page')
-
-        users.append(OnlineUser(
-            ip=session.ip,
-            nickname=session.nickname or "",
-            color=ip_to_color(session.ip),
-            last_seen=session.last_seen,
-            viewing_page=viewing_page,
-        ))
-
-    return users
+    tracker = get_presence_tracker()
+    active = tracker.active(ONLINE_THRESHOLD_MINUTES * 60)
+
+    return [
+        OnlineUser(
+            ip=ip,
+            nickname=tracker.get_nickname(ip),
+            color=ip_to_color(ip),
+            last_seen=info['timestamp'],
+            viewing_page=info['page'],
+        )
+        for ip, info in sorted(active.items(), key=lambda kv: kv[1]['timestamp'], reverse=True)
+    ]
 
 
 @router.get("/me", response_model=UserSessionResponse)
@@ -126,6 +110,7 @@ async def get_current_user(
         db.add(session)
         await db.commit()
         await db.refresh(session)
+    get_presence_tracker().set_nickname(user_ip, session.nickname)
 
     compliant, _ = check_nickname(session.nickname or "")
     return UserSessionResponse(
@@ -187,6 +172,7 @@ async def set_nickname(
 
     await db.commit()
     await db.refresh(session)
+    get_presence_tracker().set_nickname(user_ip, session.nickname)
 
     logger.info(f"User {user_ip} set nickname to '{session.nickname}'")
 
@@ -287,6 +273,10 @@ async def claim_nickname(
 
     await db.commit()
     await db.refresh(old_session)
+    # The old IP's row now belongs to new_ip; a pending flush must not recreate it
+    tracker = get_presence_tracker()
+    tracker.forget(old_ip)
+    tracker.set_nickname(new_ip, old_session.nickname)
 
     logger.info(f"User claimed nickname '{nickname}': {old_ip} -> {new_ip}")
 
@@ -379,21 +369,9 @@ async def update_my_preferences(
 
 
 @router.get("/count")
-async def get_user_count(
-    db: AsyncSession = Depends(get_db),
-):
+async def get_user_count():
     """
     Get count of online users.
     """
-    from sqlalchemy import func
-
-    cutoff = datetime.now() - timedelta(minutes=ONLINE_THRESHOLD_MINUTES)
-
-    result = await db.execute(
-        select(func.count(UserSessionModel.id))
-        .where(UserSessionModel.last_seen >= cutoff)
-        .where(UserSessionModel.is_active == True)
-    )
-    count = result.scalar() or 0
-
+    count = len(get_presence_tracker().active(ONLINE_THRESHOLD_MINUTES * 60))
     return {"online_count": count}
@@ -5,6 +5,7 @@ Features:
 - Message batching for high-frequency updates
 - Request deduplication for status updates
 - Connection health monitoring
+- Live data stream subscriptions on /ws/status (see api/streams.py)
 """
 
 import asyncio
@@ -24,6 +25,9 @@ router = APIRouter(tags=["websocket"])
 BATCH_INTERVAL_MS = 100  # Batch messages every 100ms
 MAX_BATCH_SIZE = 50  # Max messages per batch
 
+# Live stream subscriptions allowed per status connection
+MAX_STREAM_SUBSCRIPTIONS = 16
+
 
 class MessageBatcher:
     """Batches messages for efficient WebSocket transmission"""
@@ -250,12 +254,69 @@ async def websocket_alerts(websocket: WebSocket):
         await manager.disconnect(websocket, 'alerts')
 
 
+async def _handle_stream_message(websocket: WebSocket, data: dict, subscriptions: Dict[str, int]):
+    """
+    Handle subscribe / unsubscribe requests for live data streams.
+
+    Client -> server:
+        {"type": "subscribe", "sub_id": "c1", "stream": "metrics", "params": {...}}
+        {"type": "unsubscribe", "sub_id": "c1"}
+    Server -> client:
+        {"type": "subscribed", "sub_id": "c1"}
+        {"type": "stream_data", "sub_id": "c1", "stream": "metrics", "items": [...]}
+        {"type": "stream_error", "sub_id": "c1", "error": "..."}
+    """
+    from .streams import ensure_streams_registered
+    hub = ensure_streams_registered()
+
+    client_id = str(data.get('sub_id') or '')
+    if not client_id:
+        return
+
+    if data.get('type') == 'unsubscribe':
+        hub_id = subscriptions.pop(client_id, None)
+        if hub_id is not None:
+            await hub.unsubscribe(hub_id)
+        return
+
+    stream = data.get('stream') or ''
+    params = data.get('params') or {}
+    if client_id in subscriptions:
+        # Re-subscribe with new params replaces the old subscription
+        await hub.unsubscribe(subscriptions.pop(client_id))
+    if len(subscriptions) >= MAX_STREAM_SUBSCRIPTIONS:
+        await manager.send_personal(websocket, {
+            'type': 'stream_error', 'sub_id': client_id, 'error': 'Too many subscriptions',
+        })
+        return
+
+    async def deliver(items):
+        await manager.send_personal(websocket, {
+            'type': 'stream_data',
+            'sub_id': client_id,
+            'stream': stream,
+            'items': items,
+            'timestamp': datetime.now().isoformat(),
+        })
+
+    try:
+        subscriptions[client_id] = await hub.subscribe(stream, params, deliver)
+    except (ValueError, KeyError, TypeError) as e:
+        await manager.send_personal(websocket, {
+            'type': 'stream_error', 'sub_id': client_id, 'error': str(e),
+        })
+        return
+
+    await manager.send_personal(websocket, {'type': 'subscribed', 'sub_id': client_id})
+
+
 @router.websocket("/ws/status")
 async def websocket_status(websocket: WebSocket):
     """
-    WebSocket endpoint for array status updates.
+    WebSocket endpoint for array status updates and live data streams.
     """
     await manager.connect(websocket, 'status')
+    subscriptions: Dict[str, int] = {}  # client sub_id -> hub sub id
     
     try:
         await manager.send_personal(websocket, {
@@ -278,6 +339,8 @@ async def websocket_status(websocket: WebSocket):
                         'type': 'pong',
                         'timestamp': datetime.now().isoformat(),
                     })
+                elif data.get('type') in ('subscribe', 'unsubscribe'):
+                    await _handle_stream_message(websocket, data, subscriptions)
                     
             except asyncio.TimeoutError:
                 missed_heartbeats += 1
@@ -295,6 +358,11 @@ async def websocket_status(websocket: WebSocket):
     except WebSocketDisconnect:
         pass
     finally:
+        if subscriptions:
+            from .streams import ensure_streams_registered
+            hub = ensure_streams_registered()
+            for hub_id in subscriptions.values():
+                await hub.unsubscribe(hub_id)
         await manager.disconnect(websocket, 'status')
 
 
@@ -316,6 +384,10 @@ async def broadcast_status_update(array_id: str, status: dict):
     Broadcast array status update to all connected clients.
     Uses deduplication and throttling to reduce unnecessary updates.
     """
+    from ..core.response_cache import ARRAY_STATUS_STATE, get_response_cache
+    # Invalidate cached /arrays/statuses even when the push itself is throttled
+    get_response_cache().bump(ARRAY_STATUS_STATE)
+
     if not manager.should_send_status(array_id, status):
         return
 
@@ -327,6 +399,25 @@ async def broadcast_status_update(array_id: str, status: dict):
     })
 
 
+async def broadcast_ack_expired(array_id: str, alert_ids: List[int]):
+    """
+    Push re-surfaced alerts the moment their acknowledgement lapses.
+
+    Sent on the status channel together with the array's refreshed
+    active_issues so the banner un-greys without waiting for a poll.
+    """
+    from .arrays import _array_status_cache
+    status_obj = _array_status_cache.get(array_id)
+    payload = {
+        "array_id": array_id,
+        "event": "ack_expired",
+        "expired_alert_ids": alert_ids,
+    }
+    if status_obj is not None and status_obj.active_issues is not None:
+        payload["active_issues"] = status_obj.active_issues
+    await broadcast_status_update(array_id, payload)
+
+
 def get_manager() -> ConnectionManager:
     """Get the global connection manager"""
     return manager
@@ -45,6 +45,7 @@ class RemoteConfig:
     upload_staging_path: str = "/home/permitdir"   # Staging dir for SFTP uploads (permission workaround)
     auto_redeploy: bool = True                      # Auto-redeploy agent when it goes offline
     ingest_url: str = ""                            # URL for agent to push alerts (e.g. http://192.168.1.100:8001/api/ingest)
+    ingest_pressure_rate: int = 600                 # Pushed metrics/minute before agents are told to aggregate harder (0 = off)
 
 
 @dataclass
@@ -159,6 +160,7 @@ class AppConfig:
                 'upload_staging_path': self.remote.upload_staging_path,
                 'auto_redeploy': self.remote.auto_redeploy,
                 'ingest_url': getattr(self.remote, 'ingest_url', ''),
+                'ingest_pressure_rate': self.remote.ingest_pressure_rate,
             },
             'ai': {
                 'enabled': self.ai.enabled,
@@ -0,0 +1,153 @@
+"""
+Ack expiry scheduler.
+
+alert_acknowledgements holds only acks that are currently in effect: a
+timer wakes exactly when the earliest ack_expires_at lapses, deletes every
+ack that is due in one statement and pushes the re-surfaced alerts to the
+dashboard.  Read paths therefore treat "has an ack row" as "acknowledged"
+(an indexed lookup on alert_id) and never compare expiry with the clock.
+
+Writers call ``schedule(expires_at)`` after committing an ack so an earlier
+deadline wakes the timer; acks written elsewhere are still picked up by the
+periodic re-check (ACK_EXPIRY_MAX_SLEEP).
+"""
+
+import asyncio
+import logging
+from datetime import datetime
+from typing import Dict, List, Optional
+
+from sqlalchemy import delete, func, select
+
+logger = logging.getLogger(__name__)
+
+# Upper bound on a single sleep, so acks written without schedule() still lapse
+ACK_EXPIRY_MAX_SLEEP = 300.0
+# Slack added to a deadline so the row is strictly due when we wake
+_WAKE_SLACK = 0.05
+
+
+class AckExpiryScheduler:
+    """Single timer over the earliest pending ack_expires_at."""
+
+    def __init__(self, max_sleep: float = ACK_EXPIRY_MAX_SLEEP):
+        self.max_sleep = max_sleep
+        self._next_due: Optional[datetime] = None
+        self._wake: Optional[asyncio.Event] = None
+        self._task: Optional[asyncio.Task] = None
+        self.expired_total = 0
+
+    @property
+    def next_due(self) -> Optional[datetime]:
+        return self._next_due
+
+    def schedule(self, expires_at: Optional[datetime]):
+        """Register a new expiry; wakes the timer if it is earlier than the current one."""
+        if expires_at is None:
+            return
+        if self._next_due is None or expires_at < self._next_due:
+            self._next_due = expires_at
+            if self._wake is not None:
+                self._wake.set()
+
+    async def expire_due(self, now: Optional[datetime] = None) -> Dict[str, List[int]]:
+        """
+        Delete every ack whose expiry has passed and re-surface the alerts.
+        Returns {array_id: [alert_id, ...]} of the acks that lapsed.
+        """
+        from ..db.database import AsyncSessionLocal
+        if not AsyncSessionLocal:
+            return {}
+        async with AsyncSessionLocal() as session:
+            expired = await self._expire(session, now or datetime.now())
+        if expired:
+            await self._notify(expired)
+        return expired
+
+    async def _expire(self, session, now: datetime) -> Dict[str, List[int]]:
+        from ..models.alert import AlertAckModel, AlertModel
+
+        result = await session.execute(
+            delete(AlertAckModel)
+            .where(AlertAckModel.ack_expires_at.isnot(None))
+            .where(AlertAckModel.ack_expires_at <= now)
+            .returning(AlertAckModel.alert_id)
+            .execution_options(synchronize_session=False)
+        )
+        alert_ids = [row[0] for row in result.all()]
+
+        expired: Dict[str, List[int]] = {}
+        if alert_ids:
+            await session.commit()
+            self.expired_total += len(alert_ids)
+            from ..api.acknowledgements import _clear_acked_active_issues, _id_set
+            result = await session.execute(
+                select(AlertModel.id, AlertModel.array_id).where(AlertModel.id.in_(_id_set(alert_ids)))
+            )
+            for alert_id, array_id in result.all():
+                expired.setdefault(array_id, []).append(alert_id)
+            try:
+                await _clear_acked_active_issues(session, dict.fromkeys(alert_ids))
+            except Exception:
+                logger.debug("Failed to restore active issues cache (non-critical)")
+
+        result = await session.execute(select(func.min(AlertAckModel.ack_expires_at)))
+        self._next_due = result.scalar()
+        return expired
+
+    async def _notify(self, expired: Dict[str, List[int]]):
+        from ..api.websocket import broadcast_ack_expired
+        for array_id, alert_ids in expired.items():
+            try:
+                await broadcast_ack_expired(array_id, alert_ids)
+            except Exception as e:
+                logger.debug(f"Failed to broadcast ack expiry for {array_id}: {e}")
+        logger.info(f"Expired {sum(len(v) for v in expired.values())} alert acknowledgements")
+
+    def _sleep_seconds(self) -> float:
+        if self._next_due is None:
+            return self.max_sleep
+        remaining = (self._next_due - datetime.now()).total_seconds() + _WAKE_SLACK
+        return max(0.0, min(self.max_sleep, remaining))
+
+    async def _run(self):
+        while True:
+            try:
+                await self.expire_due()
+            except asyncio.CancelledError:
+                raise
+            except Exception as e:
+                logger.warning(f"Ack expiry pass failed: {e}")
+                # Retry soon without spinning on a persistent error
+                self._next_due = None
+                await asyncio.sleep(min(5.0, self.max_sleep))
+            self._wake.clear()
+            try:
+                await asyncio.wait_for(self._wake.wait(), timeout=self._sleep_seconds())
+            except asyncio.TimeoutError:
+                pass
+
+    def start(self):
+        if self._task is None or self._task.done():
+            self._wake = asyncio.Event()
+            self._task = asyncio.create_task(self._run())
+
+    async def stop(self):
+        if self._task:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        self._wake = None
+
+
+_scheduler: Optional[AckExpiryScheduler] = None
+
+
+def get_ack_expiry_scheduler() -> AckExpiryScheduler:
+    global _scheduler
+    if _scheduler is None:
+        _scheduler = AckExpiryScheduler()
+    return _scheduler
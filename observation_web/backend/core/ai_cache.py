@@ -0,0 +1,146 @@
+"""
+Content-keyed cache for AI alert interpretations.
+
+An alert storm produces thousands of alerts whose observer, level, message
+and details are identical apart from timestamps.  Interpretations are keyed
+on that normalized content (plus the model name), so one LLM round trip
+serves the whole storm:
+
+- entries expire after ``ttl`` seconds and the cache is LRU-bounded;
+- concurrent requests for the same key share one in-flight call.  The call
+  runs as its own task, so a cancelled caller does not abort it for others.
+"""
+
+import asyncio
+import hashlib
+import json
+import re
+import time
+from collections import OrderedDict
+from typing import Any, Awaitable, Callable, Dict, Optional, Tuple
+
+AI_CACHE_MAX_ENTRIES = 2048
+AI_CACHE_TTL_SECONDS = 24 * 3600
+
+# Tokens that differ between otherwise identical alerts of one storm
+_TIMESTAMP_RE = re.compile(r"\d{4}-\d{2}-\d{2}[ T]\d{2}:\d{2}:\d{2}(?:\.\d+)?(?:Z|[+-]\d{2}:?\d{2})?")
+_WHITESPACE_RE = re.compile(r"\s+")
+_VOLATILE_DETAIL_KEYS = frozenset({"timestamp", "ts", "time", "collected_at", "sample_time"})
+
+
+def _normalize_text(text: str) -> str:
+    return _WHITESPACE_RE.sub(" ", _TIMESTAMP_RE.sub("<ts>", text or "")).strip()
+
+
+def _normalize_details(details: Any) -> Any:
+    if isinstance(details, dict):
+        return {
+            k: _normalize_details(v)
+            for k, v in details.items()
+            if k not in _VOLATILE_DETAIL_KEYS
+        }
+    if isinstance(details, list):
+        return [_normalize_details(v) for v in details]
+    if isinstance(details, str):
+        return _normalize_text(details)
+    return details
+
+
+def interpretation_key(model: str, observer_name: str, level: str, message: str, details: Any) -> str:
+    """Stable hash of the alert content that determines its interpretation."""
+    payload = json.dumps(
+        [model or "", observer_name or "", level or "", _normalize_text(message),
+         _normalize_details(details or {})],
+        ensure_ascii=False, sort_keys=True, default=str,
+    )
+    return hashlib.sha256(payload.encode("utf-8")).hexdigest()
+
+
+class InterpretationCache:
+    """TTL + LRU cache with in-flight request coalescing."""
+
+    def __init__(
+        self,
+        max_entries: int = AI_CACHE_MAX_ENTRIES,
+        ttl: float = AI_CACHE_TTL_SECONDS,
+        clock: Callable[[], float] = time.monotonic,
+    ):
+        self.max_entries = max_entries
+        self.ttl = ttl
+        self._clock = clock
+        self._entries: "OrderedDict[str, Tuple[float, str]]" = OrderedDict()
+        self._inflight: Dict[str, asyncio.Future] = {}
+        self.hits = 0
+        self.misses = 0
+        self.coalesced = 0
+
+    def get(self, key: str) -> Optional[str]:
+        entry = self._entries.get(key)
+        if entry is None:
+            return None
+        expires_at, value = entry
+        if expires_at <= self._clock():
+            del self._entries[key]
+            return None
+        self._entries.move_to_end(key)
+        return value
+
+    def put(self, key: str, value: str):
+        self._entries[key] = (self._clock() + self.ttl, value)
+        self._entries.move_to_end(key)
+        while len(self._entries) > self.max_entries:
+            self._entries.popitem(last=False)
+
+    async def get_or_compute(
+        self,
+        key: str,
+        compute: Callable[[], Awaitable[Optional[str]]],
+    ) -> Optional[str]:
+        """
+        Return the cached value for ``key`` or run ``compute`` once for all
+        concurrent callers.  Empty / None results are not cached.
+        """
+        cached = self.get(key)
+        if cached is not None:
+            self.hits += 1
+            return cached
+
+        task = self._inflight.get(key)
+        if task is None:
+            self.misses += 1
+            task = asyncio.ensure_future(compute())
+            self._inflight[key] = task
+            task.add_done_callback(lambda t, k=key: self._on_done(k, t))
+        else:
+            self.coalesced += 1
+        return await asyncio.shield(task)
+
+    def _on_done(self, key: str, task: asyncio.Future):
+        self._inflight.pop(key, None)
+        if task.cancelled() or task.exception() is not None:
+            return
+        value = task.result()
+        if value:
+            self.put(key, value)
+
+    def clear(self):
+        self._entries.clear()
+
+    def stats(self) -> dict:
+        return {
+            "entries": len(self._entries),
+            "inflight": len(self._inflight),
+            "hits": self.hits,
+            "misses": self.misses,
+            "coalesced": self.coalesced,
+        }
+
+
+_cache: Optional[InterpretationCache] = None
+
+
+def get_interpretation_cache() -> InterpretationCache:
+    global _cache
+    if _cache is None:
+        _cache = InterpretationCache()
+    return _cache
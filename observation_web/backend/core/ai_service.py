@@ -6,11 +6,13 @@ Gracefully degrades when API is unavailable - never affects core functionality.
 
 import json
 import logging
+import re
 from typing import Optional
 
 import httpx
 
 from ..config import get_config
+from .ai_cache import get_interpretation_cache, interpretation_key
 
 logger = logging.getLogger(__name__)
 
@@ -44,6 +46,10 @@ LEVEL_NAMES = {
 }
 
 
+# Connections kept to the LLM endpoint by the shared client
+AI_MAX_CONNECTIONS = 8
+
+
 def _get_httpx_client_kwargs() -> dict:
     """Build httpx AsyncClient kwargs based on AI proxy mode."""
     config = get_config()
@@ -54,6 +60,36 @@ def _get_httpx_client_kwargs() -> dict:
     return {}
 
 
+_http_client: Optional[httpx.AsyncClient] = None
+
+
+def get_http_client() -> httpx.AsyncClient:
+    """
+    Long-lived pooled client for the AI API (keep-alive, TLS reuse).
+    Recreated after reset_http_client(), e.g. when timeout / proxy mode change.
+    """
+    global _http_client
+    if _http_client is None or _http_client.is_closed:
+        config = get_config()
+        _http_client = httpx.AsyncClient(
+            timeout=config.ai.timeout,
+            limits=httpx.Limits(
+                max_connections=AI_MAX_CONNECTIONS,
+                max_keepalive_connections=AI_MAX_CONNECTIONS,
+            ),
+            **_get_httpx_client_kwargs(),
+        )
+    return _http_client
+
+
+async def reset_http_client():
+    """Close the shared client; the next call builds one from current config."""
+    global _http_client
+    client, _http_client = _http_client, None
+    if client is not None and not client.is_closed:
+        await client.aclose()
+
+
 def _build_prompt(observer_name: str, level: str, message: str, details: dict) -> str:
     """Build the prompt for alert interpretation."""
     obs_cn = OBSERVER_NAMES.get(observer_name, observer_name)
@@ -87,7 +123,9 @@ async def interpret_alert(
     details: dict,
 ) -> Optional[str]:
     """
-    Call LLM API to interpret an alert. Returns None on any failure.
+    Interpret an alert, served from the content-keyed cache when possible.
+    Identical alerts (e.g. from a storm) share one LLM call, including
+    concurrent requests.  Returns None on any failure.
     Never raises - always degrades gracefully.
     """
     config = get_config()
@@ -95,6 +133,20 @@ async def interpret_alert(
         logger.debug("AI interpretation disabled in config")
         return None
 
+    key = interpretation_key(config.ai.model, observer_name, level, message, details)
+    return await get_interpretation_cache().get_or_compute(
+        key, lambda: _request_interpretation(observer_name, level, message, details),
+    )
+
+
+async def _request_interpretation(
+    observer_name: str,
+    level: str,
+    message: str,
+    details: dict,
+) -> Optional[str]:
+    """Single LLM round trip for interpret_alert. Never raises."""
+    config = get_config()
     api_url = config.ai.api_url
     api_key = config.ai.api_key
     model = config.ai.model
@@ -115,10 +167,9 @@ async def interpret_alert(
     }
 
     try:
-        async with httpx.AsyncClient(timeout=timeout, **_get_httpx_client_kwargs()) as client:
-            resp = await client.post(api_url, json=body, headers=headers)
-            resp.raise_for_status()
-            data = resp.json()
+        resp = await get_http_client().post(api_url, json=body, headers=headers)
+        resp.raise_for_status()
+        data = resp.json()
 
         # OpenAI-compatible response format
         choices = data.get("choices", [])
@@ -301,12 +352,9 @@ async def nl_to_observer_template(description: str) -> Optional[dict]:
     }
 
     try:
-        async with httpx.AsyncClient(
-            timeout=config.ai.timeout, **_get_httpx_client_kwargs()
-        ) as client:
-            resp = await client.post(config.ai.api_url, json=body, headers=headers)
-            resp.raise_for_status()
-            data = resp.json()
+        resp = await get_http_client().post(config.ai.api_url, json=body, headers=headers)
+        resp.raise_for_status()
+        data = resp.json()
 
         choices = data.get("choices", [])
         if not choices:
@@ -383,12 +431,9 @@ async def nl_to_sql(question: str) -> Optional[str]:
     }
 
     try:
-        async with httpx.AsyncClient(
-            timeout=config.ai.timeout, **_get_httpx_client_kwargs()
-        ) as client:
-            resp = await client.post(config.ai.api_url, json=body, headers=headers)
-            resp.raise_for_status()
-            data = resp.json()
+        resp = await get_http_client().post(config.ai.api_url, json=body, headers=headers)
+        resp.raise_for_status()
+        data = resp.json()
 
         choices = data.get("choices", [])
         if not choices:
@@ -2,17 +2,19 @@
 Alert expectation evaluation engine.
 
 Evaluates alerts against expectation rules to determine if they are "expected"
-based on the current test task type.
+based on the current test task type.  Rules are compiled into an indexed
+matcher (CompiledRuleSet) that is rebuilt only when the rules table changes.
 """
 
 import json
 import logging
 import re
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Dict, List, Optional, Tuple
 
 from sqlalchemy import select
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from .response_cache import get_response_cache
 from ..models.alert import AlertModel
 from ..models.alert_rule import AlertExpectationRuleModel, BUILTIN_RULES
 from ..models.task_session import TaskSessionModel
@@ -25,15 +27,154 @@ EXPECTED_YES = 1
 EXPECTED_NO = -1
 
 
+# Rule buckets memoized per (task_type, observer, level); observers are a
+# small fixed set, the bound only guards against junk observer names.
+MAX_BUCKETS = 4096
+
+# Patterns with backreferences or named groups can't be merged into one
+# alternation without changing their meaning.
+_UNMERGEABLE_RE = re.compile(r"\\\d|\(\?P[<=]")
+
+
+class _AnyOf:
+    """Fallback when patterns can't be joined (e.g. inline global flags)."""
+    __slots__ = ("patterns",)
+
+    def __init__(self, patterns: List["re.Pattern"]):
+        self.patterns = patterns
+
+    def search(self, text: str) -> bool:
+        return any(p.search(text) for p in self.patterns)
+
+
+def _compile_any(patterns: List[str]):
+    """One case-insensitive alternation for a pattern list; invalid ones skipped."""
+    valid = []
+    for pattern in patterns:
+        try:
+            valid.append(re.compile(pattern, re.IGNORECASE))
+        except re.error:
+            continue
+    if not valid:
+        return None
+    if len(valid) == 1:
+        return valid[0]
+    if any(_UNMERGEABLE_RE.search(p.pattern) for p in valid):
+        return _AnyOf(valid)
+    try:
+        return re.compile("|".join(f"(?:{p.pattern})" for p in valid), re.IGNORECASE)
+    except re.error:
+        return _AnyOf(valid)
+
+
+class _CompiledRule:
+    __slots__ = ("id", "observer_patterns", "levels", "message_re", "message_patterns", "never")
+
+    def __init__(self, rule: Dict):
+        self.id = rule['id']
+        self.observer_patterns = rule['observer_patterns']
+        self.levels = frozenset(rule['level_patterns']) if rule['level_patterns'] else None
+        self.message_patterns = rule['message_patterns']
+        self.message_re = _compile_any(rule['message_patterns']) if rule['message_patterns'] else None
+        # Message patterns given but none valid: the rule can never match
+        self.never = bool(rule['message_patterns']) and self.message_re is None
+
+    def matches_observer(self, observer: str) -> bool:
+        if not self.observer_patterns:
+            return True
+        for pattern in self.observer_patterns:
+            if pattern == observer:
+                return True
+            try:
+                if re.search(pattern, observer, re.IGNORECASE):
+                    return True
+            except re.error:
+                continue
+        return False
+
+
+class _Bucket:
+    """Candidate rules for one (task_type, observer, level), in priority order."""
+    __slots__ = ("rules", "prefilter")
+
+    def __init__(self, rules: List[_CompiledRule]):
+        self.rules = rules
+        self.prefilter = None
+        patterns = [p for r in rules if r.message_re is not None for p in r.message_patterns]
+        # Only worth it when every candidate needs a message match
+        if patterns and all(r.message_re is not None for r in rules):
+            if not any(_UNMERGEABLE_RE.search(p) for p in patterns):
+                self.prefilter = _compile_any(patterns)
+
+    def match(self, message: str) -> Optional[int]:
+        if self.prefilter is not None and not self.prefilter.search(message):
+            return None
+        for rule in self.rules:
+            if rule.message_re is None or rule.message_re.search(message):
+                return rule.id
+        return None
+
+
+class CompiledRuleSet:
+    """
+    Enabled rules compiled for lookup.
+
+    Rules are indexed by task type; per (task_type, observer, level) the
+    candidate list is resolved once and memoized, so an alert costs a dict
+    lookup plus at most one merged message regex scan in the common
+    "not expected" case instead of a pass over every rule.
+    """
+
+    def __init__(self, rules: List[Dict]):
+        self.rule_count = len(rules)
+        compiled = [_CompiledRule(r) for r in rules]
+        self._any_task: List[_CompiledRule] = []
+        self._by_task: Dict[str, List[_CompiledRule]] = {}
+        for rule, c in zip(rules, compiled):
+            if c.never:
+                continue
+            if rule['task_types']:
+                for task_type in rule['task_types']:
+                    self._by_task.setdefault(task_type, []).append(c)
+            else:
+                self._any_task.append(c)
+        self._order = {c.id: i for i, c in enumerate(compiled)}
+        self._buckets: Dict[Tuple[str, str, str], _Bucket] = {}
+
+    def _bucket(self, task_type: str, observer: str, level: str) -> _Bucket:
+        key = (task_type, observer, level)
+        bucket = self._buckets.get(key)
+        if bucket is None:
+            candidates = [
+                r for r in self._by_task.get(task_type, []) + self._any_task
+                if (r.levels is None or level in r.levels) and r.matches_observer(observer)
+            ]
+            candidates.sort(key=lambda r: self._order[r.id])
+            bucket = _Bucket(candidates)
+            if len(self._buckets) >= MAX_BUCKETS:
+                self._buckets.clear()
+            self._buckets[key] = bucket
+        return bucket
+
+    def match(self, task_type: str, observer: str, level: str, message: str) -> Optional[int]:
+        bucket = self._bucket(task_type, observer or '', level or '')
+        if not bucket.rules:
+            return None
+        return bucket.match(message or '')
+
+
 class AlertExpectationEngine:
     """Engine for evaluating alert expectations."""
 
     def __init__(self):
         self._rules_cache: List[Dict] = []
         self._cache_valid = False
+        self._compiled: Optional[CompiledRuleSet] = None
+        self._rules_version: Optional[Tuple[int, ...]] = None
 
     async def load_rules(self, db: AsyncSession) -> List[Dict]:
-        """Load all enabled rules from database."""
+        """Load all enabled rules from database and compile them."""
+        version = _table_version("alert_expectation_rules")
         result = await db.execute(
             select(AlertExpectationRuleModel)
             .where(AlertExpectationRuleModel.is_enabled == True)
@@ -53,6 +194,8 @@ class AlertExpectationEngine:
                 'priority': rule.priority,
             })
 
+        self._compiled = CompiledRuleSet(self._rules_cache)
+        self._rules_version = version
         self._cache_valid = True
         return self._rules_cache
 
@@ -69,6 +212,12 @@ class AlertExpectationEngine:
         """Invalidate the rules cache."""
         self._cache_valid = False
 
+    async def _ensure_compiled(self, db: AsyncSession) -> CompiledRuleSet:
+        # Committed writes to the rules table (from any path) also force a rebuild
+        if not self._cache_valid or self._rules_version != _table_version("alert_expectation_rules"):
+            await self.load_rules(db)
+        return self._compiled
+
     async def evaluate_alert(
         self,
         db: AsyncSession,
@@ -86,53 +235,17 @@ class AlertExpectationEngine:
         Returns:
             Tuple of (is_expected value, matched rule ID or None)
         """
-        if not self._cache_valid:
-            await self.load_rules(db)
+        compiled = await self._ensure_compiled(db)
 
         if not task_type:
             return EXPECTED_UNKNOWN, None
 
-        for rule in self._rules_cache:
-            if self._matches_rule(alert, rule, task_type):
-                return EXPECTED_YES, rule['id']
+        rule_id = compiled.match(task_type, alert.observer_name, alert.level, alert.message)
+        if rule_id is not None:
+            return EXPECTED_YES, rule_id
 
         return EXPECTED_UNKNOWN, None
 
-    def _matches_rule(self, alert: AlertModel, rule: Dict, task_type: str) -> bool:
-        """Check if an alert matches a rule."""
-        # Check task type
-        if rule['task_types'] and task_type not in rule['task_types']:
-            return False
-
-        # Check observer pattern
-        if rule['observer_patterns']:
-            observer_match = False
-            for pattern in rule['observer_patterns']:
-                if pattern == alert.observer_name or re.search(pattern, alert.observer_name, re.IGNORECASE):
-                    observer_match = True
-                    break
-            if not observer_match:
-                return False
-
-        # Check level pattern
-        if rule['level_patterns'] and alert.level not in rule['level_patterns']:
-            return False
-
-        # Check message pattern
-        if rule['message_patterns']:
-            message_match = False
-            for pattern in rule['message_patterns']:
-                try:
-                    if re.search(pattern, alert.message or '', re.IGNORECASE):
-                        message_match = True
-                        break
-                except re.error:
-                    continue
-            if not message_match:
-                return False
-
-        return True
-
     async def evaluate_alerts_batch(
         self,
         db: AsyncSession,
@@ -145,8 +258,7 @@ class AlertExpectationEngine:
         Returns:
             List of (alert_id, is_expected, matched_rule_id)
         """
-        if not self._cache_valid:
-            await self.load_rules(db)
+        await self._ensure_compiled(db)
 
         results = []
         for alert in alerts:
@@ -155,6 +267,11 @@ class AlertExpectationEngine:
         return results
 
 
+def _table_version(table: str) -> Tuple[int, ...]:
+    """Commit version of a table, tracked by the response cache session hooks."""
+    return get_response_cache().versions((table,))
+
+
 async def init_builtin_rules(db: AsyncSession):
     """Initialize built-in rules in database if not present."""
     for rule_data in BUILTIN_RULES:
@@ -2,6 +2,8 @@
 Audit logging service.
 
 Provides simple functions to log user operations for accountability.
+Entries are queued and batch-inserted by a background writer
+(core/event_pipeline.py), so logging never adds a DB write to the request.
 """
 
 import json
@@ -9,10 +11,12 @@ import logging
 from datetime import datetime, timedelta
 from typing import Any, Dict, List, Optional
 
-from sqlalchemy import select, delete as sa_delete
+from sqlalchemy import insert, select, delete as sa_delete
 from sqlalchemy.ext.asyncio import AsyncSession
 
+from ..db import database as _db_module
 from ..models.audit_log import AuditLogModel
+from .event_pipeline import EventPipeline
 
 logger = logging.getLogger(__name__)
 
@@ -26,8 +30,25 @@ def set_audit_enabled(enabled: bool):
     _audit_enabled = enabled
 
 
+async def _insert_audit_batch(rows: List[Dict[str, Any]]):
+    if _db_module.AsyncSessionLocal is None:
+        raise RuntimeError("database not initialized")
+    async with _db_module.AsyncSessionLocal() as db:
+        await db.execute(insert(AuditLogModel), rows)
+        await db.commit()
+
+
+_audit_pipeline: Optional[EventPipeline] = None
+
+
+def get_audit_pipeline() -> EventPipeline:
+    global _audit_pipeline
+    if _audit_pipeline is None:
+        _audit_pipeline = EventPipeline("audit", _insert_audit_batch)
+    return _audit_pipeline
+
+
 async def log_action(
-    db: AsyncSession,
     action: str,
     resource_type: str,
     resource_id: str,
@@ -39,8 +60,10 @@ async def log_action(
     """
     Log a user action.
 
+    Queued for the audit writer; returns immediately. Entries are dropped
+    (and counted in the pipeline stats) if the queue is full.
+
     Args:
-        db: Database session
         action: Action identifier (e.g., 'array.connect')
         resource_type: Type of resource (e.g., 'array')
         resource_id: ID of the affected resource
@@ -53,17 +76,16 @@ async def log_action(
         return
 
     try:
-        log_entry = AuditLogModel(
-            user_ip=user_ip or "",
-            user_nickname=user_nickname or "",
-            action=action,
-            resource_type=resource_type,
-            resource_id=str(resource_id),
-            details=json.dumps(details or {}),
-            result=result,
-        )
-        db.add(log_entry)
-        # Don't commit here - let the calling function's transaction handle it
+        get_audit_pipeline().offer({
+            "timestamp": datetime.now(),
+            "user_ip": user_ip or "",
+            "user_nickname": user_nickname or "",
+            "action": action,
+            "resource_type": resource_type,
+            "resource_id": str(resource_id),
+            "details": json.dumps(details or {}),
+            "result": result,
+        })
     except Exception as e:
         logger.warning(f"Failed to log audit action: {e}")
 
@@ -0,0 +1,273 @@
+"""
+Card inventory bulk apply and search index.
+
+A sync hands each array's parsed card list to ``apply_array_cards``, which
+diffs it against that array's rows in memory (one SELECT) and writes the
+result set-based: one DELETE for cards that disappeared, one multi-row
+upsert for everything seen, one insert into card_inventory_journal for the
+compact insert / remove / state-change log, and a refresh of
+card_search_tokens for the cards whose searchable fields changed.  Rows
+written through the ORM elsewhere (seeding, admin fixes) are indexed by
+mapper events, and journal entries older than CARD_JOURNAL_RETENTION_DAYS
+are pruned after each sync.
+
+card_search_tokens holds every suffix of every lowercased word of card_no,
+board_id and model, so "keyword occurs in the field" becomes a prefix range
+scan on the token primary key (``token_range``) instead of loading every
+card row and filtering in Python.
+"""
+
+import json
+from dataclasses import dataclass
+from datetime import datetime, timedelta
+from typing import Dict, Iterable, List, Optional, Set, Tuple
+
+from sqlalchemy import String, cast, delete, event, insert, select, update
+from sqlalchemy.dialects.sqlite import insert as sqlite_upsert
+
+from ..models.card_inventory import CardInventoryModel, CardJournalModel, CardSearchTokenModel
+
+# Rows per multi-row statement; keeps bound parameters under SQLite's limit
+CARD_UPSERT_CHUNK = 100
+TOKEN_INSERT_CHUNK = 400
+
+# Re-slotted rows park on "~<id>" before the upsert so that card_no moves
+# (into a slot another row still holds, or swaps) never hit uq_card_array_cardno
+_PARKED_CARD_NO = "~"
+
+# Upper bound for a prefix range scan: sorts after any UTF-8 continuation
+_TOKEN_MAX = "\U0010ffff"
+
+JOURNAL_INSERT = "insert"
+JOURNAL_REMOVE = "remove"
+JOURNAL_STATE = "state"
+
+# How long insert / remove / state-change entries are kept
+CARD_JOURNAL_RETENTION_DAYS = 90
+
+
+@dataclass
+class CardApplyResult:
+    """Outcome of applying one array's card list."""
+    synced: int = 0
+    inserted: int = 0
+    removed: int = 0
+    state_changed: int = 0
+
+
+def search_tokens(*values: Optional[str]) -> Set[str]:
+    """Every suffix of every lowercased whitespace-separated word in values."""
+    tokens = set()
+    for value in values:
+        for word in (value or "").lower().split():
+            for i in range(len(word)):
+                tokens.add(word[i:])
+    return tokens
+
+
+def token_range(keyword: str) -> Tuple[str, str]:
+    """[lo, hi) bounds selecting tokens that start with keyword (lowercased)."""
+    kw = keyword.lower()
+    return kw, kw + _TOKEN_MAX
+
+
+def _state(health: Optional[str], running: Optional[str]) -> str:
+    return f"{health or ''}/{running or ''}"
+
+
+def _dedupe(cards_data: Iterable[dict]) -> List[dict]:
+    """Drop repeated board_ids or card_nos within one sync batch (first one wins).
+
+    card_no is unique per array (uq_card_array_cardno), so two cards sharing a
+    slot would otherwise turn into two conflicting inserts.
+    """
+    seen_board_ids = set()
+    seen_card_nos = set()
+    cards = []
+    for card in cards_data:
+        board_id = card.get("board_id", "")
+        card_no = card.get("card_no", "")
+        if (board_id and board_id in seen_board_ids) or card_no in seen_card_nos:
+            continue
+        if board_id:
+            seen_board_ids.add(board_id)
+        seen_card_nos.add(card_no)
+        cards.append(card)
+    return cards
+
+
+async def _replace_tokens(db, card_fields: Dict[int, Tuple[str, str, str]]):
+    """Rewrite the search tokens of the given {card_id: (card_no, board_id, model)}."""
+    if not card_fields:
+        return
+    await db.execute(
+        delete(CardSearchTokenModel).where(CardSearchTokenModel.card_id.in_(list(card_fields)))
+    )
+    rows = [
+        {"token": token, "card_id": card_id}
+        for card_id, fields in card_fields.items()
+        for token in search_tokens(*fields)
+    ]
+    for i in range(0, len(rows), TOKEN_INSERT_CHUNK):
+        await db.execute(
+            sqlite_upsert(CardSearchTokenModel)
+            .values(rows[i:i + TOKEN_INSERT_CHUNK])
+            .on_conflict_do_nothing()
+        )
+
+
+async def apply_array_cards(db, array_id: str, cards_data: List[dict],
+                            now: Optional[datetime] = None) -> CardApplyResult:
+    """
+    Bring card_inventory for one array in line with a freshly parsed card list.
+
+    Incoming cards match an existing row by board_id first, then by card_no;
+    each row is claimed at most once.  Unmatched rows are removed, except when
+    the list is empty (an empty parse is treated as "no data", not as "every
+    card was pulled").  The caller owns the transaction.
+    """
+    now = now or datetime.now()
+    cards = _dedupe(cards_data)
+    result = CardApplyResult(synced=len(cards))
+
+    existing = (await db.execute(
+        select(
+            CardInventoryModel.id, CardInventoryModel.card_no, CardInventoryModel.board_id,
+            CardInventoryModel.health_state, CardInventoryModel.running_state,
+            CardInventoryModel.model,
+        ).where(CardInventoryModel.array_id == array_id)
+    )).all()
+    by_board = {r.board_id: r for r in existing if r.board_id}
+    by_card_no = {r.card_no: r for r in existing if r.card_no}
+
+    claimed: Set[int] = set()
+    matches: List[Optional[object]] = [None] * len(cards)
+    for i, card in enumerate(cards):
+        row = by_board.get(card.get("board_id", ""))
+        if row is not None and row.id not in claimed:
+            matches[i] = row
+            claimed.add(row.id)
+    for i, card in enumerate(cards):
+        if matches[i] is not None:
+            continue
+        row = by_card_no.get(card.get("card_no", ""))
+        if row is not None and row.id not in claimed:
+            matches[i] = row
+            claimed.add(row.id)
+
+    journal = []
+    removed = [r for r in existing if r.id not in claimed] if cards else []
+    if removed:
+        removed_ids = [r.id for r in removed]
+        await db.execute(delete(CardInventoryModel).where(CardInventoryModel.id.in_(removed_ids)))
+        await db.execute(
+            delete(CardSearchTokenModel).where(CardSearchTokenModel.card_id.in_(removed_ids))
+        )
+        for r in removed:
+            journal.append({
+                "array_id": array_id, "card_no": r.card_no or "", "board_id": r.board_id or "",
+                "model": r.model or "", "change": JOURNAL_REMOVE,
+                "old_state": _state(r.health_state, r.running_state), "new_state": "",
+                "changed_at": now,
+            })
+        result.removed = len(removed)
+
+    upserts = []
+    retokenize: Dict[int, Tuple[str, str, str]] = {}
+    new_card_nos = []
+    for card, row in zip(cards, matches):
+        values = {
+            "id": row.id if row is not None else None,
+            "array_id": array_id,
+            "card_no": card.get("card_no", ""),
+            "board_id": card.get("board_id", ""),
+            "health_state": card.get("health_state", ""),
+            "running_state": card.get("running_state", ""),
+            "model": card.get("model", ""),
+            "raw_fields": json.dumps(card.get("raw_fields", {})),
+            "last_updated": now,
+        }
+        upserts.append(values)
+        new_state = _state(values["health_state"], values["running_state"])
+        entry = {
+            "array_id": array_id, "card_no": values["card_no"], "board_id": values["board_id"],
+            "model": values["model"], "changed_at": now,
+        }
+        if row is None:
+            new_card_nos.append(values["card_no"])
+            journal.append({**entry, "change": JOURNAL_INSERT, "old_state": "", "new_state": new_state})
+            continue
+        old_state = _state(row.health_state, row.running_state)
+        if old_state != new_state:
+            journal.append({**entry, "change": JOURNAL_STATE,
+                            "old_state": old_state, "new_state": new_state})
+        fields = (values["card_no"], values["board_id"], values["model"])
+        if fields != (row.card_no or "", row.board_id or "", row.model or ""):
+            retokenize[row.id] = fields
+    result.inserted = len(new_card_nos)
+    result.state_changed = sum(1 for j in journal if j["change"] == JOURNAL_STATE)
+
+    moved_ids = [
+        row.id for card, row in zip(cards, matches)
+        if row is not None and card.get("card_no", "") != (row.card_no or "")
+    ]
+    if moved_ids:
+        await db.execute(
+            update(CardInventoryModel)
+            .where(CardInventoryModel.id.in_(moved_ids))
+            .values(card_no=_PARKED_CARD_NO + cast(CardInventoryModel.id, String))
+            .execution_options(synchronize_session=False)
+        )
+
+    for i in range(0, len(upserts), CARD_UPSERT_CHUNK):
+        stmt = sqlite_upsert(CardInventoryModel).values(upserts[i:i + CARD_UPSERT_CHUNK])
+        stmt = stmt.on_conflict_do_update(
+            index_elements=["id"],
+            set_={
+                col: getattr(stmt.excluded, col)
+                for col in ("card_no", "board_id", "health_state", "running_state",
+                            "model", "raw_fields", "last_updated")
+            },
+        )
+        await db.execute(stmt)
+
+    if new_card_nos:
+        inserted = await db.execute(
+            select(CardInventoryModel.id, CardInventoryModel.card_no,
+                   CardInventoryModel.board_id, CardInventoryModel.model)
+            .where(CardInventoryModel.array_id == array_id)
+            .where(CardInventoryModel.card_no.in_(new_card_nos))
+        )
+        for r in inserted.all():
+            retokenize[r.id] = (r.card_no or "", r.board_id or "", r.model or "")
+    await _replace_tokens(db, retokenize)
+
+    if journal:
+        await db.execute(insert(CardJournalModel), journal)
+    return result
+
+
+async def prune_card_journal(db, now: Optional[datetime] = None) -> int:
+    """Delete journal entries older than CARD_JOURNAL_RETENTION_DAYS."""
+    cutoff = (now or datetime.now()) - timedelta(days=CARD_JOURNAL_RETENTION_DAYS)
+    result = await db.execute(delete(CardJournalModel).where(CardJournalModel.changed_at < cutoff))
+    return result.rowcount or 0
+
+
+@event.listens_for(CardInventoryModel, "after_insert")
+@event.listens_for(CardInventoryModel, "after_update")
+def _index_orm_card(mapper, connection, target):
+    """Keep tokens current for rows flushed through the ORM (the bulk path
+    above runs Core statements, which these events never see)."""
+    connection.execute(delete(CardSearchTokenModel).where(CardSearchTokenModel.card_id == target.id))
+    rows = [
+        {"token": token, "card_id": target.id}
+        for token in search_tokens(target.card_no, target.board_id, target.model)
+    ]
+    if rows:
+        connection.execute(insert(CardSearchTokenModel), rows)
+
+
+@event.listens_for(CardInventoryModel, "after_delete")
+def _unindex_orm_card(mapper, connection, target):
+    connection.execute(delete(CardSearchTokenModel).where(CardSearchTokenModel.card_id == target.id))
@@ -7,25 +7,77 @@ Handles:
 - Data archiving and cleanup
 """
 
+import asyncio
 import gzip
 import hashlib
+import heapq
 import json
 import logging
+import threading
+import zlib
 from datetime import datetime, timedelta
-from typing import Any, Dict, List, Optional, Tuple
+from typing import (
+    Any, AsyncIterator, Awaitable, Callable, Dict, Iterable, Iterator, List, Optional, Tuple
+)
 
 from sqlalchemy import select, delete, func
+from sqlalchemy.dialects.sqlite import insert as sqlite_upsert
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..models.alert import AlertModel, AlertCreate, AlertLevel
 from ..models.lifecycle import (
-    SyncStateModel, AlertsArchiveModel, ArchiveConfigModel,
+    SyncStateModel, AlertHashModel, AlertsArchiveModel, AlertsArchiveChunkModel, ArchiveConfigModel,
     SyncState, ImportResult, ArchiveConfig, ArchiveStats, LogFileInfo
 )
 from .system_alert import sys_info, sys_warning, sys_error
 
 logger = logging.getLogger(__name__)
 
+# History import tuning: parsed records per DB transaction, remote files
+# streamed at once, batches buffered between readers and the writer
+# (bounds memory to roughly IMPORT_QUEUE_BATCHES * IMPORT_BATCH_SIZE alerts).
+IMPORT_BATCH_SIZE = 500
+IMPORT_PARALLEL_FILES = 3
+IMPORT_QUEUE_BATCHES = 8
+IMPORT_READ_TIMEOUT = 60
+# alerts rows folded into the dedup index per query
+HASH_INDEX_CHUNK = 2000
+# Archived alerts per compressed chunk
+ARCHIVE_CHUNK_RECORDS = 1000
+
+
+def iter_log_lines(chunks: Iterable[bytes], compressed: bool = False) -> Iterator[str]:
+    """
+    Yield decoded lines from a stream of byte chunks.
+
+    ``compressed`` input is gunzipped incrementally (concatenated gzip
+    members, as produced by logrotate + append, are handled).  Only one
+    chunk plus a partial line is held in memory at a time.
+    """
+    decomp = zlib.decompressobj(zlib.MAX_WBITS | 16) if compressed else None
+    pending = b""
+    for chunk in chunks:
+        if decomp is not None:
+            data = b""
+            while chunk:
+                data += decomp.decompress(chunk)
+                if not decomp.eof:
+                    break
+                chunk = decomp.unused_data
+                decomp = zlib.decompressobj(zlib.MAX_WBITS | 16)
+            chunk = data
+        if not chunk:
+            continue
+        pending += chunk
+        lines = pending.split(b"\n")
+        pending = lines.pop()
+        for line in lines:
+            yield line.decode("utf-8", errors="replace")
+    if decomp is not None:
+        pending += decomp.flush()
+    if pending:
+        yield pending.decode("utf-8", errors="replace")
+
 
 class DataLifecycleManager:
     """
@@ -54,7 +106,7 @@ class DataLifecycleManager:
         try:
             # List files matching alerts.log*
             cmd = f"ls -la {log_dir}/alerts.log* 2>/dev/null || true"
-            output = self.ssh_conn.exec_command(cmd)
+            _, output, _ = await self.ssh_conn.execute_async(cmd)
             
             files = []
             for line in output.strip().split('\n'):
@@ -134,28 +186,175 @@ class DataLifecycleManager:
         """Compute hash for deduplication"""
         content = f"{timestamp}|{observer}|{message}"
         return hashlib.md5(content.encode()).hexdigest()
-    
-    async def _get_existing_hashes(
-        self,
-        db: AsyncSession,
-        array_id: str,
-        start_time: datetime
-    ) -> set:
-        """Get existing alert hashes for deduplication"""
+
+    def _parse_alert_line(self, line: str, not_before: Optional[datetime] = None) -> Optional[Dict[str, Any]]:
+        """
+        Parse one alerts.log JSON line into an insertable record.
+
+        Returns None for blank/invalid lines and for alerts older than
+        ``not_before``.  The dedup hash uses the normalized timestamp so it
+        matches hashes computed from stored AlertModel rows.
+        """
+        line = line.strip()
+        if not line:
+            return None
+        try:
+            alert_data = json.loads(line)
+        except json.JSONDecodeError:
+            return None
+        if not isinstance(alert_data, dict):
+            return None
+
+        timestamp_str = alert_data.get('timestamp', '') or ''
+        observer = alert_data.get('observer_name', 'unknown')
+        message = alert_data.get('message', '')
+
+        timestamp = None
+        if timestamp_str:
+            try:
+                timestamp = datetime.fromisoformat(timestamp_str.replace('Z', ''))
+            except (TypeError, ValueError):
+                timestamp = None
+        if not_before is not None and timestamp is not None and timestamp < not_before:
+            return None
+
+        level_str = str(alert_data.get('level', 'info')).lower()
+        level = level_str if level_str in ['info', 'warning', 'error', 'critical'] else 'info'
+
+        return {
+            'hash': self._compute_message_hash(
+                timestamp.isoformat() if timestamp else timestamp_str, observer, message
+            ),
+            'observer_name': observer,
+            'level': level,
+            'message': message,
+            'details': json.dumps(alert_data.get('details', {}), ensure_ascii=False),
+            'timestamp': timestamp,
+        }
+
+    # ---- persisted dedup index -------------------------------------------
+
+    async def _get_or_create_sync_state(self, db: AsyncSession, array_id: str) -> SyncStateModel:
         result = await db.execute(
-            select(AlertModel.timestamp, AlertModel.observer_name, AlertModel.message)
-            .where(AlertModel.array_id == array_id)
-            .where(AlertModel.timestamp >= start_time)
+            select(SyncStateModel).where(SyncStateModel.array_id == array_id)
         )
-        
-        hashes = set()
-        for row in result.all():
-            ts_str = row[0].isoformat() if row[0] else ""
-            h = self._compute_message_hash(ts_str, row[1], row[2])
-            hashes.add(h)
-        
-        return hashes
-    
+        state = result.scalar()
+        if state is None:
+            state = SyncStateModel(array_id=array_id, log_file="alerts.log", last_position=0,
+                                   total_imported=0, hash_indexed_id=0)
+            db.add(state)
+        return state
+
+    async def _insert_hashes(self, db: AsyncSession, array_id: str, rows: List[Tuple[str, Optional[datetime]]]):
+        """Add (hash, timestamp) pairs to the index, ignoring ones already present"""
+        if not rows:
+            return
+        stmt = sqlite_upsert(AlertHashModel).values([
+            {'array_id': array_id, 'hash': h, 'timestamp': ts} for h, ts in rows
+        ]).on_conflict_do_nothing(index_elements=['array_id', 'hash'])
+        await db.execute(stmt)
+
+    async def _sync_hash_index(self, db: AsyncSession, array_id: str) -> int:
+        """
+        Fold alerts stored since the last run (live sync, ingest push, ...)
+        into alert_hashes, walking alerts.id from the persisted watermark in
+        bounded chunks.  Returns the number of alerts indexed.
+        """
+        state = await self._get_or_create_sync_state(db, array_id)
+        watermark = state.hash_indexed_id or 0
+        indexed = 0
+        while True:
+            result = await db.execute(
+                select(AlertModel.id, AlertModel.timestamp, AlertModel.observer_name, AlertModel.message)
+                .where(AlertModel.array_id == array_id)
+                .where(AlertModel.id > watermark)
+                .order_by(AlertModel.id)
+                .limit(HASH_INDEX_CHUNK)
+            )
+            rows = result.all()
+            if not rows:
+                break
+            await self._insert_hashes(db, array_id, [
+                (self._compute_message_hash(ts.isoformat() if ts else "", observer, message), ts)
+                for _, ts, observer, message in rows
+            ])
+            watermark = rows[-1][0]
+            indexed += len(rows)
+        state.hash_indexed_id = watermark
+        await db.commit()
+        return indexed
+
+    async def _store_batch(self, db: AsyncSession, array_id: str, records: List[Dict[str, Any]]) -> Tuple[int, int]:
+        """
+        Dedup one parsed batch against the persisted index, insert the new
+        alerts together with their hashes and commit.  Returns (imported, skipped).
+        """
+        hashes = list({r['hash'] for r in records})
+        result = await db.execute(
+            select(AlertHashModel.hash)
+            .where(AlertHashModel.array_id == array_id)
+            .where(AlertHashModel.hash.in_(hashes))
+        )
+        seen = set(result.scalars().all())
+
+        fresh = []
+        for record in records:
+            if record['hash'] in seen:
+                continue
+            seen.add(record['hash'])
+            fresh.append(record)
+
+        if fresh:
+            db.add_all([
+                AlertModel(
+                    array_id=array_id,
+                    observer_name=r['observer_name'],
+                    level=r['level'],
+                    message=r['message'],
+                    details=r['details'],
+                    timestamp=r['timestamp'] or datetime.now(),
+                )
+                for r in fresh
+            ])
+            await self._insert_hashes(db, array_id, [(r['hash'], r['timestamp']) for r in fresh])
+            await db.commit()
+        return len(fresh), len(records) - len(fresh)
+
+    # ---- streaming import ------------------------------------------------
+
+    def _read_file_batches(
+        self,
+        file_path: str,
+        not_before: Optional[datetime],
+        put: Callable[[List[Dict[str, Any]]], None],
+        stop: threading.Event,
+    ):
+        """
+        Worker thread: stream one remote log file, decompress and parse it
+        incrementally and hand off batches of IMPORT_BATCH_SIZE records.
+        ``put`` blocks while the writer is behind, which bounds memory.
+        """
+        compressed = file_path.endswith('.gz')
+        chunks = self.ssh_conn.stream_command(
+            f"cat {file_path} 2>/dev/null", timeout=IMPORT_READ_TIMEOUT
+        )
+        batch: List[Dict[str, Any]] = []
+        try:
+            for line in iter_log_lines(chunks, compressed):
+                if stop.is_set():
+                    return
+                record = self._parse_alert_line(line, not_before)
+                if record is None:
+                    continue
+                batch.append(record)
+                if len(batch) >= IMPORT_BATCH_SIZE:
+                    put(batch)
+                    batch = []
+            if batch:
+                put(batch)
+        finally:
+            chunks.close()
+
     async def import_history(
         self,
         db: AsyncSession,
@@ -172,6 +371,11 @@ class DataLifecycleManager:
         - incremental: Import last N days from current log file
         - full: Import all available log files
         - selective: Import specified log files
+
+        Up to IMPORT_PARALLEL_FILES files are streamed concurrently by worker
+        threads; parsed batches flow through a bounded queue to a single DB
+        writer that dedups each batch against the persisted hash index and
+        commits it, so memory stays flat regardless of log size.
         """
         if not self.ssh_conn or not self.ssh_conn.is_connected():
             return ImportResult(
@@ -191,90 +395,61 @@ class DataLifecycleManager:
             files_to_import = [f.name for f in remote_files]
         else:  # incremental
             files_to_import = ["alerts.log"]
-        
-        # Get existing hashes for deduplication
-        cutoff_time = datetime.now() - timedelta(days=max(days, 30))
-        existing_hashes = await self._get_existing_hashes(db, array_id, cutoff_time)
-        
+
+        not_before = datetime.now() - timedelta(days=days) if mode == "incremental" else None
+
+        # Bring the dedup index up to date with alerts stored by other paths
+        await self._sync_hash_index(db, array_id)
+
+        loop = asyncio.get_running_loop()
+        queue: asyncio.Queue = asyncio.Queue(maxsize=IMPORT_QUEUE_BATCHES)
+        stop = threading.Event()
+        limit = asyncio.Semaphore(IMPORT_PARALLEL_FILES)
+        failed_files: List[str] = []
+
+        def put(batch: List[Dict[str, Any]]):
+            asyncio.run_coroutine_threadsafe(queue.put(batch), loop).result()
+
+        async def read_file(filename: str):
+            async with limit:
+                try:
+                    await loop.run_in_executor(
+                        None, self._read_file_batches, f"{log_dir}/{filename}", not_before, put, stop
+                    )
+                except Exception as e:
+                    failed_files.append(filename)
+                    sys_error("lifecycle", f"Failed to import {filename}: {e}", exception=e)
+
+        async def read_all():
+            try:
+                await asyncio.gather(*(read_file(f) for f in files_to_import))
+            finally:
+                await queue.put(None)
+
+        readers = asyncio.ensure_future(read_all())
         total_imported = 0
         total_skipped = 0
-        
-        for filename in files_to_import:
-            file_path = f"{log_dir}/{filename}"
-            
-            # Read file content
-            try:
-                if filename.endswith('.gz'):
-                    # Compressed file
-                    cmd = f"zcat {file_path} 2>/dev/null || true"
-                else:
-                    cmd = f"cat {file_path} 2>/dev/null || true"
-                
-                content = self.ssh_conn.exec_command(cmd)
-                if not content:
+        try:
+            while True:
+                batch = await queue.get()
+                if batch is None:
+                    break
+                try:
+                    imported, skipped = await self._store_batch(db, array_id, batch)
+                except Exception as e:
+                    await db.rollback()
+                    sys_error("lifecycle", f"Failed to store import batch for {array_id}: {e}", exception=e)
                     continue
-                
-                # Parse and filter alerts
-                alerts_to_create = []
-                for line in content.strip().split('\n'):
-                    if not line.strip():
-                        continue
-                    
-                    try:
-                        alert_data = json.loads(line)
-                        
-                        timestamp_str = alert_data.get('timestamp', '')
-                        observer = alert_data.get('observer_name', 'unknown')
-                        message = alert_data.get('message', '')
-                        
-                        # Skip if too old (incremental mode)
-                        if mode == "incremental" and timestamp_str:
-                            try:
-                                ts = datetime.fromisoformat(timestamp_str.replace('Z', ''))
-                                if ts < datetime.now() - timedelta(days=days):
-                                    continue
-                            except:
-                                pass
-                        
-                        # Check for duplicates
-                        msg_hash = self._compute_message_hash(timestamp_str, observer, message)
-                        if msg_hash in existing_hashes:
-                            total_skipped += 1
-                            continue
-                        
-                        existing_hashes.add(msg_hash)
-                        
-                        # Parse timestamp
-                        try:
-                            timestamp = datetime.fromisoformat(timestamp_str.replace('Z', ''))
-                        except:
-                            timestamp = datetime.now()
-                        
-                        # Parse level
-                        level_str = alert_data.get('level', 'info').lower()
-                        level = level_str if level_str in ['info', 'warning', 'error', 'critical'] else 'info'
-                        
-                        alerts_to_create.append(AlertModel(
-                            array_id=array_id,
-                            observer_name=observer,
-                            level=level,
-                            message=message,
-                            details=json.dumps(alert_data.get('details', {}), ensure_ascii=False),
-                            timestamp=timestamp,
-                        ))
-                        
-                    except json.JSONDecodeError:
-                        continue
-                
-                # Batch insert
-                if alerts_to_create:
-                    db.add_all(alerts_to_create)
-                    await db.commit()
-                    total_imported += len(alerts_to_create)
-                    
-            except Exception as e:
-                sys_error("lifecycle", f"Failed to import {filename}: {e}", exception=e)
-                continue
+                total_imported += imported
+                total_skipped += skipped
+        finally:
+            # Unblock and stop readers if the writer exits early (cancellation)
+            stop.set()
+            while not readers.done():
+                try:
+                    queue.get_nowait()
+                except asyncio.QueueEmpty:
+                    await asyncio.sleep(0.05)
         
         # Update sync state
         await self._update_sync_state(
@@ -285,14 +460,20 @@ class DataLifecycleManager:
         sys_info("lifecycle", f"Import completed for {array_id}", {
             "imported": total_imported,
             "skipped": total_skipped,
-            "mode": mode
+            "mode": mode,
+            "files": len(files_to_import),
+            "failed_files": failed_files,
         })
         
+        message = f"导入完成: {total_imported} 条新告警, {total_skipped} 条重复跳过"
+        if failed_files:
+            message += f", {len(failed_files)} 个文件读取失败"
         return ImportResult(
             success=True,
             imported_count=total_imported,
             skipped_count=total_skipped,
-            message=f"导入完成: {total_imported} 条新告警, {total_skipped} 条重复跳过"
+            message=message,
+            failed_files=failed_files,
         )
     
     async def sync_incremental(
@@ -308,61 +489,24 @@ class DataLifecycleManager:
         if not content:
             return 0, 0
         
-        # Get existing hashes
-        cutoff_time = datetime.now() - timedelta(days=30)
-        existing_hashes = await self._get_existing_hashes(db, array_id, cutoff_time)
-        
+        await self._sync_hash_index(db, array_id)
+
         imported = 0
         skipped = 0
-        alerts_to_create = []
         last_timestamp = None
-        
-        for line in content.strip().split('\n'):
-            if not line.strip():
-                continue
-            
-            try:
-                alert_data = json.loads(line)
-                
-                timestamp_str = alert_data.get('timestamp', '')
-                observer = alert_data.get('observer_name', 'unknown')
-                message = alert_data.get('message', '')
-                
-                # Check for duplicates
-                msg_hash = self._compute_message_hash(timestamp_str, observer, message)
-                if msg_hash in existing_hashes:
-                    skipped += 1
-                    continue
-                
-                existing_hashes.add(msg_hash)
-                
-                # Parse timestamp
-                try:
-                    timestamp = datetime.fromisoformat(timestamp_str.replace('Z', ''))
-                    last_timestamp = timestamp
-                except:
-                    timestamp = datetime.now()
-                
-                # Parse level
-                level_str = alert_data.get('level', 'info').lower()
-                level = level_str if level_str in ['info', 'warning', 'error', 'critical'] else 'info'
-                
-                alerts_to_create.append(AlertModel(
-                    array_id=array_id,
-                    observer_name=observer,
-                    level=level,
-                    message=message,
-                    details=json.dumps(alert_data.get('details', {}), ensure_ascii=False),
-                    timestamp=timestamp,
-                ))
-                
-            except json.JSONDecodeError:
-                continue
-        
-        if alerts_to_create:
-            db.add_all(alerts_to_create)
-            await db.commit()
-            imported = len(alerts_to_create)
+        batch: List[Dict[str, Any]] = []
+        lines = content.split('\n')
+        for i, line in enumerate(lines):
+            record = self._parse_alert_line(line)
+            if record is not None:
+                batch.append(record)
+                if record['timestamp'] is not None:
+                    last_timestamp = record['timestamp']
+            if batch and (len(batch) >= IMPORT_BATCH_SIZE or i == len(lines) - 1):
+                n_new, n_dup = await self._store_batch(db, array_id, batch)
+                imported += n_new
+                skipped += n_dup
+                batch = []
         
         # Update sync state
         if imported > 0:
@@ -409,7 +553,7 @@ class DataLifecycleManager:
         """
         Archive old data based on configuration.
         
-        1. Move alerts older than active_retention_days to archive
+        1. Move alerts older than active_retention_days to archive chunks
         2. Delete archives older than archive_retention_days
         """
         config = await self.get_archive_config(db)
@@ -425,26 +569,18 @@ class DataLifecycleManager:
             select(AlertModel)
             .where(AlertModel.timestamp < active_cutoff)
             .where(AlertModel.timestamp >= archive_cutoff)
+            .order_by(AlertModel.timestamp)
         )
         alerts_to_archive = result.scalars().all()
         
         archived_count = 0
         
         if alerts_to_archive:
-            # Group by array_id and year_month
-            groups: Dict[str, Dict[str, List]] = {}
+            # Group by array_id and year_month (timestamp order is kept)
+            groups: Dict[Tuple[str, str], List[Dict[str, Any]]] = {}
             for alert in alerts_to_archive:
-                year_month = alert.timestamp.strftime('%Y-%m')
-                key = f"{alert.array_id}|{year_month}"
-                
-                if key not in groups:
-                    groups[key] = {
-                        'array_id': alert.array_id,
-                        'year_month': year_month,
-                        'alerts': []
-                    }
-                
-                groups[key]['alerts'].append({
+                key = (alert.array_id, alert.timestamp.strftime('%Y-%m'))
+                groups.setdefault(key, []).append({
                     'timestamp': alert.timestamp.isoformat(),
                     'level': alert.level,
                     'observer_name': alert.observer_name,
@@ -452,43 +588,36 @@ class DataLifecycleManager:
                     'details': alert.details,
                 })
             
-            # Create archive entries
-            for key, group in groups.items():
-                # Check if archive already exists
+            for (array_id, year_month), alerts_data in groups.items():
                 result = await db.execute(
                     select(AlertsArchiveModel)
-                    .where(AlertsArchiveModel.array_id == group['array_id'])
-                    .where(AlertsArchiveModel.year_month == group['year_month'])
+                    .where(AlertsArchiveModel.array_id == array_id)
+                    .where(AlertsArchiveModel.year_month == year_month)
                 )
-                existing = result.scalar()
+                archive = result.scalar()
                 
-                alerts_data = group['alerts']
-                
-                if existing:
-                    # Merge with existing
-                    try:
-                        existing_data = json.loads(gzip.decompress(existing.data_compressed).decode())
-                        existing_data.extend(alerts_data)
-                        alerts_data = existing_data
-                    except:
-                        pass
-                    
-                    existing.data_compressed = gzip.compress(
-                        json.dumps(alerts_data, ensure_ascii=False).encode()
-                    )
-                    existing.record_count = len(alerts_data)
-                else:
+                if archive is None:
                     archive = AlertsArchiveModel(
-                        array_id=group['array_id'],
-                        year_month=group['year_month'],
-                        data_compressed=gzip.compress(
-                            json.dumps(alerts_data, ensure_ascii=False).encode()
-                        ),
-                        record_count=len(alerts_data)
+                        array_id=array_id,
+                        year_month=year_month,
+                        data_compressed=b"",
+                        record_count=0
                     )
                     db.add(archive)
+                elif archive.data_compressed:
+                    self._rechunk_legacy(db, archive)
+                
+                # New alerts go into fresh chunks; existing chunks are never rewritten
+                result = await db.execute(
+                    select(func.max(AlertsArchiveChunkModel.seq))
+                    .where(AlertsArchiveChunkModel.array_id == array_id)
+                    .where(AlertsArchiveChunkModel.year_month == year_month)
+                )
+                next_seq = (result.scalar() or 0) + 1
+                db.add_all(build_archive_chunks(array_id, year_month, alerts_data, next_seq))
+                archive.record_count = (archive.record_count or 0) + len(alerts_data)
                 
-                archived_count += len(group['alerts'])
+                archived_count += len(alerts_data)
             
             # Delete archived alerts from main table
             alert_ids = [a.id for a in alerts_to_archive]
@@ -511,6 +640,15 @@ class DataLifecycleManager:
             for archive in old_archives:
                 deleted_count += archive.record_count
                 await db.delete(archive)
+            await db.execute(
+                delete(AlertsArchiveChunkModel)
+                .where(AlertsArchiveChunkModel.year_month < old_year_month)
+            )
+
+            # Dedup hashes for alerts past retention can no longer collide
+            await db.execute(
+                delete(AlertHashModel).where(AlertHashModel.timestamp < archive_cutoff)
+            )
             
             await db.commit()
         
@@ -521,6 +659,21 @@ class DataLifecycleManager:
             })
         
         return {"archived": archived_count, "deleted": deleted_count}
+
+    def _rechunk_legacy(self, db: AsyncSession, archive: AlertsArchiveModel) -> bool:
+        """
+        Split a legacy single-blob month into chunks (once).  Caller commits.
+        """
+        try:
+            data = json.loads(gzip.decompress(archive.data_compressed).decode())
+        except Exception as e:
+            sys_error("lifecycle", f"Failed to decompress archive {archive.array_id}/{archive.year_month}: {e}")
+            return False
+        data.sort(key=lambda a: a.get('timestamp', ''))
+        db.add_all(build_archive_chunks(archive.array_id, archive.year_month, data, 1))
+        archive.data_compressed = b""
+        archive.record_count = len(data)
+        return True
     
     async def get_archive_stats(self, db: AsyncSession) -> ArchiveStats:
         """Get archive statistics"""
@@ -538,6 +691,10 @@ class DataLifecycleManager:
         row = result.one()
         archive_count = row[0] or 0
         archive_size = row[1] or 0
+        result = await db.execute(
+            select(func.sum(func.length(AlertsArchiveChunkModel.data_compressed)))
+        )
+        archive_size += result.scalar() or 0
         
         # Oldest active
         result = await db.execute(
@@ -563,35 +720,165 @@ class DataLifecycleManager:
         self,
         db: AsyncSession,
         array_id: Optional[str] = None,
-        year_month: Optional[str] = None
+        year_month: Optional[str] = None,
+        observer_name: Optional[str] = None,
+        level: Optional[str] = None,
+        start: Optional[datetime] = None,
+        end: Optional[datetime] = None,
+        offset: int = 0,
+        limit: int = 500
     ) -> List[Dict]:
-        """Query archived alerts"""
-        query = select(AlertsArchiveModel)
-        
+        """
+        Query archived alerts, newest first.
+
+        Filters are pushed down to the chunk index, so only chunks whose
+        time range / observers / levels can match are decompressed, one at
+        a time, and reading stops once offset + limit alerts are produced.
+        """
+        await self._rechunk_matching_legacy(db, array_id, year_month)
+
+        start_iso = start.isoformat() if start else None
+        end_iso = end.isoformat() if end else None
+
+        query = select(
+            AlertsArchiveChunkModel.id,
+            AlertsArchiveChunkModel.array_id,
+            AlertsArchiveChunkModel.max_ts,
+        )
         if array_id:
-            query = query.where(AlertsArchiveModel.array_id == array_id)
+            query = query.where(AlertsArchiveChunkModel.array_id == array_id)
         if year_month:
-            query = query.where(AlertsArchiveModel.year_month == year_month)
-        
-        result = await db.execute(query)
-        archives = result.scalars().all()
-        
-        alerts = []
-        for archive in archives:
+            query = query.where(AlertsArchiveChunkModel.year_month == year_month)
+        if start_iso:
+            query = query.where(AlertsArchiveChunkModel.max_ts >= start_iso)
+        if end_iso:
+            query = query.where(AlertsArchiveChunkModel.min_ts <= end_iso)
+        if observer_name:
+            query = query.where(AlertsArchiveChunkModel.observers.contains(f",{observer_name},"))
+        if level:
+            query = query.where(AlertsArchiveChunkModel.levels.contains(f",{level},"))
+        result = await db.execute(query.order_by(AlertsArchiveChunkModel.max_ts.desc()))
+        chunks = result.all()
+
+        def matches(alert: Dict[str, Any]) -> bool:
+            ts = alert.get('timestamp', '')
+            return ((not observer_name or alert.get('observer_name') == observer_name)
+                    and (not level or alert.get('level') == level)
+                    and (not start_iso or ts >= start_iso)
+                    and (not end_iso or ts <= end_iso))
+
+        async def load(chunk) -> List[Dict]:
+            result = await db.execute(
+                select(AlertsArchiveChunkModel.data_compressed)
+                .where(AlertsArchiveChunkModel.id == chunk.id)
+            )
             try:
-                data = json.loads(gzip.decompress(archive.data_compressed).decode())
-                for alert in data:
-                    alert['array_id'] = archive.array_id
-                    alerts.append(alert)
+                data = json.loads(gzip.decompress(result.scalar()).decode())
             except Exception as e:
-                sys_error("lifecycle", f"Failed to decompress archive: {e}")
+                sys_error("lifecycle", f"Failed to decompress archive chunk {chunk.id}: {e}")
+                return []
+            alerts = []
+            for alert in data:
+                if matches(alert):
+                    alert['array_id'] = chunk.array_id
+                    alerts.append(alert)
+            return alerts
+
+        alerts = []
+        skipped = 0
+        async for alert in merge_chunks_desc(chunks, load):
+            if skipped < offset:
+                skipped += 1
                 continue
-        
-        # Sort by timestamp descending
-        alerts.sort(key=lambda x: x.get('timestamp', ''), reverse=True)
-        
+            alerts.append(alert)
+            if len(alerts) >= limit:
+                break
         return alerts
 
+    async def _rechunk_matching_legacy(
+        self, db: AsyncSession, array_id: Optional[str], year_month: Optional[str]
+    ):
+        """Convert legacy blobs in the query scope before reading chunks"""
+        query = select(AlertsArchiveModel).where(func.length(AlertsArchiveModel.data_compressed) > 0)
+        if array_id:
+            query = query.where(AlertsArchiveModel.array_id == array_id)
+        if year_month:
+            query = query.where(AlertsArchiveModel.year_month == year_month)
+        result = await db.execute(query)
+        converted = [a for a in result.scalars().all() if self._rechunk_legacy(db, a)]
+        if converted:
+            await db.commit()
+
+
+def build_archive_chunks(
+    array_id: str,
+    year_month: str,
+    alerts: List[Dict[str, Any]],
+    first_seq: int = 1,
+    chunk_size: Optional[int] = None
+) -> List[AlertsArchiveChunkModel]:
+    """
+    Slice timestamp-ordered archived alerts into compressed chunks carrying
+    their min/max timestamp, observer and level sets.
+    """
+    chunk_size = chunk_size or ARCHIVE_CHUNK_RECORDS
+    chunks = []
+    for i in range(0, len(alerts), chunk_size):
+        part = alerts[i:i + chunk_size]
+        observers = sorted({a.get('observer_name') or '' for a in part})
+        levels = sorted({a.get('level') or '' for a in part})
+        chunks.append(AlertsArchiveChunkModel(
+            array_id=array_id,
+            year_month=year_month,
+            seq=first_seq + len(chunks),
+            min_ts=part[0].get('timestamp', ''),
+            max_ts=part[-1].get('timestamp', ''),
+            observers=',' + ','.join(observers) + ',',
+            levels=',' + ','.join(levels) + ',',
+            record_count=len(part),
+            data_compressed=gzip.compress(json.dumps(part, ensure_ascii=False).encode()),
+        ))
+    return chunks
+
+
+class _Newest:
+    """Heap key ordering ISO timestamps newest first"""
+    __slots__ = ('ts',)
+
+    def __init__(self, ts: str):
+        self.ts = ts
+
+    def __lt__(self, other: '_Newest') -> bool:
+        return self.ts > other.ts
+
+
+async def merge_chunks_desc(
+    chunks: List[Any],
+    load: Callable[[Any], Awaitable[List[Dict[str, Any]]]]
+) -> AsyncIterator[Dict[str, Any]]:
+    """
+    Yield alerts from ``chunks`` (ordered by max_ts descending) newest
+    first.  Chunks may overlap in time; a chunk is only loaded once the
+    merge front reaches its max_ts, so a paginated read touches just the
+    chunks it needs.
+    """
+    heap: List[Tuple[_Newest, int, Dict[str, Any], Iterator[Dict[str, Any]]]] = []
+    pos = 0
+    while True:
+        while pos < len(chunks) and (not heap or chunks[pos].max_ts >= heap[0][0].ts):
+            records = iter(reversed(await load(chunks[pos])))
+            first = next(records, None)
+            if first is not None:
+                heapq.heappush(heap, (_Newest(first.get('timestamp', '')), pos, first, records))
+            pos += 1
+        if not heap:
+            return
+        _, idx, alert, records = heapq.heappop(heap)
+        yield alert
+        following = next(records, None)
+        if following is not None:
+            heapq.heappush(heap, (_Newest(following.get('timestamp', '')), idx, following, records))
+
 
 # Global instance
 _lifecycle_manager: Optional[DataLifecycleManager] = None
@@ -0,0 +1,69 @@
+"""
+Shape-preserving time-series decimation for chart endpoints.
+
+minmax_rows buckets rows by position and keeps, per bucket, the rows holding
+the min and max of every value column (plus the bucket's first row).  Works
+on multi-column records such as metrics (cpu0, mem_used_mb) or traffic
+(tx_rate_bps, rx_rate_bps), keeps original dicts intact and never drops a
+spike in any column.  Single-series LTTB refinement on zoom happens in the
+client (frontend/src/utils/downsample.js).
+
+The first and last samples are always kept so the time extent is unchanged.
+"""
+
+from typing import Any, Dict, List, Optional, Sequence
+
+# Upper bound accepted by chart endpoints for ?max_points=
+MAX_CHART_POINTS = 5000
+
+
+def _as_float(value: Any) -> Optional[float]:
+    if isinstance(value, bool) or not isinstance(value, (int, float)):
+        return None
+    return float(value)
+
+
+def minmax_rows(
+    rows: Sequence[Dict[str, Any]],
+    max_points: int,
+    value_keys: Sequence[str],
+) -> List[Dict[str, Any]]:
+    """
+    Reduce ``rows`` (already sorted by time) to roughly ``max_points`` rows.
+
+    Each bucket contributes its first row and the argmin/argmax rows of every
+    key in ``value_keys``; rows missing a key are ignored for that key.
+    """
+    n = len(rows)
+    if max_points <= 0 or n <= max_points:
+        return list(rows)
+
+    # Worst case a bucket yields 1 + 2 * len(value_keys) distinct rows
+    per_bucket = 1 + 2 * max(len(value_keys), 1)
+    bucket_count = max(1, (max_points - 2) // per_bucket)
+    inner = n - 2
+    bucket_size = inner / bucket_count
+
+    keep = {0, n - 1}
+    for b in range(bucket_count):
+        start = 1 + int(b * bucket_size)
+        end = 1 + int((b + 1) * bucket_size) if b < bucket_count - 1 else n - 1
+        if start >= end:
+            continue
+        keep.add(start)
+        for key in value_keys:
+            lo_idx = hi_idx = None
+            lo_val = hi_val = None
+            for i in range(start, end):
+                v = _as_float(rows[i].get(key))
+                if v is None:
+                    continue
+                if lo_val is None or v < lo_val:
+                    lo_val, lo_idx = v, i
+                if hi_val is None or v > hi_val:
+                    hi_val, hi_idx = v, i
+            if lo_idx is not None:
+                keep.add(lo_idx)
+                keep.add(hi_idx)
+
+    return [rows[i] for i in sorted(keep)]
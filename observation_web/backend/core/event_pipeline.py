@@ -0,0 +1,164 @@
+"""
+Bounded asynchronous batching pipeline for log-style events.
+
+Request handlers call ``offer()``, which only appends to an in-memory queue
+and never waits: when the queue is full the event is dropped and counted
+(back-pressure by shedding, so an error burst cannot turn into a write
+storm or slow requests down).  A single writer task drains the queue in
+batches of up to ``batch_size`` every ``flush_interval`` seconds and hands
+each batch to an async ``sink`` (batch DB insert, file append, ...).
+
+Every offered event is also counted in a per-second ring, so event rates
+stay measurable even while events are being dropped.
+"""
+
+import asyncio
+import logging
+import threading
+import time
+from collections import deque
+from typing import Any, Awaitable, Callable, Deque, Dict, List, Optional
+
+logger = logging.getLogger(__name__)
+
+Sink = Callable[[List[Any]], Awaitable[None]]
+
+RATE_WINDOW_SECONDS = 60
+
+
+class RateCounter:
+    """Event counts in one-second buckets over the last ``window`` seconds."""
+
+    def __init__(self, window: int = RATE_WINDOW_SECONDS, clock: Callable[[], float] = time.monotonic):
+        self.window = window
+        self._clock = clock
+        self._buckets = [0] * window
+        self._stamps = [-1] * window
+
+    def add(self, n: int = 1):
+        second = int(self._clock())
+        idx = second % self.window
+        if self._stamps[idx] != second:
+            self._stamps[idx] = second
+            self._buckets[idx] = 0
+        self._buckets[idx] += n
+
+    def total(self) -> int:
+        oldest = int(self._clock()) - self.window
+        return sum(c for c, s in zip(self._buckets, self._stamps) if s > oldest)
+
+
+class EventPipeline:
+    """Bounded queue + batch writer with drop accounting."""
+
+    def __init__(
+        self,
+        name: str,
+        sink: Sink,
+        max_queue: int = 10000,
+        batch_size: int = 200,
+        flush_interval: float = 0.5,
+    ):
+        self.name = name
+        self.sink = sink
+        self.max_queue = max_queue
+        self.batch_size = batch_size
+        self.flush_interval = flush_interval
+        self._queue: Deque[Any] = deque()
+        # offer() may be called from SSH / executor threads
+        self._lock = threading.Lock()
+        self._task: Optional[asyncio.Task] = None
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self._wakeup: Optional[asyncio.Event] = None
+        self.rate = RateCounter()
+        self.offered = 0
+        self.written = 0
+        self.dropped = 0
+        self.failed = 0
+        self.batches = 0
+
+    def offer(self, event: Any) -> bool:
+        """Queue an event without blocking. Returns False if it was dropped."""
+        with self._lock:
+            self.offered += 1
+            self.rate.add()
+            if len(self._queue) >= self.max_queue:
+                self.dropped += 1
+                return False
+            self._queue.append(event)
+            full_batch = len(self._queue) >= self.batch_size
+        self._ensure_writer()
+        if full_batch and self._wakeup is not None and self._loop is not None:
+            self._loop.call_soon_threadsafe(self._wakeup.set)
+        return True
+
+    def _ensure_writer(self):
+        if self._task is not None and not self._task.done():
+            return
+        try:
+            loop = asyncio.get_running_loop()
+        except RuntimeError:
+            return  # Not on the event loop (thread); the next in-loop offer starts it
+        self._loop = loop
+        self._wakeup = asyncio.Event()
+        self._task = loop.create_task(self._run())
+
+    def _take_batch(self) -> List[Any]:
+        with self._lock:
+            n = min(len(self._queue), self.batch_size)
+            return [self._queue.popleft() for _ in range(n)]
+
+    async def _write(self, batch: List[Any]):
+        try:
+            await self.sink(batch)
+            self.written += len(batch)
+            self.batches += 1
+        except Exception as e:
+            self.failed += len(batch)
+            logger.warning(f"{self.name} pipeline: failed to write {len(batch)} events: {e}")
+
+    async def _run(self):
+        while True:
+            try:
+                await asyncio.wait_for(self._wakeup.wait(), timeout=self.flush_interval)
+            except asyncio.TimeoutError:
+                pass
+            self._wakeup.clear()
+            while True:
+                batch = self._take_batch()
+                if not batch:
+                    break
+                await self._write(batch)
+
+    async def drain(self):
+        """Write everything currently queued (used on shutdown and in tests)."""
+        while True:
+            batch = self._take_batch()
+            if not batch:
+                return
+            await self._write(batch)
+
+    async def stop(self):
+        if self._task is not None:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        await self.drain()
+
+    def stats(self) -> Dict[str, Any]:
+        with self._lock:
+            depth = len(self._queue)
+        return {
+            "name": self.name,
+            "queue_depth": depth,
+            "max_queue": self.max_queue,
+            "offered": self.offered,
+            "written": self.written,
+            "dropped": self.dropped,
+            "failed": self.failed,
+            "batches": self.batches,
+            "events_last_minute": self.rate.total(),
+        }
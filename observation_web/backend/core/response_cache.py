@@ -0,0 +1,242 @@
+"""
+Versioned response cache with ETag / conditional GET for hot dashboard endpoints.
+
+Every table has a version counter.  SQLAlchemy session hooks record which
+tables a transaction wrote (ORM flushes, DML statements and raw ``text()``
+INSERT/UPDATE/DELETE) and bump their versions only after the commit has
+gone through, so a rollback invalidates nothing.  In-memory state that is
+not in the DB (runtime array status, SSH transport state) is bumped
+explicitly via ``bump()`` under a pseudo-table name.
+
+An endpoint declares the tables its response is derived from:
+
+    return await get_response_cache().serve(request, ("alerts",), build)
+
+The response body is serialized once and kept as bytes together with a
+content-hash ETag.  While none of the declared tables changed, repeated
+polls are answered from those bytes, and clients that send a matching
+``If-None-Match`` get an empty 304.  Entries also expire after ``max_age``
+seconds because several dashboard windows are relative to "now".
+"""
+
+import hashlib
+import json
+import logging
+import re
+import threading
+import time
+from collections import OrderedDict
+from typing import Any, Awaitable, Callable, Dict, Iterable, Optional, Set, Tuple
+
+from fastapi import Request
+from fastapi.encoders import jsonable_encoder
+from fastapi.responses import Response
+from sqlalchemy import event
+from sqlalchemy.orm import Session
+from sqlalchemy.sql.elements import TextClause
+
+logger = logging.getLogger(__name__)
+
+RESPONSE_CACHE_MAX_AGE = 30.0
+RESPONSE_CACHE_MAX_ENTRIES = 256
+
+# Pseudo-table bumped whenever in-memory array runtime status changes
+ARRAY_STATUS_STATE = "array_status_state"
+
+_DIRTY_KEY = "response_cache_dirty_tables"
+
+_WRITE_SQL_RE = re.compile(
+    r"^\s*(?:INSERT(?:\s+OR\s+\w+)?\s+INTO|REPLACE\s+INTO|UPDATE(?:\s+OR\s+\w+)?|DELETE\s+FROM)"
+    r"\s+[\"`\[]?(\w+)",
+    re.IGNORECASE,
+)
+
+
+class _Entry:
+    __slots__ = ("versions", "body", "etag", "created")
+
+    def __init__(self, versions: Tuple[int, ...], body: bytes, etag: str, created: float):
+        self.versions = versions
+        self.body = body
+        self.etag = etag
+        self.created = created
+
+
+def _etag_matches(header: Optional[str], etag: str) -> bool:
+    if not header:
+        return False
+    for candidate in header.split(","):
+        candidate = candidate.strip()
+        if candidate == "*":
+            return True
+        if candidate.startswith("W/"):
+            candidate = candidate[2:]
+        if candidate == etag:
+            return True
+    return False
+
+
+class ResponseCache:
+    """Pre-serialized JSON responses keyed by request and table versions."""
+
+    def __init__(
+        self,
+        max_age: float = RESPONSE_CACHE_MAX_AGE,
+        max_entries: int = RESPONSE_CACHE_MAX_ENTRIES,
+        clock: Callable[[], float] = time.monotonic,
+    ):
+        self.max_age = max_age
+        self.max_entries = max_entries
+        self._clock = clock
+        self._versions: Dict[str, int] = {}
+        self._entries: "OrderedDict[Tuple, _Entry]" = OrderedDict()
+        # Session hooks run inside the DB greenlet; bumps may also come from threads
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+        self.not_modified = 0
+
+    # ── Versions ─────────────────────────────────────────────
+
+    def bump(self, *tables: str):
+        with self._lock:
+            for table in tables:
+                self._versions[table] = self._versions.get(table, 0) + 1
+
+    def versions(self, tables: Iterable[str]) -> Tuple[int, ...]:
+        with self._lock:
+            return tuple(self._versions.get(t, 0) for t in tables)
+
+    def clear(self):
+        with self._lock:
+            self._entries.clear()
+
+    # ── Serving ──────────────────────────────────────────────
+
+    @staticmethod
+    def _key(request: Request, tables: Tuple[str, ...]) -> Tuple:
+        query = tuple(sorted(request.query_params.multi_items()))
+        return (request.url.path, query, tables)
+
+    def _lookup(self, key: Tuple, versions: Tuple[int, ...], max_age: float) -> Optional[_Entry]:
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is None:
+                return None
+            if entry.versions != versions or self._clock() - entry.created >= max_age:
+                del self._entries[key]
+                return None
+            self._entries.move_to_end(key)
+            return entry
+
+    def _store(self, key: Tuple, entry: _Entry):
+        with self._lock:
+            self._entries[key] = entry
+            self._entries.move_to_end(key)
+            while len(self._entries) > self.max_entries:
+                self._entries.popitem(last=False)
+
+    async def serve(
+        self,
+        request: Request,
+        tables: Iterable[str],
+        build: Callable[[], Awaitable[Any]],
+        max_age: Optional[float] = None,
+    ) -> Response:
+        """Answer from the cache, or call ``build()`` and cache its JSON."""
+        tables = tuple(tables)
+        max_age = self.max_age if max_age is None else max_age
+        key = self._key(request, tables)
+        # Read versions before building: a commit that lands mid-build makes
+        # the stored entry stale immediately instead of hiding the change.
+        versions = self.versions(tables)
+
+        entry = self._lookup(key, versions, max_age)
+        if entry is None:
+            self.misses += 1
+            data = await build()
+            body = json.dumps(
+                jsonable_encoder(data),
+                ensure_ascii=False,
+                allow_nan=False,
+                separators=(",", ":"),
+            ).encode("utf-8")
+            etag = '"%s"' % hashlib.sha1(body).hexdigest()
+            entry = _Entry(versions, body, etag, self._clock())
+            self._store(key, entry)
+        else:
+            self.hits += 1
+
+        headers = {"ETag": entry.etag, "Cache-Control": "no-cache"}
+        if _etag_matches(request.headers.get("if-none-match"), entry.etag):
+            self.not_modified += 1
+            return Response(status_code=304, headers=headers)
+        return Response(content=entry.body, media_type="application/json", headers=headers)
+
+    def stats(self) -> Dict[str, Any]:
+        with self._lock:
+            size = len(self._entries)
+        return {
+            "entries": size,
+            "hits": self.hits,
+            "misses": self.misses,
+            "not_modified": self.not_modified,
+        }
+
+
+_cache: Optional[ResponseCache] = None
+
+
+def get_response_cache() -> ResponseCache:
+    global _cache
+    if _cache is None:
+        _cache = ResponseCache()
+    return _cache
+
+
+# ---------------------------------------------------------------------------
+# Invalidation: track written tables per session, bump on commit
+# ---------------------------------------------------------------------------
+
+def _dirty(session: Session) -> Set[str]:
+    return session.info.setdefault(_DIRTY_KEY, set())
+
+
+def _table_of(obj: Any) -> Optional[str]:
+    table = getattr(type(obj), "__table__", None)
+    return getattr(table, "name", None)
+
+
+@event.listens_for(Session, "after_flush")
+def _record_flushed_tables(session: Session, flush_context):
+    dirty = _dirty(session)
+    for obj in list(session.new) + list(session.dirty) + list(session.deleted):
+        name = _table_of(obj)
+        if name:
+            dirty.add(name)
+
+
+@event.listens_for(Session, "do_orm_execute")
+def _record_statement_tables(orm_execute_state):
+    statement = orm_execute_state.statement
+    if orm_execute_state.is_insert or orm_execute_state.is_update or orm_execute_state.is_delete:
+        table = getattr(statement, "table", None)
+        name = getattr(table, "name", None)
+        if name:
+            _dirty(orm_execute_state.session).add(name)
+    elif isinstance(statement, TextClause):
+        match = _WRITE_SQL_RE.match(statement.text)
+        if match:
+            _dirty(orm_execute_state.session).add(match.group(1))
+
+
+@event.listens_for(Session, "after_commit")
+def _bump_committed_tables(session: Session):
+    tables = session.info.pop(_DIRTY_KEY, None)
+    if tables:
+        get_response_cache().bump(*tables)
+
+
+@event.listens_for(Session, "after_rollback")
+def _discard_rolled_back_tables(session: Session):
+    session.info.pop(_DIRTY_KEY, None)
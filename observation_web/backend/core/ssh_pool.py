@@ -12,7 +12,7 @@ import threading
 import time
 from concurrent.futures import ThreadPoolExecutor
 from datetime import datetime
-from typing import Any, Dict, List, Optional, Tuple
+from typing import Any, Dict, Iterator, List, Optional, Tuple
 
 from ..config import get_config
 from ..models.array import ConnectionState
@@ -303,6 +303,39 @@ class SSHConnection:
             logger.error(f"Command execution failed: {e}")
             return (-1, "", str(e))
     
+    def stream_command(
+        self,
+        command: str,
+        timeout: int = 60,
+        chunk_size: int = 64 * 1024,
+    ) -> Iterator[bytes]:
+        """
+        Execute command and yield its stdout as raw byte chunks.
+
+        Unlike execute(), the output is never held in memory as a whole, so
+        callers can decompress / parse arbitrarily large files incrementally.
+        ``timeout`` bounds each read, not the whole transfer. Closing the
+        generator early closes the channel. stderr is discarded.
+        """
+        if not self.ensure_connected():
+            return
+        self._last_activity = time.time()
+        channel = self._client.get_transport().open_session()
+        try:
+            channel.settimeout(timeout)
+            channel.exec_command(command)
+            while True:
+                chunk = channel.recv(chunk_size)
+                if not chunk:
+                    break
+                self._last_activity = time.time()
+                yield chunk
+                # Drain stderr so a chatty command cannot stall on a full buffer
+                while channel.recv_stderr_ready():
+                    channel.recv_stderr(chunk_size)
+        finally:
+            channel.close()
+
     async def execute_async(self, command: str, timeout: int = 30) -> Tuple[int, str, str]:
         """
         Execute command asynchronously using thread pool.
@@ -0,0 +1,167 @@
+"""
+Reference-counted live data streams pushed over WebSocket.
+
+A *topic* (e.g. ``("metrics", array_id)``) is backed by one polling task no
+matter how many viewers subscribe to it.  The task calls the topic's fetcher
+every ``interval`` seconds; fetchers are stateful (they keep their own cursor)
+and return only items that are new since the previous call.  Each batch of new
+items is fanned out to every subscriber, optionally narrowed by a per-subscriber
+filter (port, keyword, ...).
+
+The first subscription to a topic starts its task; the last unsubscribe
+cancels it.  Fetchers are provided by a factory registered per stream kind
+(see ``register_stream``), so this module stays independent of SSH / DB.
+"""
+
+import asyncio
+import itertools
+import logging
+from dataclasses import dataclass, field
+from typing import Any, Awaitable, Callable, Dict, Hashable, List, Optional
+
+logger = logging.getLogger(__name__)
+
+Fetcher = Callable[[], Awaitable[List[Any]]]
+Deliver = Callable[[List[Any]], Awaitable[None]]
+ItemFilter = Callable[[Any], bool]
+
+
+@dataclass
+class StreamSpec:
+    """How to build and poll one kind of stream."""
+    # (params) -> topic key; params that only narrow delivery must not be part of it
+    topic: Callable[[Dict[str, Any]], Hashable]
+    # (params) -> stateful fetcher returning new items since the last call
+    make_fetcher: Callable[[Dict[str, Any]], Fetcher]
+    interval: float
+    # (params) -> per-subscriber filter, or None to deliver everything
+    make_filter: Optional[Callable[[Dict[str, Any]], Optional[ItemFilter]]] = None
+    # (params) -> None; raises ValueError for unacceptable params
+    validate: Optional[Callable[[Dict[str, Any]], None]] = None
+
+
+@dataclass
+class _Subscriber:
+    sub_id: int
+    deliver: Deliver
+    item_filter: Optional[ItemFilter] = None
+
+
+@dataclass
+class _Topic:
+    key: Hashable
+    fetcher: Fetcher
+    interval: float
+    subscribers: Dict[int, _Subscriber] = field(default_factory=dict)
+    task: Optional[asyncio.Task] = None
+    fetch_count: int = 0
+
+
+class StreamHub:
+    """Owns one poller per active topic and the subscribers attached to it."""
+
+    def __init__(self):
+        self._specs: Dict[str, StreamSpec] = {}
+        self._topics: Dict[Hashable, _Topic] = {}
+        self._sub_topic: Dict[int, Hashable] = {}
+        self._ids = itertools.count(1)
+        self._lock = asyncio.Lock()
+
+    def register_stream(self, kind: str, spec: StreamSpec):
+        self._specs[kind] = spec
+
+    def has_stream(self, kind: str) -> bool:
+        return kind in self._specs
+
+    async def subscribe(self, kind: str, params: Dict[str, Any], deliver: Deliver) -> int:
+        """Attach a subscriber; starts the topic's poller on first use. Returns a sub id."""
+        spec = self._specs.get(kind)
+        if spec is None:
+            raise ValueError(f"Unknown stream: {kind}")
+        if spec.validate:
+            spec.validate(params)
+
+        key = (kind, spec.topic(params))
+        item_filter = spec.make_filter(params) if spec.make_filter else None
+
+        async with self._lock:
+            topic = self._topics.get(key)
+            if topic is None:
+                topic = _Topic(key=key, fetcher=spec.make_fetcher(params), interval=spec.interval)
+                self._topics[key] = topic
+                topic.task = asyncio.create_task(self._poll_loop(topic))
+                logger.info(f"Stream started: {key}")
+            sub_id = next(self._ids)
+            topic.subscribers[sub_id] = _Subscriber(sub_id, deliver, item_filter)
+            self._sub_topic[sub_id] = key
+        return sub_id
+
+    async def unsubscribe(self, sub_id: int):
+        """Detach a subscriber; stops the poller when its topic has no subscribers left."""
+        task = None
+        async with self._lock:
+            key = self._sub_topic.pop(sub_id, None)
+            topic = self._topics.get(key) if key is not None else None
+            if topic is None:
+                return
+            topic.subscribers.pop(sub_id, None)
+            if not topic.subscribers:
+                del self._topics[key]
+                task = topic.task
+                logger.info(f"Stream stopped: {key}")
+        if task:
+            task.cancel()
+            try:
+                await task
+            except (asyncio.CancelledError, Exception):
+                pass
+
+    async def _poll_loop(self, topic: _Topic):
+        while True:
+            try:
+                items = await topic.fetcher()
+                topic.fetch_count += 1
+                if items:
+                    await self._fan_out(topic, items)
+            except asyncio.CancelledError:
+                raise
+            except Exception as e:
+                logger.warning(f"Stream fetch failed for {topic.key}: {e}")
+            await asyncio.sleep(topic.interval)
+
+    async def _fan_out(self, topic: _Topic, items: List[Any]):
+        for sub in list(topic.subscribers.values()):
+            payload = [i for i in items if sub.item_filter(i)] if sub.item_filter else items
+            if not payload:
+                continue
+            try:
+                await sub.deliver(payload)
+            except Exception as e:
+                logger.warning(f"Stream delivery failed for {topic.key}: {e}")
+
+    # ── Introspection (status endpoints / tests) ──
+
+    def topic_count(self) -> int:
+        return len(self._topics)
+
+    def subscriber_count(self, kind: str, params: Dict[str, Any]) -> int:
+        spec = self._specs.get(kind)
+        if spec is None:
+            return 0
+        topic = self._topics.get((kind, spec.topic(params)))
+        return len(topic.subscribers) if topic else 0
+
+    def fetch_count(self, kind: str, params: Dict[str, Any]) -> int:
+        spec = self._specs.get(kind)
+        topic = self._topics.get((kind, spec.topic(params))) if spec else None
+        return topic.fetch_count if topic else 0
+
+
+_hub: Optional[StreamHub] = None
+
+
+def get_stream_hub() -> StreamHub:
+    global _hub
+    if _hub is None:
+        _hub = StreamHub()
+    return _hub
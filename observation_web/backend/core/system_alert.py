@@ -5,6 +5,7 @@ Provides centralized error logging and retrieval for debugging.
 Supports file-based archiving when memory buffer reaches capacity.
 """
 
+import asyncio
 import json
 import logging
 import os
@@ -16,6 +17,8 @@ from enum import Enum
 from pathlib import Path
 from typing import Any, Dict, List, Optional
 
+from .event_pipeline import EventPipeline
+
 logger = logging.getLogger(__name__)
 
 
@@ -50,7 +53,11 @@ class SystemAlert:
         if exception:
             self.details["exception_type"] = type(exception).__name__
             self.details["exception_message"] = str(exception)
-            self.traceback = traceback.format_exc()
+            # Format from the exception itself so this also works off the
+            # raising context (e.g. in the HTTP event pipeline writer)
+            self.traceback = "".join(traceback.format_exception(
+                type(exception), exception, exception.__traceback__,
+            ))
     
     def to_dict(self) -> Dict[str, Any]:
         return {
@@ -222,3 +229,44 @@ def sys_error(module: str, message: str, details: Optional[Dict] = None, excepti
 
 def sys_critical(module: str, message: str, details: Optional[Dict] = None, exception: Optional[Exception] = None):
     get_system_alert_store().add(AlertLevel.CRITICAL, module, message, details, exception)
+
+
+# ── HTTP error tracking pipeline ──
+# ErrorTrackingMiddleware only queues events; the writer records them in the
+# store (logging, traceback formatting, archive file I/O) on a worker thread.
+
+def _record_events_sync(events: List[Dict[str, Any]]):
+    store = get_system_alert_store()
+    for ev in events:
+        store.add(ev["level"], ev["module"], ev["message"], ev.get("details"), ev.get("exception"))
+
+
+async def _record_events(events: List[Dict[str, Any]]):
+    loop = asyncio.get_running_loop()
+    await loop.run_in_executor(None, _record_events_sync, events)
+
+
+_http_event_pipeline: Optional[EventPipeline] = None
+
+
+def get_http_event_pipeline() -> EventPipeline:
+    global _http_event_pipeline
+    if _http_event_pipeline is None:
+        _http_event_pipeline = EventPipeline("http_errors", _record_events, max_queue=5000)
+    return _http_event_pipeline
+
+
+def queue_http_event(
+    level: AlertLevel,
+    message: str,
+    details: Optional[Dict] = None,
+    exception: Optional[Exception] = None,
+) -> bool:
+    """Queue an HTTP error / slow-request event without blocking the request."""
+    return get_http_event_pipeline().offer({
+        "level": level,
+        "module": "http",
+        "message": message,
+        "details": details,
+        "exception": exception,
+    })
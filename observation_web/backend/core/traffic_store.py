@@ -14,11 +14,17 @@ from sqlalchemy import select, delete, func, distinct, and_
 from sqlalchemy.ext.asyncio import AsyncSession
 
 from ..models.traffic import PortTrafficModel
+from .downsample import minmax_rows
 
 logger = logging.getLogger(__name__)
 
-# Maximum data points returned per query (prevents UI/API stall)
+# Default number of data points returned per query (prevents UI/API stall).
+# Longer windows are decimated down to this, not truncated.
 MAX_QUERY_POINTS = 500
+# Hard cap on raw rows read per query before decimation (newest rows win)
+RAW_QUERY_LIMIT = 20000
+# Columns whose extremes must survive decimation
+RATE_KEYS = ('tx_rate_bps', 'rx_rate_bps')
 # Retention period
 RETENTION_HOURS = 2
 
@@ -82,6 +88,7 @@ class TrafficStore:
         array_id: str,
         port_name: str,
         minutes: int = 30,
+        max_points: int = MAX_QUERY_POINTS,
     ) -> List[Dict[str, Any]]:
         """
         Query traffic data for a specific port.
@@ -90,9 +97,11 @@ class TrafficStore:
             array_id: Array ID
             port_name: Port name
             minutes: Time range in minutes (max 120)
+            max_points: Point budget; the whole window is min/max-decimated
+                to roughly this many points so TX/RX peaks are preserved
 
         Returns:
-            List of data points
+            List of data points in ascending time order
         """
         minutes = min(minutes, 120)
         cutoff = datetime.now() - timedelta(minutes=minutes)
@@ -104,14 +113,14 @@ class TrafficStore:
                 PortTrafficModel.port_name == port_name,
                 PortTrafficModel.timestamp >= cutoff,
             ))
-            .order_by(PortTrafficModel.timestamp.asc())
-            .limit(MAX_QUERY_POINTS)
+            .order_by(PortTrafficModel.timestamp.desc())
+            .limit(RAW_QUERY_LIMIT)
         )
 
         result = await db.execute(query)
-        rows = result.scalars().all()
+        rows = list(reversed(result.scalars().all()))
 
-        return [
+        points = [
             {
                 'ts': r.timestamp.isoformat(),
                 'tx_bytes': r.tx_bytes,
@@ -123,6 +132,7 @@ class TrafficStore:
             }
             for r in rows
         ]
+        return minmax_rows(points, max_points, RATE_KEYS)
 
     async def get_ports(
         self,
@@ -147,6 +157,20 @@ class TrafficStore:
         result = await db.execute(query)
         return [row[0] for row in result.all()]
 
+    async def latest_timestamps(
+        self,
+        db: AsyncSession,
+        array_id: str,
+    ) -> Dict[str, datetime]:
+        """Newest stored timestamp per port (used as the live-stream cursor)."""
+        query = (
+            select(PortTrafficModel.port_name, func.max(PortTrafficModel.timestamp))
+            .where(PortTrafficModel.array_id == array_id)
+            .group_by(PortTrafficModel.port_name)
+        )
+        result = await db.execute(query)
+        return {port: ts for port, ts in result.all() if ts is not None}
+
     async def cleanup_expired(self, db: AsyncSession) -> int:
         """
         Delete all traffic records older than RETENTION_HOURS.
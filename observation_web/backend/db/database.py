@@ -4,6 +4,7 @@ Database configuration and session management.
 
 import logging
 import os
+import sqlite3
 from pathlib import Path
 
 from sqlalchemy import event, text
@@ -23,6 +24,22 @@ class Base(DeclarativeBase):
 _async_engine = None
 AsyncSessionLocal = None
 
+# Bulk ack / expiry statements use RETURNING and json_each (SQLite 3.35+)
+MIN_SQLITE_VERSION = (3, 35, 0)
+
+
+def check_sqlite_version(version_info=None) -> bool:
+    """Log an error and return False when the linked SQLite is too old."""
+    version_info = version_info or sqlite3.sqlite_version_info
+    if tuple(version_info) >= MIN_SQLITE_VERSION:
+        return True
+    logger.error(
+        "SQLite %s is too old: %s+ is required (RETURNING / json_each); "
+        "alert acknowledgement endpoints will fail",
+        ".".join(map(str, version_info)), ".".join(map(str, MIN_SQLITE_VERSION)),
+    )
+    return False
+
 
 def get_async_engine():
     """Return the async engine (for fallback table creation)."""
@@ -48,6 +65,7 @@ def init_db():
     
     config = get_config()
     database_url = get_database_url()
+    check_sqlite_version()
     
     # Connection pool settings for concurrent access
     _async_engine = create_async_engine(
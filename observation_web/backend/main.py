@@ -16,7 +16,8 @@ from fastapi.responses import JSONResponse
 from starlette.middleware.base import BaseHTTPMiddleware
 
 from .config import get_config, __version__
-from .core.system_alert import sys_error, sys_warning, sys_info
+from .core.system_alert import sys_error, sys_warning, sys_info, AlertLevel, queue_http_event, get_http_event_pipeline
+from .core.audit import get_audit_pipeline
 from .db.database import init_db, create_tables, Base, get_async_engine
 from .api import arrays_router, alerts_router, query_router, ws_router, tags_router, alert_rules_router, audit_router
 from .api.auth import router as auth_router
@@ -37,10 +38,12 @@ from .api.users import router as users_router
 from .api.ai import router as ai_router
 from .api.card_inventory import router as card_inventory_router
 from .api.agent_package import router as agent_package_router
-from .middleware.user_session import UserSessionMiddleware
+from .middleware.user_session import UserSessionMiddleware, get_presence_tracker
 from .core.ssh_pool import get_ssh_pool
 from .core.scheduler import get_scheduler
 from .core.alert_sync import start_alert_sync, stop_alert_sync
+from .core.ai_service import reset_http_client
+from .core.ack_expiry import get_ack_expiry_scheduler
 from .models.array import ArrayModel
 from sqlalchemy import select
 
@@ -100,26 +103,6 @@ async def _idle_connection_cleaner():
             except Exception as e:
                 _track_bg_failure("idle_cleanup/traffic", e)
 
-            # Every cycle: cleanup expired alert acknowledgements
-            try:
-                from .db.database import AsyncSessionLocal
-                from .models.alert import AlertAckModel
-                from sqlalchemy import delete as sa_delete
-                from datetime import datetime as _dt
-                if AsyncSessionLocal:
-                    async with AsyncSessionLocal() as session:
-                        result = await session.execute(
-                            sa_delete(AlertAckModel).where(
-                                AlertAckModel.ack_expires_at.isnot(None),
-                                AlertAckModel.ack_expires_at <= _dt.now(),
-                            )
-                        )
-                        if result.rowcount > 0:
-                            await session.commit()
-                            logger.info(f"Cleaned up {result.rowcount} expired alert acknowledgements")
-                _reset_bg_failure("idle_cleanup/ack")
-            except Exception as e:
-                _track_bg_failure("idle_cleanup/ack", e)
             _reset_bg_failure("idle_connection_cleaner")
         except asyncio.CancelledError:
             break
@@ -376,6 +359,12 @@ async def lifespan(app: FastAPI):
 
     # Start alert sync (periodic SSH pull of alerts from connected arrays)
     start_alert_sync()
+
+    # Write-behind flush of user presence
+    get_presence_tracker().start()
+
+    # Lapse alert acknowledgements exactly at ack_expires_at
+    get_ack_expiry_scheduler().start()
     
     yield
     
@@ -398,6 +387,15 @@ async def lifespan(app: FastAPI):
     stop_alert_sync()
     logger.info("Alert sync stopped")
 
+    # Flush pending user presence
+    await get_presence_tracker().stop()
+
+    await get_ack_expiry_scheduler().stop()
+
+    # Drain queued audit / HTTP error events
+    await get_audit_pipeline().stop()
+    await get_http_event_pipeline().stop()
+
     # Stop scheduler
     scheduler = get_scheduler()
     scheduler.stop()
@@ -408,6 +406,9 @@ async def lifespan(app: FastAPI):
     ssh_pool.close_all()
     logger.info("SSH connections closed")
 
+    # Close pooled AI API client
+    await reset_http_client()
+
 
 class ErrorTrackingMiddleware(BaseHTTPMiddleware):
     """Middleware to track errors and slow requests"""
@@ -422,8 +423,8 @@ class ErrorTrackingMiddleware(BaseHTTPMiddleware):
             # Track slow requests (>5 seconds)
             duration = time.time() - start_time
             if duration > 5:
-                sys_warning(
-                    "http",
+                queue_http_event(
+                    AlertLevel.WARNING,
                     f"Slow request: {request.method} {request.url.path}",
                     {"duration_seconds": round(duration, 2), "status_code": response.status_code}
                 )
@@ -431,9 +432,9 @@ class ErrorTrackingMiddleware(BaseHTTPMiddleware):
             return response
             
         except Exception as e:
-            # Log unhandled exceptions to system alerts
-            sys_error(
-                "http",
+            # Log unhandled exceptions to system alerts (queued; written off the request path)
+            queue_http_event(
+                AlertLevel.ERROR,
                 f"Unhandled exception: {request.method} {request.url.path}",
                 {"error": str(e), "path": str(request.url)},
                 exception=e
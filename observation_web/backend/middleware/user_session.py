@@ -1,22 +1,27 @@
 """
 User session middleware for IP-based user tracking.
 
-Extracts user IP from requests and maintains session records.
+Extracts user IP from requests and records presence in memory.  Presence
+is persisted to user_sessions by a periodic batched upsert (write-behind),
+so the request path never touches the database.
 """
 
 import asyncio
 import hashlib
 import logging
 from datetime import datetime, timedelta
+from typing import Dict, List, Optional
 
 from fastapi import Request
 
 logger = logging.getLogger(__name__)
 
-# In-memory cache for user sessions to reduce DB writes
-_session_cache: dict = {}
-_CACHE_UPDATE_INTERVAL = 15  # seconds
-_session_update_tasks: dict = {}
+# Seconds between batched presence upserts
+PRESENCE_FLUSH_INTERVAL = 15
+# In-memory entries older than this are dropped (after being flushed)
+PRESENCE_RETENTION = timedelta(hours=1)
+# Rows per upsert statement (4 bound params each; stays under SQLite's 999 limit)
+PRESENCE_UPSERT_CHUNK = 200
 
 
 def get_client_ip(request: Request) -> str:
@@ -73,12 +78,134 @@ def ip_to_color(ip: str) -> str:
     return f"#{r:02x}{g:02x}{b:02x}"
 
 
+class PresenceTracker:
+    """
+    In-memory presence index with write-behind persistence.
+
+    touch() is O(1) and synchronous; flush() upserts every IP seen since the
+    previous flush into user_sessions in one transaction.  Nicknames are
+    cached here (loaded on flush, updated by the users API) so online-user
+    queries are answered from memory.
+    """
+
+    def __init__(self, flush_interval: float = PRESENCE_FLUSH_INTERVAL):
+        self.flush_interval = flush_interval
+        self._entries: Dict[str, dict] = {}   # ip -> {page, timestamp}
+        self._nicknames: Dict[str, str] = {}
+        self._dirty: set = set()
+        self._task: Optional[asyncio.Task] = None
+
+    def touch(self, ip: str, page: str):
+        self._entries[ip] = {'page': page, 'timestamp': datetime.now()}
+        self._dirty.add(ip)
+
+    def set_nickname(self, ip: str, nickname: str):
+        self._nicknames[ip] = nickname or ""
+
+    def get_nickname(self, ip: str) -> str:
+        return self._nicknames.get(ip, "")
+
+    def forget(self, ip: str):
+        self._entries.pop(ip, None)
+        self._nicknames.pop(ip, None)
+        self._dirty.discard(ip)
+
+    def active(self, max_age_seconds: float) -> Dict[str, dict]:
+        cutoff = datetime.now() - timedelta(seconds=max_age_seconds)
+        return {ip: info for ip, info in self._entries.items() if info['timestamp'] > cutoff}
+
+    def on_page(self, page: str, max_age_seconds: float) -> List[str]:
+        return [ip for ip, info in self.active(max_age_seconds).items() if info['page'] == page]
+
+    def pending_count(self) -> int:
+        return len(self._dirty)
+
+    async def flush(self) -> int:
+        """Upsert last_seen for every IP touched since the last flush. Returns rows written."""
+        if not self._dirty:
+            return 0
+        from ..db.database import AsyncSessionLocal
+        if not AsyncSessionLocal:
+            return 0
+
+        ips, self._dirty = self._dirty, set()
+        rows = [
+            {'ip': ip, 'nickname': '', 'is_active': True, 'last_seen': self._entries[ip]['timestamp']}
+            for ip in ips if ip in self._entries
+        ]
+        try:
+            await self._upsert(AsyncSessionLocal, rows)
+        except Exception as e:
+            # Keep them dirty; the next flush retries
+            self._dirty |= ips
+            logger.warning(f"Failed to flush user presence: {e}")
+            return 0
+
+        cutoff = datetime.now() - PRESENCE_RETENTION
+        for ip in [ip for ip, info in self._entries.items() if info['timestamp'] < cutoff]:
+            if ip not in self._dirty:
+                del self._entries[ip]
+        return len(rows)
+
+    async def _upsert(self, session_factory, rows: List[dict]):
+        from sqlalchemy import select
+        from sqlalchemy.dialects.sqlite import insert as sqlite_upsert
+        from ..models.user_session import UserSessionModel
+
+        async with session_factory() as session:
+            for i in range(0, len(rows), PRESENCE_UPSERT_CHUNK):
+                chunk = rows[i:i + PRESENCE_UPSERT_CHUNK]
+                stmt = sqlite_upsert(UserSessionModel).values(chunk)
+                stmt = stmt.on_conflict_do_update(
+                    index_elements=['ip'],
+                    set_={'last_seen': stmt.excluded.last_seen, 'is_active': True},
+                )
+                await session.execute(stmt)
+                result = await session.execute(
+                    select(UserSessionModel.ip, UserSessionModel.nickname)
+                    .where(UserSessionModel.ip.in_([r['ip'] for r in chunk]))
+                )
+                for ip, nickname in result.all():
+                    self._nicknames[ip] = nickname or ""
+            await session.commit()
+
+    async def _flush_loop(self):
+        while True:
+            await asyncio.sleep(self.flush_interval)
+            await self.flush()
+
+    def start(self):
+        if self._task is None or self._task.done():
+            self._task = asyncio.create_task(self._flush_loop())
+
+    async def stop(self):
+        """Stop the flush loop and write out anything still pending."""
+        if self._task:
+            self._task.cancel()
+            try:
+                await self._task
+            except asyncio.CancelledError:
+                pass
+            self._task = None
+        await self.flush()
+
+
+_tracker: Optional[PresenceTracker] = None
+
+
+def get_presence_tracker() -> PresenceTracker:
+    global _tracker
+    if _tracker is None:
+        _tracker = PresenceTracker()
+    return _tracker
+
+
 class UserSessionMiddleware:
     """
     Middleware to track user sessions by IP.
 
-    Updates session records on each request (with caching to reduce DB load).
-    Injects user_ip into request.state for use by endpoints.
+    Records presence in memory on each request (persisted write-behind by
+    PresenceTracker). Injects user_ip into request.state for use by endpoints.
     """
 
     def __init__(self, app):
@@ -101,100 +228,19 @@ class UserSessionMiddleware:
         page = _api_path_to_page(str(request.url.path))
         update_user_presence(user_ip, page)
 
-        # Update session in background (non-blocking), coalesced per IP
-        existing_task = _session_update_tasks.get(user_ip)
-        if existing_task is None or existing_task.done():
-            task = asyncio.create_task(self._update_session(user_ip, page))
-            _session_update_tasks[user_ip] = task
-            task.add_done_callback(lambda t, ip=user_ip: self._on_session_task_done(ip, t))
-
         await self.app(scope, receive, send)
 
-    @staticmethod
-    def _on_session_task_done(ip: str, task: asyncio.Task) -> None:
-        _session_update_tasks.pop(ip, None)
-        try:
-            task.result()
-        except Exception as e:
-            logger.warning(f"Failed to update user session: {e}")
-
-    async def _update_session(self, ip: str, current_page: str):
-        """
-        Update user session record.
-
-        Uses caching to reduce DB writes - only updates if more than
-        CACHE_UPDATE_INTERVAL seconds have passed since last update.
-        """
-        now = datetime.now()
-
-        # Check cache
-        cached = _session_cache.get(ip)
-        if cached and (now - cached['last_update']).seconds < _CACHE_UPDATE_INTERVAL:
-            return
-
-        # Update cache
-        _session_cache[ip] = {
-            'last_update': now,
-            'current_page': current_page,
-        }
-
-        # Update database (async, non-blocking)
-        try:
-            from ..db.database import AsyncSessionLocal
-            from ..models.user_session import UserSessionModel
-            from sqlalchemy import select
-
-            if not AsyncSessionLocal:
-                return
-
-            async with AsyncSessionLocal() as session:
-                result = await session.execute(
-                    select(UserSessionModel).where(UserSessionModel.ip == ip)
-                )
-                user_session = result.scalar_one_or_none()
-
-                if user_session:
-                    user_session.last_seen = now
-                    user_session.is_active = True
-                else:
-                    user_session = UserSessionModel(
-                        ip=ip,
-                        nickname="",
-                        is_active=True,
-                    )
-                    session.add(user_session)
-
-                await session.commit()
-
-        except Exception as e:
-            logger.warning(f"Failed to update user session: {e}")
-
-
-# Store for tracking which page each user is viewing (for presence)
-_user_presence: dict = {}
-
 
 def update_user_presence(ip: str, page: str):
     """Update which page a user is currently viewing."""
-    _user_presence[ip] = {
-        'page': page,
-        'timestamp': datetime.now(),
-    }
+    get_presence_tracker().touch(ip, page)
 
 
 def get_users_on_page(page: str, max_age_seconds: int = 60) -> list:
     """Get list of user IPs currently viewing a specific page."""
-    cutoff = datetime.now() - timedelta(seconds=max_age_seconds)
-    return [
-        ip for ip, info in _user_presence.items()
-        if info['page'] == page and info['timestamp'] > cutoff
-    ]
+    return get_presence_tracker().on_page(page, max_age_seconds)
 
 
 def get_all_presence() -> dict:
     """Get all user presence info."""
-    cutoff = datetime.now() - timedelta(seconds=120)
-    return {
-        ip: info for ip, info in _user_presence.items()
-        if info['timestamp'] > cutoff
-    }
+    return get_presence_tracker().active(120)
@@ -14,6 +14,8 @@ class AIInterpretationModel(Base):
 
     id = Column(Integer, primary_key=True, index=True)
     alert_id = Column(Integer, unique=True, index=True, nullable=False)
+    # core.ai_cache.interpretation_key; alerts with equal content share an interpretation
+    content_key = Column(String(64), index=True, default="")
     interpretation = Column(Text, nullable=False)
     model_name = Column(String(64), default="")
     created_at = Column(DateTime, server_default=func.now())
@@ -45,6 +45,8 @@ class AlertModel(Base):
         Index('ix_alerts_level_timestamp', 'level', 'timestamp'),
         Index('ix_alerts_array_observer_ts', 'array_id', 'observer_name', 'timestamp'),
         Index('ix_alerts_is_expected', 'is_expected'),
+        # Covers timeline keyset scans (rowid id is implicit in SQLite indexes)
+        Index('ix_alerts_timeline', 'array_id', 'timestamp', 'observer_name', 'level'),
     )
 
 
@@ -131,6 +133,8 @@ class AlertAckModel(Base):
 
     __table_args__ = (
         Index('ix_ack_alert_id', 'alert_id'),
+        # Earliest pending expiry for the ack expiry timer
+        Index('ix_ack_expires_at', 'ack_expires_at'),
     )
 
 
@@ -4,7 +4,7 @@ from datetime import datetime
 from typing import Optional
 
 from pydantic import BaseModel, ConfigDict
-from sqlalchemy import Column, Integer, String, Text, DateTime, UniqueConstraint
+from sqlalchemy import Column, Integer, String, Text, DateTime, Index, UniqueConstraint
 from sqlalchemy.sql import func
 
 from ..db.database import Base
@@ -29,6 +29,40 @@ class CardInventoryModel(Base):
     )
 
 
+class CardSearchTokenModel(Base):
+    """Search index for card_inventory - every suffix of every lowercased
+    word of card_no / board_id / model, so keyword substring search becomes
+    an index range scan (see core/card_inventory.py)."""
+    __tablename__ = "card_search_tokens"
+
+    token = Column(String(256), primary_key=True)
+    card_id = Column(Integer, primary_key=True)
+
+    __table_args__ = (
+        Index("ix_card_search_tokens_card_id", "card_id"),
+    )
+
+
+class CardJournalModel(Base):
+    """Card inventory change journal - one row per insert / remove / state change."""
+    __tablename__ = "card_inventory_journal"
+
+    id = Column(Integer, primary_key=True, index=True)
+    array_id = Column(String(64), nullable=False)
+    card_no = Column(String(32), default="")
+    board_id = Column(String(64), default="")
+    model = Column(String(256), default="")
+    change = Column(String(16), nullable=False)  # insert / remove / state
+    old_state = Column(String(64), default="")  # "health/running"
+    new_state = Column(String(64), default="")
+    changed_at = Column(DateTime, nullable=False)
+
+    __table_args__ = (
+        Index("ix_card_journal_changed_at", "changed_at"),
+        Index("ix_card_journal_array_changed", "array_id", "changed_at"),
+    )
+
+
 class CardInventoryResponse(BaseModel):
     """Response schema including joined array info."""
     id: int
@@ -48,9 +82,27 @@ class CardInventoryResponse(BaseModel):
     model_config = ConfigDict(from_attributes=True)
 
 
+class CardJournalResponse(BaseModel):
+    """Schema for a card inventory journal entry."""
+    id: int
+    array_id: str
+    card_no: str = ""
+    board_id: str = ""
+    model: str = ""
+    change: str
+    old_state: str = ""
+    new_state: str = ""
+    changed_at: datetime
+
+    model_config = ConfigDict(from_attributes=True)
+
+
 class CardSyncResult(BaseModel):
     """Result of a card sync operation."""
     synced: int = 0
+    inserted: int = 0
+    removed: int = 0
+    state_changed: int = 0
     errors: list[str] = []
     skipped_arrays: list[str] = []
     synced_arrays: list[str] = []
@@ -6,7 +6,7 @@ from datetime import datetime
 from typing import Any, Dict, List, Optional
 
 from pydantic import BaseModel, ConfigDict
-from sqlalchemy import Column, Integer, String, DateTime, Text, Boolean, LargeBinary
+from sqlalchemy import Column, Integer, String, DateTime, Text, Boolean, LargeBinary, Index
 from sqlalchemy.sql import func
 
 from ..db.database import Base
@@ -24,6 +24,21 @@ class SyncStateModel(Base):
     last_timestamp = Column(DateTime, nullable=True)
     last_sync_at = Column(DateTime, nullable=True)
     total_imported = Column(Integer, default=0)
+    # Highest alerts.id already folded into alert_hashes for this array
+    hash_indexed_id = Column(Integer, default=0)
+
+
+class AlertHashModel(Base):
+    """Persisted dedup index for history import: one row per alert content hash"""
+    __tablename__ = "alert_hashes"
+
+    array_id = Column(String(64), primary_key=True)
+    hash = Column(String(32), primary_key=True)  # md5(timestamp|observer|message)
+    timestamp = Column(DateTime, nullable=True)
+
+    __table_args__ = (
+        Index('ix_alert_hashes_timestamp', 'timestamp'),
+    )
 
 
 class AlertsArchiveModel(Base):
@@ -33,11 +48,39 @@ class AlertsArchiveModel(Base):
     id = Column(Integer, primary_key=True, index=True)
     array_id = Column(String(64), index=True, nullable=False)
     year_month = Column(String(7), index=True, nullable=False)  # e.g., "2026-02"
-    data_compressed = Column(LargeBinary, nullable=False)  # gzip compressed JSON
+    # Legacy single-blob gzip JSON; empty once the month is stored as chunks
+    data_compressed = Column(LargeBinary, nullable=False)
     record_count = Column(Integer, default=0)
     created_at = Column(DateTime, server_default=func.now())
 
 
+class AlertsArchiveChunkModel(Base):
+    """
+    Fixed-size compressed slice of an array/month archive.
+
+    Records inside a chunk are sorted by timestamp; the min/max timestamp,
+    observer and level columns form a sparse index so queries only inflate
+    chunks that can contain matching alerts.
+    """
+    __tablename__ = "alerts_archive_chunks"
+
+    id = Column(Integer, primary_key=True)
+    array_id = Column(String(64), nullable=False)
+    year_month = Column(String(7), nullable=False)
+    seq = Column(Integer, nullable=False, default=0)
+    min_ts = Column(String(32), nullable=False)  # ISO timestamp of first record
+    max_ts = Column(String(32), nullable=False)  # ISO timestamp of last record
+    observers = Column(Text, default=",")  # ",obs_a,obs_b," for LIKE matching
+    levels = Column(String(64), default=",")  # ",info,warning,"
+    record_count = Column(Integer, default=0)
+    data_compressed = Column(LargeBinary, nullable=False)  # gzip compressed JSON list
+
+    __table_args__ = (
+        Index('ix_archive_chunks_array_month', 'array_id', 'year_month', 'seq'),
+        Index('ix_archive_chunks_range', 'array_id', 'max_ts', 'min_ts'),
+    )
+
+
 class ArchiveConfigModel(Base):
     """Archive configuration"""
     __tablename__ = "archive_config"
@@ -85,6 +128,7 @@ class ImportResult(BaseModel):
     imported_count: int
     skipped_count: int
     message: str
+    failed_files: List[str] = []
 
 
 class ArchiveConfig(BaseModel):
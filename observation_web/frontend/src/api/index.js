@@ -166,11 +166,11 @@ export default {
     }),
   restoreAgentConfig: (id) => http.post(`/arrays/${id}/agent-config/restore`),
   // Metrics
-  getArrayMetrics: (id, minutes = 60) => http.get(`/arrays/${id}/metrics`, { params: { minutes } }),
+  getArrayMetrics: (id, minutes = 60, maxPoints) => http.get(`/arrays/${id}/metrics`, { params: { minutes, max_points: maxPoints } }),
 
   // Port Traffic
   getTrafficPorts: (arrayId) => http.get(`/traffic/${arrayId}/ports`),
-  getTrafficData: (arrayId, port, minutes = 30) => http.get(`/traffic/${arrayId}/data`, { params: { port, minutes } }),
+  getTrafficData: (arrayId, port, minutes = 30, maxPoints) => http.get(`/traffic/${arrayId}/data`, { params: { port, minutes, max_points: maxPoints } }),
   syncTraffic: (arrayId) => httpLong.post(`/traffic/${arrayId}/sync`),
   getTrafficDiagnostic: (arrayId) => http.get(`/traffic/${arrayId}/diagnostic`),
   getTrafficModeInfo: (arrayId) => http.get(`/traffic/${arrayId}/mode-info`),
@@ -2,122 +2,23 @@
  * Composable: alert folding logic.
  *
  * Groups alerts that represent the SAME recurring issue into collapsible
- * groups. The folding key is observer-aware:
- * - alarm_type: fold by objType + action (同类告警反复上报才折叠)
- * - card_info: fold by slot + board_id (同一张卡反复上报才折叠)
- * - error_code: fold by port (同端口误码才折叠)
- * - link_status: fold by port (同端口链路变化才折叠)
- * - Others: fold by message skeleton (通用兜底)
- */
-import { computed, reactive } from 'vue'
-import { translateAlert } from '@/utils/alertTranslator'
-
-export const LEVEL_RANK = { critical: 4, error: 3, warning: 2, info: 1 }
-
-function getTranslatedSummary(row) {
-  const result = translateAlert(row)
-  return result.summary || row.message
-}
-
-/**
- * Extract a semantic identity from alert details for smarter folding.
- * Returns a string that distinguishes different "subjects" within the same observer.
- * Alerts with the same identity represent the SAME recurring issue.
+ * groups (see utils/alertFolding.js for the observer-aware folding keys).
+ *
+ * Translation and identity extraction run in a Web Worker via
+ * utils/alertFoldingClient.js and are cached per alert, so a store update
+ * only pays for the alerts that are new.  Alerts whose annotation has not
+ * come back yet are shown unfolded with their raw message and merge into
+ * their group as soon as the worker answers.
  */
-function getAlertIdentity(alert) {
-  const d = alert.details || {}
-  const obs = alert.observer_name
-
-  if (obs === 'alarm_type') {
-    // Fold by objType + action so same-type faults group together,
-    // but DiskEnclosure faults don't mix with FanModule faults
-    const first = (d.new_send_alarms || [])[0] || (d.new_resume_alarms || [])[0] || (d.new_events || [])[0]
-    if (first) {
-      return `${first.obj_type || first.alarm_name || '?'}|${first.action || (first.is_resume ? 'resume' : first.is_event ? 'event' : 'fault')}`
-    }
-  }
-
-  if (obs === 'card_info') {
-    // Fold by slot + board_id so same-card issues group together
-    const items = d.alerts || []
-    if (items.length > 0) {
-      const a = items[0]
-      return `${a.card || '?'}|${a.board_id || '?'}|${getCardInfoFieldIdentity(a)}`
-    }
-  }
-
-  if (obs === 'error_code') {
-    // Fold by port — same port's repeated errors group together
-    const ports = Object.keys(d.port_counters || {})
-    if (ports.length > 0) return ports[0]
-  }
-
-  if (obs === 'link_status') {
-    // Fold by port
-    const changes = d.changes || []
-    if (changes.length > 0) return changes[0].port || '?'
-  }
-
-  if (obs === 'port_speed') {
-    const changes = d.changes || []
-    if (changes.length > 0) return changes[0].port || '?'
-  }
-
-  if (obs === 'port_fec') {
-    const changes = d.changes || []
-    if (changes.length > 0) return changes[0].port || '?'
-  }
-
-  if (obs === 'controller_state') {
-    const changes = d.changes || []
-    if (changes.length > 0) return changes[0].id || '?'
-  }
-
-  if (obs === 'disk_state') {
-    const changes = d.changes || []
-    if (changes.length > 0) return changes[0].id || '?'
-  }
+import { computed, reactive, ref, getCurrentScope, onScopeDispose } from 'vue'
+import { foldAlerts } from '@/utils/alertFolding'
+import { getAnnotation, requestAnnotations, onAnnotated } from '@/utils/alertFoldingClient'
 
-  // Fallback: use message skeleton (strip numbers/timestamps)
-  return null
-}
-
-function getCardInfoFieldIdentity(item) {
-  const nestedFields = Array.isArray(item?.fields) ? item.fields : []
-  if (nestedFields.length > 0) {
-    return nestedFields
-      .map(field => `${field?.field || '?'}=${field?.expect || field?.value || ''}`)
-      .join('&')
-  }
+export { LEVEL_RANK } from '@/utils/alertFolding'
 
-  if (item?.field) {
-    return `${item.field}=${item.expect || item.value || ''}`
-  }
-
-  return '?'
-}
-
-/**
- * F207: Extract a short summary showing the changing numeric value across items.
- * E.g. "Rebuilding 12% complete" → "Rebuilding 58% complete" yields "12% → 58%"
- */
-function _extractProgressSummary(items) {
-  if (items.length < 2) return null
-  const first = items[items.length - 1]?.message || ''  // oldest (items are newest-first)
-  const last = items[0]?.message || ''                    // newest
-  const firstNums = first.match(/\d+\.?\d*/g) || []
-  const lastNums = last.match(/\d+\.?\d*/g) || []
-  // Find the first numeric position that differs
-  for (let i = 0; i < Math.min(firstNums.length, lastNums.length); i++) {
-    if (firstNums[i] !== lastNums[i]) {
-      // Check if there's a % or unit suffix near this number in the message
-      const numRegex = new RegExp(lastNums[i].replace('.', '\\.') + '\\s*(%|s|ms|MB|GB|KB)')
-      const unitMatch = last.match(numRegex)
-      const unit = unitMatch ? unitMatch[1] : ''
-      return `${firstNums[i]}${unit} → ${lastNums[i]}${unit}`
-    }
-  }
-  return `${items.length} 变化`
+function pendingAnnotation(alert, index) {
+  // Unique identity keeps not-yet-annotated alerts as singleton rows
+  return { identity: `#pending#${alert.id ?? index}`, summary: alert.message || '' }
 }
 
 /**
@@ -130,6 +31,11 @@ export function useAlertFolding(alerts) {
   // 2) State survives computed re-evaluations (e.g. after silent refresh)
   const expandedKeys = reactive(new Set())
 
+  // Bumped whenever the worker delivers annotations so foldedAlerts recomputes
+  const annotationVersion = ref(0)
+  const unsubscribe = onAnnotated(() => { annotationVersion.value++ })
+  if (getCurrentScope()) onScopeDispose(unsubscribe)
+
   function toggleExpand(key) {
     if (expandedKeys.has(key)) {
       expandedKeys.delete(key)
@@ -139,64 +45,15 @@ export function useAlertFolding(alerts) {
   }
 
   const foldedAlerts = computed(() => {
-    const groups = []
-    const map = new Map()
-
-    for (const alert of alerts.value) {
-      // Try observer-aware identity first; fall back to message skeleton
-      let identity = getAlertIdentity(alert)
-      if (!identity) {
-        identity = (alert.message || '')
-          .replace(/\d{4}-\d{2}-\d{2}[T ]\d{2}:\d{2}[:\d.]*/g, '#TIME#')
-          .replace(/\d+/g, '#N#')
-          .replace(/\s+/g, ' ')
-          .trim()
-          .substring(0, 80)
-      }
-
-      const key = `${alert.observer_name}|${alert.array_id}|${identity}`
-
-      if (map.has(key)) {
-        const g = map.get(key)
-        g.items.push(alert)
-        g.count++
-        // Track latest/earliest time and worst level
-        if (alert.timestamp > g.latestTime) g.latestTime = alert.timestamp
-        if (alert.timestamp < g.earliestTime) g.earliestTime = alert.timestamp
-        if ((LEVEL_RANK[alert.level] || 0) > (LEVEL_RANK[g.worstLevel] || 0)) g.worstLevel = alert.level
-      } else {
-        const group = {
-          key,
-          observer: alert.observer_name,
-          arrayId: alert.array_id,
-          arrayName: alert.array_name || alert.array_id,
-          summaryMsg: getTranslatedSummary(alert),
-          latestTime: alert.timestamp,
-          earliestTime: alert.timestamp,
-          worstLevel: alert.level,
-          count: 1,
-          items: [alert],
-        }
-        map.set(key, group)
-        groups.push(group)
-      }
-    }
-
-    // Attach reactive expanded flag + F207 progress detection
-    for (const g of groups) {
-      g.expanded = expandedKeys.has(g.key)
-      if (g.count > 1) {
-        const msgs = g.items.map(i => i.message || '')
-        g.isProgress = !msgs.every(m => m === msgs[0])
-        if (g.isProgress) {
-          g.progressSummary = _extractProgressSummary(g.items)
-        }
-      } else {
-        g.isProgress = false
-      }
-    }
-
-    return groups
+    annotationVersion.value  // dependency only
+    const list = alerts.value || []
+    // Idempotent: only unseen alerts are dispatched (or annotated inline without a worker)
+    requestAnnotations(list)
+    return foldAlerts(
+      list,
+      (alert, index) => getAnnotation(alert) || pendingAnnotation(alert, index),
+      expandedKeys,
+    )
   })
 
   return { foldedAlerts, toggleExpand }
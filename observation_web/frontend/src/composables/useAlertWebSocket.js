@@ -2,12 +2,47 @@
  * WebSocket lifecycle composable.
  * Handles connect / disconnect / reconnect with exponential backoff and heartbeat.
  *
+ * Server frames are either single messages or `batch` frames produced by
+ * MessageBatcher (backend/api/websocket.py); both are decoded here so callers
+ * only ever see individual alerts.
+ *
+ * When the browser supports Web Locks + BroadcastChannel, only one tab per
+ * origin (the lock holder) opens the socket.  It relays every decoded alert and
+ * its connection state to the other tabs over a BroadcastChannel; when that tab
+ * closes the lock is released and the next waiting tab takes over.  Without
+ * those APIs every tab falls back to its own socket.
+ *
  * @param {object} options
- * @param {function} options.onMessage  - called with parsed alert data when type === 'alert'
- * @param {function} [options.onConnect] - called each time the socket successfully opens
+ * @param {function} options.onMessage  - called with parsed alert data for every alert (single or batched)
+ * @param {function} [options.onConnect] - called each time the (possibly shared) socket successfully opens
  */
 import { ref, shallowRef } from 'vue'
 
+const LEADER_LOCK_NAME = 'observation-alert-ws'
+const CHANNEL_NAME = 'observation-alert-ws'
+
+/**
+ * Flatten a server frame into the alert payloads it carries.
+ * Non-alert frames (connected / heartbeat / pong) yield nothing.
+ */
+export function extractAlerts(frame) {
+  if (!frame) return []
+  if (frame.type === 'alert') return [frame.data]
+  if (frame.type === 'batch') {
+    return (frame.messages || [])
+      .filter(m => m && m.type === 'alert')
+      .map(m => m.data)
+  }
+  return []
+}
+
+function sharedSocketSupported() {
+  return typeof BroadcastChannel !== 'undefined'
+    && typeof navigator !== 'undefined'
+    && !!navigator.locks
+    && typeof navigator.locks.request === 'function'
+}
+
 export function useAlertWebSocket({ onMessage, onConnect } = {}) {
   const ws = shallowRef(null)
   const wsConnected = ref(false)
@@ -17,6 +52,12 @@ export function useAlertWebSocket({ onMessage, onConnect } = {}) {
   let reconnectAttempts = 0
   let intentionalDisconnect = false
 
+  // ── Cross-tab sharing state ──
+  let channel = null
+  let isLeader = false
+  let releaseLeadership = null  // resolves the held lock callback
+  let lockAbort = null          // cancels a pending (not yet granted) lock request
+
   const MAX_RECONNECT_DELAY = 60000  // cap at 60 s
   const BASE_RECONNECT_DELAY = 1000  // start at 1 s
 
@@ -30,13 +71,35 @@ export function useAlertWebSocket({ onMessage, onConnect } = {}) {
     const delay = Math.min(BASE_RECONNECT_DELAY * Math.pow(2, Math.min(reconnectAttempts, 6)), MAX_RECONNECT_DELAY)
     reconnectAttempts++
     console.log(`WebSocket reconnecting in ${delay}ms (attempt ${reconnectAttempts})`)
-    reconnectTimer = setTimeout(connect, delay)
+    reconnectTimer = setTimeout(openSocket, delay)
   }
 
-  function connect() {
+  function publish(msg) {
+    if (!channel || !isLeader) return
+    try {
+      channel.postMessage(msg)
+    } catch (e) {
+      console.error('Failed to relay alert WebSocket message:', e)
+    }
+  }
+
+  function setConnected(connected) {
+    const wasConnected = wsConnected.value
+    wsConnected.value = connected
+    publish({ kind: 'state', connected })
+    if (connected && !wasConnected && onConnect) onConnect()
+  }
+
+  function dispatchFrame(frame) {
+    for (const alert of extractAlerts(frame)) {
+      if (onMessage) onMessage(alert)
+      publish({ kind: 'alert', data: alert })
+    }
+  }
+
+  function openSocket() {
     if (ws.value) return
     cleanupTimers()
-    intentionalDisconnect = false
 
     const proto = window.location.protocol === 'https:' ? 'wss:' : 'ws:'
     const wsUrl = `${proto}//${window.location.host}/ws/alerts`
@@ -47,10 +110,9 @@ export function useAlertWebSocket({ onMessage, onConnect } = {}) {
 
       socket.onopen = () => {
         if (socket !== ws.value) return  // stale socket
-        wsConnected.value = true
         reconnectAttempts = 0
         console.log('Alert WebSocket connected')
-        if (onConnect) onConnect()
+        setConnected(true)
         heartbeatTimer = setInterval(() => {
           if (ws.value?.readyState === WebSocket.OPEN) {
             ws.value.send(JSON.stringify({ type: 'ping' }))
@@ -60,18 +122,20 @@ export function useAlertWebSocket({ onMessage, onConnect } = {}) {
 
       socket.onmessage = (event) => {
         if (socket !== ws.value) return  // stale socket
+        let frame
         try {
-          const data = JSON.parse(event.data)
-          if (data.type === 'alert' && onMessage) onMessage(data.data)
+          frame = JSON.parse(event.data)
         } catch (e) {
           console.error('Failed to parse WebSocket message:', e)
+          return
         }
+        dispatchFrame(frame)
       }
 
       socket.onclose = () => {
         if (socket !== ws.value) return  // stale socket — do NOT touch shared state
-        wsConnected.value = false
         ws.value = null
+        setConnected(false)
         cleanupTimers()
         scheduleReconnect()
       }
@@ -86,15 +150,89 @@ export function useAlertWebSocket({ onMessage, onConnect } = {}) {
     }
   }
 
-  function disconnect() {
+  function closeSocket() {
     cleanupTimers()
-    intentionalDisconnect = true
-    wsConnected.value = false
     if (ws.value) {
       ws.value.close()
       ws.value = null
     }
   }
 
+  // ── Follower side: mirror the leader tab ──
+  function handleChannelMessage(event) {
+    const msg = event.data || {}
+    if (isLeader) {
+      // A follower joined and wants the current state
+      if (msg.kind === 'hello') publish({ kind: 'state', connected: wsConnected.value })
+      return
+    }
+    if (msg.kind === 'alert') {
+      if (onMessage) onMessage(msg.data)
+    } else if (msg.kind === 'state') {
+      const wasConnected = wsConnected.value
+      wsConnected.value = !!msg.connected
+      if (msg.connected && !wasConnected && onConnect) onConnect()
+    }
+  }
+
+  function joinSharedSocket() {
+    channel = new BroadcastChannel(CHANNEL_NAME)
+    channel.onmessage = handleChannelMessage
+    channel.postMessage({ kind: 'hello' })
+
+    lockAbort = typeof AbortController !== 'undefined' ? new AbortController() : null
+    const lockOptions = lockAbort ? { signal: lockAbort.signal } : {}
+    navigator.locks.request(LEADER_LOCK_NAME, lockOptions, () => {
+      lockAbort = null
+      if (intentionalDisconnect) return undefined
+      isLeader = true
+      // Our mirrored state belonged to the previous leader; start clean.
+      wsConnected.value = false
+      publish({ kind: 'state', connected: false })
+      openSocket()
+      // Hold the lock until disconnect() or the tab goes away.
+      return new Promise(resolve => { releaseLeadership = resolve })
+    }).catch(e => {
+      if (e?.name !== 'AbortError') console.error('Alert WebSocket leader election failed:', e)
+    })
+  }
+
+  function leaveSharedSocket() {
+    if (lockAbort) { lockAbort.abort(); lockAbort = null }
+    if (isLeader) {
+      closeSocket()
+      publish({ kind: 'state', connected: false })
+      isLeader = false
+    }
+    if (releaseLeadership) { releaseLeadership(); releaseLeadership = null }
+    if (channel) {
+      channel.onmessage = null
+      channel.close()
+      channel = null
+    }
+  }
+
+  function connect() {
+    if (ws.value || channel) return
+    cleanupTimers()
+    intentionalDisconnect = false
+
+    if (sharedSocketSupported()) {
+      joinSharedSocket()
+    } else {
+      openSocket()
+    }
+  }
+
+  function disconnect() {
+    intentionalDisconnect = true
+    wsConnected.value = false
+    if (channel) {
+      leaveSharedSocket()
+    } else {
+      closeSocket()
+    }
+  }
+
   return { ws, wsConnected, connect, disconnect }
 }
@@ -0,0 +1,58 @@
+/**
+ * Live data stream composable.
+ * Subscribes to a server-pushed stream over the status WebSocket and falls
+ * back to interval polling only while that socket is down.
+ */
+import { watch, onScopeDispose } from 'vue'
+import { useArrayStore } from '../stores/arrays'
+
+/**
+ * @param {object} options
+ * @param {string} options.stream - 'metrics' | 'traffic' | 'log'
+ * @param {function(): object} options.params - evaluated on every start()
+ * @param {function(Array)} options.onData - receives new items only
+ * @param {function} options.fallback - polling callback used while disconnected
+ * @param {number} options.fallbackInterval - ms
+ */
+export function useLiveStream({ stream, params, onData, fallback, fallbackInterval }) {
+  const arrayStore = useArrayStore()
+  let unsubscribe = null
+  let fallbackTimer = null
+  let stopWatch = null
+
+  function _syncFallback(connected) {
+    if (connected) {
+      if (fallbackTimer) {
+        clearInterval(fallbackTimer)
+        fallbackTimer = null
+      }
+    } else if (!fallbackTimer) {
+      fallbackTimer = setInterval(fallback, fallbackInterval)
+    }
+  }
+
+  function start() {
+    stop()
+    unsubscribe = arrayStore.subscribeStream(stream, params(), onData)
+    stopWatch = watch(() => arrayStore.statusWsConnected, _syncFallback, { immediate: true })
+  }
+
+  function stop() {
+    if (unsubscribe) {
+      unsubscribe()
+      unsubscribe = null
+    }
+    if (stopWatch) {
+      stopWatch()
+      stopWatch = null
+    }
+    if (fallbackTimer) {
+      clearInterval(fallbackTimer)
+      fallbackTimer = null
+    }
+  }
+
+  onScopeDispose(stop)
+
+  return { start, stop }
+}
@@ -19,6 +19,11 @@ export const useArrayStore = defineStore('arrays', () => {
   const MAX_STATUS_RECONNECT_ATTEMPTS = 10
   const BASE_STATUS_RECONNECT_DELAY = 1000
 
+  // Live data stream subscriptions multiplexed over the status WebSocket
+  // (server side: backend/api/streams.py). Replayed on every reconnect.
+  const streamSubscriptions = new Map()  // sub_id -> { stream, params, onData }
+  let streamSeq = 0
+
   function beginLoading() {
     pendingRequests += 1
     loading.value = true
@@ -175,6 +180,44 @@ export const useArrayStore = defineStore('arrays', () => {
     }
   }
 
+  function _sendStatusMessage(msg) {
+    if (statusWs.value && statusWs.value.readyState === WebSocket.OPEN) {
+      statusWs.value.send(JSON.stringify(msg))
+    }
+  }
+
+  function _sendSubscribe(subId, sub) {
+    _sendStatusMessage({ type: 'subscribe', sub_id: subId, stream: sub.stream, params: sub.params })
+  }
+
+  function _handleStreamMessage(msg) {
+    const sub = streamSubscriptions.get(msg.sub_id)
+    if (!sub) return
+    if (msg.type === 'stream_data') {
+      sub.onData(msg.items || [])
+    } else if (msg.type === 'stream_error') {
+      console.warn(`Stream ${sub.stream} subscription rejected:`, msg.error)
+    }
+  }
+
+  /**
+   * Subscribe to a server-side live stream ('metrics' | 'traffic' | 'log').
+   * The subscription is sent now if the status socket is open, otherwise on
+   * the next (re)connect.
+   * @returns {function} unsubscribe
+   */
+  function subscribeStream(stream, params, onData) {
+    const subId = `s${++streamSeq}`
+    const sub = { stream, params, onData }
+    streamSubscriptions.set(subId, sub)
+    _sendSubscribe(subId, sub)
+    return () => {
+      if (streamSubscriptions.delete(subId)) {
+        _sendStatusMessage({ type: 'unsubscribe', sub_id: subId })
+      }
+    }
+  }
+
   function _cleanupStatusTimers() {
     if (statusHeartbeatTimer) {
       clearInterval(statusHeartbeatTimer)
@@ -209,6 +252,7 @@ export const useArrayStore = defineStore('arrays', () => {
         statusWsConnected.value = true
         statusReconnectAttempts = 0
         console.log('Status WebSocket connected')
+        for (const [subId, sub] of streamSubscriptions) _sendSubscribe(subId, sub)
         statusHeartbeatTimer = setInterval(() => {
           if (statusWs.value && statusWs.value.readyState === WebSocket.OPEN) {
             statusWs.value.send(JSON.stringify({ type: 'ping' }))
@@ -227,6 +271,8 @@ export const useArrayStore = defineStore('arrays', () => {
                 _applyStatusUpdate(m.data || m)
               }
             })
+          } else if (msg.type === 'stream_data' || msg.type === 'stream_error') {
+            _handleStreamMessage(msg)
           }
           // Ignore heartbeat/pong/connected messages
         } catch (e) {
@@ -281,6 +327,7 @@ export const useArrayStore = defineStore('arrays', () => {
     refreshArray,
     connectStatusWebSocket,
     disconnectStatusWebSocket,
+    subscribeStream,
     // Internal (exposed for testing)
     _applyStatusUpdate,
   }
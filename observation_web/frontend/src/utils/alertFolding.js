@@ -0,0 +1,239 @@
+/**
+ * Alert folding primitives shared by the UI thread and alertFolding.worker.js.
+ *
+ * Folding happens in two stages:
+ * 1. annotateAlert() — the expensive, per-alert part (translation + identity
+ *    extraction).  Its result only depends on alert *content*, so it is
+ *    memoized by alertContentKey() and may run inside a Web Worker.
+ * 2. foldAlerts() — a cheap linear pass that groups alerts by their
+ *    precomputed annotations.
+ *
+ * The folding key is observer-aware:
+ * - alarm_type: fold by objType + action (同类告警反复上报才折叠)
+ * - card_info: fold by slot + board_id (同一张卡反复上报才折叠)
+ * - error_code: fold by port (同端口误码才折叠)
+ * - link_status: fold by port (同端口链路变化才折叠)
+ * - Others: fold by message skeleton (通用兜底)
+ */
+import { translateAlert } from './alertTranslator'
+
+export const LEVEL_RANK = { critical: 4, error: 3, warning: 2, info: 1 }
+
+const DEFAULT_MEMO_SIZE = 5000
+
+/**
+ * Extract a semantic identity from alert details for smarter folding.
+ * Returns a string that distinguishes different "subjects" within the same observer.
+ * Alerts with the same identity represent the SAME recurring issue.
+ */
+export function getAlertIdentity(alert) {
+  const d = alert.details || {}
+  const obs = alert.observer_name
+
+  if (obs === 'alarm_type') {
+    // Fold by objType + action so same-type faults group together,
+    // but DiskEnclosure faults don't mix with FanModule faults
+    const first = (d.new_send_alarms || [])[0] || (d.new_resume_alarms || [])[0] || (d.new_events || [])[0]
+    if (first) {
+      return `${first.obj_type || first.alarm_name || '?'}|${first.action || (first.is_resume ? 'resume' : first.is_event ? 'event' : 'fault')}`
+    }
+  }
+
+  if (obs === 'card_info') {
+    // Fold by slot + board_id so same-card issues group together
+    const items = d.alerts || []
+    if (items.length > 0) {
+      const a = items[0]
+      return `${a.card || '?'}|${a.board_id || '?'}|${getCardInfoFieldIdentity(a)}`
+    }
+  }
+
+  if (obs === 'error_code') {
+    // Fold by port — same port's repeated errors group together
+    const ports = Object.keys(d.port_counters || {})
+    if (ports.length > 0) return ports[0]
+  }
+
+  if (obs === 'link_status') {
+    // Fold by port
+    const changes = d.changes || []
+    if (changes.length > 0) return changes[0].port || '?'
+  }
+
+  if (obs === 'port_speed') {
+    const changes = d.changes || []
+    if (changes.length > 0) return changes[0].port || '?'
+  }
+
+  if (obs === 'port_fec') {
+    const changes = d.changes || []
+    if (changes.length > 0) return changes[0].port || '?'
+  }
+
+  if (obs === 'controller_state') {
+    const changes = d.changes || []
+    if (changes.length > 0) return changes[0].id || '?'
+  }
+
+  if (obs === 'disk_state') {
+    const changes = d.changes || []
+    if (changes.length > 0) return changes[0].id || '?'
+  }
+
+  // Fallback: use message skeleton (strip numbers/timestamps)
+  return null
+}
+
+function getCardInfoFieldIdentity(item) {
+  const nestedFields = Array.isArray(item?.fields) ? item.fields : []
+  if (nestedFields.length > 0) {
+    return nestedFields
+      .map(field => `${field?.field || '?'}=${field?.expect || field?.value || ''}`)
+      .join('&')
+  }
+
+  if (item?.field) {
+    return `${item.field}=${item.expect || item.value || ''}`
+  }
+
+  return '?'
+}
+
+function getMessageSkeleton(message) {
+  return (message || '')
+    .replace(/\d{4}-\d{2}-\d{2}[T ]\d{2}:\d{2}[:\d.]*/g, '#TIME#')
+    .replace(/\d+/g, '#N#')
+    .replace(/\s+/g, ' ')
+    .trim()
+    .substring(0, 80)
+}
+
+/**
+ * Key covering every field that annotateAlert() reads.  Alerts from a storm
+ * that differ only in id / timestamp / array share the same key.
+ */
+export function alertContentKey(alert) {
+  return [
+    alert.observer_name || '',
+    alert.level || '',
+    alert.message || '',
+    JSON.stringify(alert.details ?? null),
+  ].join('\u0000')
+}
+
+/**
+ * Compute the folding identity and translated summary of one alert.
+ * @returns {{ identity: string, summary: string }}
+ */
+export function annotateAlert(alert) {
+  const identity = getAlertIdentity(alert) || getMessageSkeleton(alert.message)
+  const summary = translateAlert(alert).summary || alert.message
+  return { identity, summary }
+}
+
+/**
+ * Bounded LRU memo around annotateAlert(), keyed by alert content.
+ */
+export function createAnnotationMemo(maxEntries = DEFAULT_MEMO_SIZE) {
+  const cache = new Map()
+
+  function annotate(alert) {
+    const key = alertContentKey(alert)
+    const hit = cache.get(key)
+    if (hit) {
+      // Refresh recency (Map preserves insertion order)
+      cache.delete(key)
+      cache.set(key, hit)
+      return hit
+    }
+    const result = annotateAlert(alert)
+    cache.set(key, result)
+    if (cache.size > maxEntries) {
+      cache.delete(cache.keys().next().value)
+    }
+    return result
+  }
+
+  return { annotate, get size() { return cache.size } }
+}
+
+/**
+ * F207: Extract a short summary showing the changing numeric value across items.
+ * E.g. "Rebuilding 12% complete" → "Rebuilding 58% complete" yields "12% → 58%"
+ */
+export function extractProgressSummary(items) {
+  if (items.length < 2) return null
+  const first = items[items.length - 1]?.message || ''  // oldest (items are newest-first)
+  const last = items[0]?.message || ''                    // newest
+  const firstNums = first.match(/\d+\.?\d*/g) || []
+  const lastNums = last.match(/\d+\.?\d*/g) || []
+  // Find the first numeric position that differs
+  for (let i = 0; i < Math.min(firstNums.length, lastNums.length); i++) {
+    if (firstNums[i] !== lastNums[i]) {
+      // Check if there's a % or unit suffix near this number in the message
+      const numRegex = new RegExp(lastNums[i].replace('.', '\\.') + '\\s*(%|s|ms|MB|GB|KB)')
+      const unitMatch = last.match(numRegex)
+      const unit = unitMatch ? unitMatch[1] : ''
+      return `${firstNums[i]}${unit} → ${lastNums[i]}${unit}`
+    }
+  }
+  return `${items.length} 变化`
+}
+
+/**
+ * Group alerts by observer + array + identity.
+ *
+ * @param {Array} alerts
+ * @param {(alert: object, index: number) => {identity: string, summary: string}} getAnnotation
+ * @param {Set<string>} expandedKeys
+ */
+export function foldAlerts(alerts, getAnnotation, expandedKeys) {
+  const groups = []
+  const map = new Map()
+
+  alerts.forEach((alert, index) => {
+    const { identity, summary } = getAnnotation(alert, index)
+    const key = `${alert.observer_name}|${alert.array_id}|${identity}`
+
+    if (map.has(key)) {
+      const g = map.get(key)
+      g.items.push(alert)
+      g.count++
+      // Track latest/earliest time and worst level
+      if (alert.timestamp > g.latestTime) g.latestTime = alert.timestamp
+      if (alert.timestamp < g.earliestTime) g.earliestTime = alert.timestamp
+      if ((LEVEL_RANK[alert.level] || 0) > (LEVEL_RANK[g.worstLevel] || 0)) g.worstLevel = alert.level
+    } else {
+      const group = {
+        key,
+        observer: alert.observer_name,
+        arrayId: alert.array_id,
+        arrayName: alert.array_name || alert.array_id,
+        summaryMsg: summary,
+        latestTime: alert.timestamp,
+        earliestTime: alert.timestamp,
+        worstLevel: alert.level,
+        count: 1,
+        items: [alert],
+      }
+      map.set(key, group)
+      groups.push(group)
+    }
+  })
+
+  // Attach expanded flag + F207 progress detection
+  for (const g of groups) {
+    g.expanded = expandedKeys.has(g.key)
+    if (g.count > 1) {
+      const msgs = g.items.map(i => i.message || '')
+      g.isProgress = !msgs.every(m => m === msgs[0])
+      if (g.isProgress) {
+        g.progressSummary = extractProgressSummary(g.items)
+      }
+    } else {
+      g.isProgress = false
+    }
+  }
+
+  return groups
+}
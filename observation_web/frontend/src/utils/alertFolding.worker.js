@@ -0,0 +1,23 @@
+/**
+ * Web Worker: translate + fold-annotate alerts off the UI thread.
+ *
+ * Request:  { type: 'annotate', seq, alerts: [alert, ...] }
+ * Response: { type: 'annotated', seq, results: [{ identity, summary }, ...] }
+ *
+ * Results are positionally aligned with the request.  The memo lives for the
+ * lifetime of the worker, so repeated alerts from a storm are translated once.
+ */
+import { createAnnotationMemo } from './alertFolding'
+
+const memo = createAnnotationMemo()
+
+self.onmessage = (event) => {
+  const { type, seq, alerts } = event.data || {}
+  if (type !== 'annotate') return
+  try {
+    const results = (alerts || []).map(a => memo.annotate(a))
+    self.postMessage({ type: 'annotated', seq, results })
+  } catch (e) {
+    self.postMessage({ type: 'error', seq, message: String(e?.message || e) })
+  }
+}
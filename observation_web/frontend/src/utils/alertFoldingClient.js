@@ -0,0 +1,177 @@
+/**
+ * UI-thread side of the alert annotation pipeline.
+ *
+ * Keeps one annotation per alert object (WeakMap, so entries die with the
+ * alert) and ships only not-yet-annotated alerts to alertFolding.worker.js.
+ * Subscribers are notified when a worker response lands so folded views can
+ * recompute from the now-complete annotation cache.
+ *
+ * When Web Workers are unavailable (tests, very old browsers) or the worker
+ * errors out, annotations are computed synchronously with the same memo.
+ */
+import { toRaw } from 'vue'
+import { createAnnotationMemo } from './alertFolding'
+
+const WORKER_CHUNK_SIZE = 500
+
+let annotations = new WeakMap()  // raw alert -> { identity, summary }
+let pending = new WeakSet()      // raw alerts currently in flight
+let inflight = new Map()         // seq -> raw alerts of that request
+let listeners = new Set()
+let syncMemo = createAnnotationMemo()
+let worker = null
+let workerDisabled = false
+let seqCounter = 0
+
+function notify() {
+  for (const fn of listeners) {
+    try {
+      fn()
+    } catch (e) {
+      console.error('Alert annotation listener failed:', e)
+    }
+  }
+}
+
+function annotateSyncRaw(raw) {
+  let result = annotations.get(raw)
+  if (!result) {
+    result = syncMemo.annotate(raw)
+    annotations.set(raw, result)
+  }
+  return result
+}
+
+function disableWorker(reason) {
+  console.error('Alert folding worker unavailable, falling back to UI thread:', reason)
+  workerDisabled = true
+  if (worker) {
+    worker.terminate()
+    worker = null
+  }
+  // Finish whatever was in flight synchronously
+  for (const batch of inflight.values()) {
+    for (const raw of batch) {
+      pending.delete(raw)
+      annotateSyncRaw(raw)
+    }
+  }
+  inflight.clear()
+  notify()
+}
+
+function handleWorkerMessage(event) {
+  const { type, seq, results, message } = event.data || {}
+  const batch = inflight.get(seq)
+  if (!batch) return
+  inflight.delete(seq)
+
+  if (type === 'annotated') {
+    batch.forEach((raw, i) => {
+      pending.delete(raw)
+      if (results[i]) annotations.set(raw, results[i])
+    })
+  } else {
+    console.error('Alert folding worker error:', message)
+    for (const raw of batch) {
+      pending.delete(raw)
+      annotateSyncRaw(raw)
+    }
+  }
+  notify()
+}
+
+function getWorker() {
+  if (worker || workerDisabled) return worker
+  if (typeof Worker === 'undefined') {
+    workerDisabled = true
+    return null
+  }
+  try {
+    worker = new Worker(new URL('./alertFolding.worker.js', import.meta.url), { type: 'module' })
+    worker.onmessage = handleWorkerMessage
+    worker.onerror = (e) => disableWorker(e?.message || e)
+  } catch (e) {
+    workerDisabled = true
+    worker = null
+  }
+  return worker
+}
+
+/**
+ * Cached annotation for an alert, or undefined while it is still pending.
+ */
+export function getAnnotation(alert) {
+  return annotations.get(toRaw(alert))
+}
+
+/**
+ * Annotation for an alert, computed on the UI thread if not cached yet.
+ * Use for single-row lookups (drawers, table cells) where waiting is not useful.
+ */
+export function annotateSync(alert) {
+  return annotateSyncRaw(toRaw(alert))
+}
+
+/**
+ * Translated one-line summary of an alert (memoized).
+ */
+export function getAlertSummary(alert) {
+  return annotateSync(alert).summary
+}
+
+/**
+ * Make sure every alert in the list is (or will be) annotated.
+ * Only alerts not seen before are sent to the worker; without a worker
+ * they are annotated synchronously before this returns.
+ */
+export function requestAnnotations(alerts) {
+  const w = getWorker()
+  const missing = []
+  for (const alert of alerts) {
+    const raw = toRaw(alert)
+    if (annotations.has(raw)) continue
+    if (!w) {
+      annotateSyncRaw(raw)
+    } else if (!pending.has(raw)) {
+      missing.push(raw)
+    }
+  }
+  if (!w) return
+
+  for (let i = 0; i < missing.length; i += WORKER_CHUNK_SIZE) {
+    const batch = missing.slice(i, i + WORKER_CHUNK_SIZE)
+    const seq = ++seqCounter
+    try {
+      w.postMessage({ type: 'annotate', seq, alerts: batch })
+    } catch (e) {
+      // Uncloneable payload — annotate this batch here instead
+      for (const raw of batch) annotateSyncRaw(raw)
+      continue
+    }
+    for (const raw of batch) pending.add(raw)
+    inflight.set(seq, batch)
+  }
+}
+
+/**
+ * Subscribe to "new annotations available" notifications.
+ * @returns {function} unsubscribe
+ */
+export function onAnnotated(listener) {
+  listeners.add(listener)
+  return () => listeners.delete(listener)
+}
+
+/** Reset module state — for tests only. */
+export function _resetAlertFoldingClient() {
+  if (worker) worker.terminate()
+  worker = null
+  workerDisabled = false
+  annotations = new WeakMap()
+  pending = new WeakSet()
+  inflight = new Map()
+  listeners = new Set()
+  syncMemo = createAnnotationMemo()
+  seqCounter = 0
+}
@@ -0,0 +1,134 @@
+/**
+ * Shape-preserving decimation for ECharts time series.
+ *
+ * Mirrors backend/core/downsample.py so the same reduction can run on the
+ * server (?max_points= on chart endpoints) or here, sized to the chart's
+ * pixel width.  Points are [x, y] pairs sorted by x (x = epoch ms).
+ */
+
+/**
+ * Largest-Triangle-Three-Buckets: keep `threshold` points that best preserve
+ * the visual shape of the series.  First and last points are always kept.
+ */
+export function lttb(points, threshold) {
+  const n = points.length
+  if (threshold >= n || threshold < 3) return points.slice()
+
+  const sampled = [points[0]]
+  const bucketSize = (n - 2) / (threshold - 2)
+  let a = 0
+
+  for (let i = 0; i < threshold - 2; i++) {
+    // Average of the next bucket is the third triangle vertex
+    const nextStart = Math.floor((i + 1) * bucketSize) + 1
+    const nextEnd = Math.min(Math.floor((i + 2) * bucketSize) + 1, n)
+    let avgX = 0
+    let avgY = 0
+    const span = nextEnd - nextStart
+    if (span <= 0) {
+      [avgX, avgY] = points[n - 1]
+    } else {
+      for (let j = nextStart; j < nextEnd; j++) {
+        avgX += points[j][0]
+        avgY += points[j][1]
+      }
+      avgX /= span
+      avgY /= span
+    }
+
+    const start = Math.floor(i * bucketSize) + 1
+    const end = Math.floor((i + 1) * bucketSize) + 1
+    const [ax, ay] = points[a]
+    let bestArea = -1
+    let best = start
+    for (let j = start; j < end; j++) {
+      const [x, y] = points[j]
+      const area = Math.abs((ax - avgX) * (y - ay) - (ax - x) * (avgY - ay))
+      if (area > bestArea) {
+        bestArea = area
+        best = j
+      }
+    }
+    sampled.push(points[best])
+    a = best
+  }
+
+  sampled.push(points[n - 1])
+  return sampled
+}
+
+/**
+ * Min/max buckets: per bucket keep the lowest and highest point (in time
+ * order).  Cheaper than LTTB and guarantees every spike survives.
+ */
+export function minMaxBuckets(points, threshold) {
+  const n = points.length
+  if (threshold >= n || threshold < 4) return points.slice()
+
+  const bucketCount = Math.max(1, Math.floor((threshold - 2) / 2))
+  const bucketSize = (n - 2) / bucketCount
+  const sampled = [points[0]]
+
+  for (let b = 0; b < bucketCount; b++) {
+    const start = 1 + Math.floor(b * bucketSize)
+    const end = b === bucketCount - 1 ? n - 1 : 1 + Math.floor((b + 1) * bucketSize)
+    if (start >= end) continue
+    let lo = start
+    let hi = start
+    for (let j = start + 1; j < end; j++) {
+      if (points[j][1] < points[lo][1]) lo = j
+      if (points[j][1] > points[hi][1]) hi = j
+    }
+    if (lo === hi) {
+      sampled.push(points[lo])
+    } else {
+      sampled.push(points[Math.min(lo, hi)], points[Math.max(lo, hi)])
+    }
+  }
+
+  sampled.push(points[n - 1])
+  return sampled
+}
+
+const ALGORITHMS = { lttb, minmax: minMaxBuckets }
+
+/**
+ * Level-of-detail view of a series for a chart `width` pixels wide.
+ *
+ * The whole series is decimated to ~one point per pixel.  When `range`
+ * ([fromX, toX], e.g. the current dataZoom window) is given, points inside
+ * the window are decimated separately at the same budget, so zooming in
+ * reveals full detail while the axis extent stays unchanged.
+ *
+ * @param {Array<[number, number]>} points
+ * @param {{ width?: number, range?: [number, number] | null, algorithm?: 'lttb' | 'minmax' }} options
+ */
+export function lodSeries(points, { width = 800, range = null, algorithm = 'lttb' } = {}) {
+  const reduce = ALGORITHMS[algorithm] || lttb
+  const budget = Math.max(Math.round(width), 3)
+  const coarse = reduce(points, budget)
+  if (!range || points.length <= budget) return coarse
+
+  const [from, to] = range
+  const inside = points.filter(p => p[0] >= from && p[0] <= to)
+  return [
+    ...coarse.filter(p => p[0] < from),
+    ...reduce(inside, budget),
+    ...coarse.filter(p => p[0] > to),
+  ]
+}
+
+/**
+ * Translate an ECharts `datazoom` event (percent based) into an x range
+ * over `points`.  Returns null when the whole series is visible.
+ */
+export function zoomRangeFromEvent(event, points) {
+  if (!points.length) return null
+  const z = event?.batch?.[0] || event || {}
+  const start = z.start ?? 0
+  const end = z.end ?? 100
+  if (start <= 0 && end >= 100) return null
+  const x0 = points[0][0]
+  const span = points[points.length - 1][0] - x0
+  return [x0 + (span * start) / 100, x0 + (span * end) / 100]
+}
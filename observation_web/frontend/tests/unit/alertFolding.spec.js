@@ -0,0 +1,166 @@
+/**
+ * Tests for the off-main-thread alert folding pipeline.
+ *
+ * Covers:
+ * 1. Content-keyed annotation memo (storm duplicates translated once)
+ * 2. foldAlerts grouping from precomputed annotations
+ * 3. Worker client ships only unseen alerts and notifies on results
+ * 4. useAlertFolding shows pending alerts unfolded, then folds on worker reply
+ */
+
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest'
+import { ref, nextTick } from 'vue'
+import {
+  alertContentKey, annotateAlert, createAnnotationMemo, foldAlerts,
+} from '@/utils/alertFolding'
+import {
+  requestAnnotations, getAnnotation, onAnnotated, _resetAlertFoldingClient,
+} from '@/utils/alertFoldingClient'
+import { useAlertFolding } from '@/composables/useAlertFolding'
+
+function makeAlert(id, overrides = {}) {
+  return {
+    id,
+    observer_name: 'link_status',
+    array_id: 'arr-1',
+    level: 'warning',
+    message: 'eth0 link down',
+    timestamp: `2026-03-14T10:00:${String(id).padStart(2, '0')}`,
+    details: { changes: [{ port: 'eth0', old: 'up', new: 'down' }] },
+    ...overrides,
+  }
+}
+
+// ── Worker mock: records requests, replies on demand ─────────
+class MockWorker {
+  static instances = []
+
+  constructor(url, options) {
+    this.url = url
+    this.options = options
+    this.messages = []
+    this.onmessage = null
+    this.onerror = null
+    this.terminated = false
+    MockWorker.instances.push(this)
+  }
+
+  postMessage(data) {
+    this.messages.push(structuredClone(data))
+  }
+
+  terminate() {
+    this.terminated = true
+  }
+
+  // Test helper: answer every queued request like the real worker would
+  respondAll() {
+    const queued = this.messages.splice(0)
+    for (const msg of queued) {
+      this.onmessage({
+        data: { type: 'annotated', seq: msg.seq, results: msg.alerts.map(annotateAlert) },
+      })
+    }
+  }
+}
+
+describe('alertFolding primitives', () => {
+  it('content key ignores id, timestamp and array', () => {
+    const a = makeAlert(1)
+    const b = makeAlert(2, { array_id: 'arr-2' })
+    expect(alertContentKey(a)).toBe(alertContentKey(b))
+    expect(alertContentKey(a)).not.toBe(alertContentKey(makeAlert(3, { level: 'error' })))
+  })
+
+  it('memo returns cached annotation for identical content', () => {
+    const memo = createAnnotationMemo()
+    const first = memo.annotate(makeAlert(1))
+    const second = memo.annotate(makeAlert(2))
+    expect(second).toBe(first)
+    expect(memo.size).toBe(1)
+  })
+
+  it('memo evicts least recently used entries beyond its bound', () => {
+    const memo = createAnnotationMemo(2)
+    memo.annotate(makeAlert(1, { message: 'a' }))
+    memo.annotate(makeAlert(2, { message: 'b' }))
+    memo.annotate(makeAlert(3, { message: 'c' }))
+    expect(memo.size).toBe(2)
+  })
+
+  it('folds alerts sharing observer, array and identity', () => {
+    const alerts = [makeAlert(2), makeAlert(1), makeAlert(3, { array_id: 'arr-2' })]
+    const groups = foldAlerts(alerts, annotateAlert, new Set())
+    expect(groups).toHaveLength(2)
+    expect(groups[0].count).toBe(2)
+    expect(groups[0].latestTime).toBe('2026-03-14T10:00:02')
+    expect(groups[0].earliestTime).toBe('2026-03-14T10:00:01')
+  })
+})
+
+describe('alertFoldingClient with a worker', () => {
+  beforeEach(() => {
+    MockWorker.instances = []
+    globalThis.Worker = MockWorker
+    _resetAlertFoldingClient()
+  })
+
+  afterEach(() => {
+    _resetAlertFoldingClient()
+    delete globalThis.Worker
+  })
+
+  it('sends only alerts that are neither annotated nor in flight', () => {
+    const a1 = makeAlert(1)
+    const a2 = makeAlert(2)
+    requestAnnotations([a1])
+    requestAnnotations([a1, a2])
+
+    const worker = MockWorker.instances[0]
+    expect(worker.messages.map(m => m.alerts.map(a => a.id))).toEqual([[1], [2]])
+
+    worker.respondAll()
+    requestAnnotations([a1, a2])
+    expect(worker.messages).toHaveLength(0)
+    expect(getAnnotation(a1).identity).toBe('eth0')
+  })
+
+  it('notifies subscribers when results arrive', () => {
+    const listener = vi.fn()
+    onAnnotated(listener)
+    requestAnnotations([makeAlert(1)])
+    expect(listener).not.toHaveBeenCalled()
+
+    MockWorker.instances[0].respondAll()
+    expect(listener).toHaveBeenCalledTimes(1)
+  })
+
+  it('falls back to the UI thread when the worker errors', () => {
+    const alert = makeAlert(1)
+    requestAnnotations([alert])
+    const worker = MockWorker.instances[0]
+    worker.onerror({ message: 'boom' })
+
+    expect(worker.terminated).toBe(true)
+    expect(getAnnotation(alert).identity).toBe('eth0')
+  })
+
+  it('useAlertFolding folds once the worker replies', async () => {
+    const alerts = ref([makeAlert(2), makeAlert(1)])
+    const { foldedAlerts } = useAlertFolding(alerts)
+
+    // Pending: shown unfolded with the raw message
+    expect(foldedAlerts.value).toHaveLength(2)
+    expect(foldedAlerts.value[0].summaryMsg).toBe('eth0 link down')
+
+    MockWorker.instances[0].respondAll()
+    await nextTick()
+    expect(foldedAlerts.value).toHaveLength(1)
+    expect(foldedAlerts.value[0].count).toBe(2)
+
+    // A new alert only ships that alert to the worker
+    alerts.value = [makeAlert(3), ...alerts.value]
+    expect(foldedAlerts.value).toHaveLength(2)
+    expect(MockWorker.instances[0].messages.map(m => m.alerts.map(a => a.id))).toEqual([[3]])
+  })
+})
@@ -0,0 +1,235 @@
+/**
+ * Tests for the shared (one socket per browser) alert WebSocket.
+ *
+ * Covers:
+ * 1. Batch frames are flattened into individual alerts
+ * 2. Only the lock-holding tab opens a socket; others mirror it
+ * 3. Followers receive relayed alerts and connection state
+ * 4. Leadership passes to a waiting tab when the leader disconnects
+ */
+
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest'
+import { useAlertWebSocket, extractAlerts } from '@/composables/useAlertWebSocket'
+
+// ── WebSocket mock ───────────────────────────────────────────
+class MockWebSocket {
+  static OPEN = 1
+  static CLOSED = 3
+  static instances = []
+
+  constructor(url) {
+    this.url = url
+    this.readyState = 0
+    this.onopen = null
+    this.onclose = null
+    this.onmessage = null
+    this.onerror = null
+    MockWebSocket.instances.push(this)
+  }
+
+  send() {}
+
+  close() {
+    this.readyState = MockWebSocket.CLOSED
+    if (this.onclose) setTimeout(() => this.onclose(), 0)
+  }
+
+  simulateOpen() {
+    this.readyState = MockWebSocket.OPEN
+    if (this.onopen) this.onopen()
+  }
+
+  simulateMessage(data) {
+    if (this.onmessage) this.onmessage({ data: JSON.stringify(data) })
+  }
+}
+
+// ── BroadcastChannel mock: synchronous in-process bus ────────
+class MockBroadcastChannel {
+  static channels = []
+
+  constructor(name) {
+    this.name = name
+    this.onmessage = null
+    MockBroadcastChannel.channels.push(this)
+  }
+
+  postMessage(data) {
+    for (const other of MockBroadcastChannel.channels) {
+      if (other !== this && other.name === this.name && other.onmessage) {
+        other.onmessage({ data: structuredClone(data) })
+      }
+    }
+  }
+
+  close() {
+    MockBroadcastChannel.channels = MockBroadcastChannel.channels.filter(c => c !== this)
+  }
+}
+
+// ── Web Locks mock: exclusive FIFO lock per name ─────────────
+function createLockManager() {
+  const queues = new Map()
+
+  function grantNext(name) {
+    const queue = queues.get(name)
+    if (!queue || queue.held || queue.waiting.length === 0) return
+    const entry = queue.waiting.shift()
+    queue.held = true
+    Promise.resolve(entry.callback())
+      .then(entry.resolve, entry.reject)
+      .finally(() => {
+        queue.held = false
+        grantNext(name)
+      })
+  }
+
+  return {
+    request(name, options, callback) {
+      if (!queues.has(name)) queues.set(name, { held: false, waiting: [] })
+      const queue = queues.get(name)
+      return new Promise((resolve, reject) => {
+        const entry = { callback, resolve, reject }
+        queue.waiting.push(entry)
+        options?.signal?.addEventListener('abort', () => {
+          const idx = queue.waiting.indexOf(entry)
+          if (idx >= 0) {
+            queue.waiting.splice(idx, 1)
+            reject(new DOMException('Aborted', 'AbortError'))
+          }
+        })
+        grantNext(name)
+      })
+    },
+  }
+}
+
+const flush = () => new Promise(resolve => setTimeout(resolve, 0))
+
+describe('extractAlerts', () => {
+  it('returns the payload of a single alert frame', () => {
+    expect(extractAlerts({ type: 'alert', data: { id: 1 } })).toEqual([{ id: 1 }])
+  })
+
+  it('flattens batch frames and skips non-alert entries', () => {
+    const frame = {
+      type: 'batch',
+      messages: [
+        { type: 'alert', data: { id: 1 } },
+        { type: 'pong' },
+        { type: 'alert', data: { id: 2 } },
+      ],
+    }
+    expect(extractAlerts(frame)).toEqual([{ id: 1 }, { id: 2 }])
+  })
+
+  it('ignores control frames', () => {
+    expect(extractAlerts({ type: 'heartbeat' })).toEqual([])
+    expect(extractAlerts(null)).toEqual([])
+  })
+})
+
+describe('useAlertWebSocket (shared across tabs)', () => {
+  let originalLocks
+
+  beforeEach(() => {
+    MockWebSocket.instances = []
+    MockBroadcastChannel.channels = []
+    globalThis.WebSocket = MockWebSocket
+    globalThis.BroadcastChannel = MockBroadcastChannel
+    originalLocks = Object.getOwnPropertyDescriptor(globalThis.navigator, 'locks')
+    Object.defineProperty(globalThis.navigator, 'locks', {
+      value: createLockManager(),
+      configurable: true,
+    })
+  })
+
+  afterEach(() => {
+    delete globalThis.WebSocket
+    delete globalThis.BroadcastChannel
+    if (originalLocks) {
+      Object.defineProperty(globalThis.navigator, 'locks', originalLocks)
+    } else {
+      delete globalThis.navigator.locks
+    }
+  })
+
+  function openTab() {
+    const received = []
+    const onConnect = vi.fn()
+    const tab = useAlertWebSocket({ onMessage: a => received.push(a), onConnect })
+    return { ...tab, received, onConnect }
+  }
+
+  it('opens a single socket for several tabs and relays alerts', async () => {
+    const leader = openTab()
+    const follower = openTab()
+    leader.connect()
+    await flush()
+    follower.connect()
+    await flush()
+
+    expect(MockWebSocket.instances.length).toBe(1)
+
+    MockWebSocket.instances[0].simulateOpen()
+    expect(leader.wsConnected.value).toBe(true)
+    expect(follower.wsConnected.value).toBe(true)
+    expect(leader.onConnect).toHaveBeenCalledTimes(1)
+    expect(follower.onConnect).toHaveBeenCalledTimes(1)
+
+    MockWebSocket.instances[0].simulateMessage({
+      type: 'batch',
+      messages: [
+        { type: 'alert', data: { id: 1 } },
+        { type: 'alert', data: { id: 2 } },
+      ],
+    })
+
+    expect(leader.received.map(a => a.id)).toEqual([1, 2])
+    expect(follower.received.map(a => a.id)).toEqual([1, 2])
+
+    leader.disconnect()
+    follower.disconnect()
+  })
+
+  it('hands the socket to a waiting tab when the leader leaves', async () => {
+    const leader = openTab()
+    const follower = openTab()
+    leader.connect()
+    await flush()
+    follower.connect()
+    await flush()
+    MockWebSocket.instances[0].simulateOpen()
+
+    leader.disconnect()
+    expect(follower.wsConnected.value).toBe(false)
+    await flush()
+
+    // Follower won the lock and opened its own socket
+    expect(MockWebSocket.instances.length).toBe(2)
+    MockWebSocket.instances[1].simulateOpen()
+    expect(follower.wsConnected.value).toBe(true)
+    expect(follower.onConnect).toHaveBeenCalledTimes(2)
+
+    MockWebSocket.instances[1].simulateMessage({ type: 'alert', data: { id: 7 } })
+    expect(follower.received.map(a => a.id)).toEqual([7])
+    // The departed leader no longer receives anything
+    expect(leader.received).toEqual([])
+
+    follower.disconnect()
+  })
+
+  it('a tab that disconnects before winning the lock never opens a socket', async () => {
+    const leader = openTab()
+    const follower = openTab()
+    leader.connect()
+    await flush()
+    follower.connect()
+    follower.disconnect()
+
+    leader.disconnect()
+    await flush()
+
+    expect(MockWebSocket.instances.length).toBe(1)
+  })
+})
@@ -223,6 +223,42 @@ describe('alertsStore (real store)', () => {
     })
   })
 
+  describe('WebSocket message decoding', () => {
+    it('handles single alert frames', () => {
+      store.connectWebSocket()
+      const socket = MockWebSocket.instances[0]
+      socket.simulateOpen()
+
+      socket.simulateMessage({
+        type: 'alert',
+        data: { id: 1, level: 'error', timestamp: new Date().toISOString() },
+      })
+
+      expect(store.recentAlerts.map(a => a.id)).toEqual([1])
+    })
+
+    it('unpacks batch frames emitted by the server-side batcher', () => {
+      store.connectWebSocket()
+      const socket = MockWebSocket.instances[0]
+      socket.simulateOpen()
+
+      const ts = new Date().toISOString()
+      socket.simulateMessage({
+        type: 'batch',
+        count: 3,
+        messages: [
+          { type: 'alert', data: { id: 1, level: 'error', timestamp: ts } },
+          { type: 'heartbeat' },
+          { type: 'alert', data: { id: 2, level: 'critical', timestamp: ts } },
+        ],
+      })
+
+      // Newest first, non-alert entries skipped
+      expect(store.recentAlerts.map(a => a.id)).toEqual([2, 1])
+      expect(store.recentCount).toBe(2)
+    })
+  })
+
   describe('recentCount computed', () => {
     it('should count only error and critical alerts', () => {
       store.recentAlerts = [
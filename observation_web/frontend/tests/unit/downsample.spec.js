@@ -0,0 +1,79 @@
+/**
+ * Tests for client-side chart decimation (utils/downsample.js).
+ *
+ * Covers:
+ * 1. LTTB / min-max point budgets and endpoint preservation
+ * 2. Spikes survive decimation
+ * 3. lodSeries refines the zoom window while keeping the full extent
+ * 4. datazoom percent → x-range translation
+ */
+
+import { describe, it, expect } from 'vitest'
+import { lttb, minMaxBuckets, lodSeries, zoomRangeFromEvent } from '@/utils/downsample'
+
+function series(n, fn = i => i % 13) {
+  return Array.from({ length: n }, (_, i) => [i * 1000, fn(i)])
+}
+
+describe('lttb', () => {
+  it('returns short series unchanged', () => {
+    const pts = series(10)
+    expect(lttb(pts, 100)).toEqual(pts)
+  })
+
+  it('honours the threshold and keeps endpoints', () => {
+    const pts = series(5000)
+    const out = lttb(pts, 400)
+    expect(out).toHaveLength(400)
+    expect(out[0]).toBe(pts[0])
+    expect(out[out.length - 1]).toBe(pts[pts.length - 1])
+  })
+
+  it('keeps an isolated peak', () => {
+    const pts = series(5000, i => (i === 2500 ? 100 : 1))
+    expect(lttb(pts, 100)).toContain(pts[2500])
+  })
+})
+
+describe('minMaxBuckets', () => {
+  it('stays within budget and preserves min and max', () => {
+    const pts = series(10000, i => (i === 1234 ? 1e9 : i === 4321 ? -5 : 10))
+    const out = minMaxBuckets(pts, 300)
+    expect(out.length).toBeLessThanOrEqual(300)
+    expect(out).toContain(pts[1234])
+    expect(out).toContain(pts[4321])
+    const xs = out.map(p => p[0])
+    expect(xs).toEqual([...xs].sort((a, b) => a - b))
+  })
+})
+
+describe('lodSeries', () => {
+  it('decimates to roughly one point per pixel', () => {
+    const out = lodSeries(series(20000), { width: 500 })
+    expect(out).toHaveLength(500)
+  })
+
+  it('adds full detail inside the zoom window without moving the extent', () => {
+    const pts = series(20000)
+    const range = [5000 * 1000, 5200 * 1000]  // 201 raw points
+    const out = lodSeries(pts, { width: 500, range })
+
+    const inside = out.filter(p => p[0] >= range[0] && p[0] <= range[1])
+    expect(inside).toHaveLength(201)
+    expect(out[0]).toBe(pts[0])
+    expect(out[out.length - 1]).toBe(pts[pts.length - 1])
+  })
+})
+
+describe('zoomRangeFromEvent', () => {
+  const pts = series(101)  // x from 0 to 100 000
+
+  it('returns null when fully zoomed out', () => {
+    expect(zoomRangeFromEvent({ batch: [{ start: 0, end: 100 }] }, pts)).toBeNull()
+  })
+
+  it('maps percent window onto the x extent', () => {
+    expect(zoomRangeFromEvent({ batch: [{ start: 25, end: 50 }] }, pts)).toEqual([25000, 50000])
+    expect(zoomRangeFromEvent({ start: 10, end: 20 }, pts)).toEqual([10000, 20000])
+  })
+})
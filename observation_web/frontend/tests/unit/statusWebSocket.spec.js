@@ -8,7 +8,7 @@
  * 11. Dashboard stats use agent_healthy, not loose agent_running
  */
 
-import { describe, it, expect, vi, beforeEach } from 'vitest'
+import { describe, it, expect, vi, beforeEach, afterEach } from 'vitest'
 import { setActivePinia, createPinia } from 'pinia'
 import { useArrayStore } from '../../src/stores/arrays'
 
@@ -131,3 +131,95 @@ describe('Arrays Store - Status WebSocket', () => {
     expect(store.connectedCount).toBe(2)
   })
 })
+
+describe('Arrays Store - live stream subscriptions', () => {
+  class MockWebSocket {
+    static OPEN = 1
+    static instances = []
+
+    constructor(url) {
+      this.url = url
+      this.readyState = 0
+      this.sent = []
+      MockWebSocket.instances.push(this)
+    }
+
+    send(data) {
+      this.sent.push(JSON.parse(data))
+    }
+
+    close() {}
+
+    open() {
+      this.readyState = MockWebSocket.OPEN
+      this.onopen()
+    }
+
+    receive(msg) {
+      this.onmessage({ data: JSON.stringify(msg) })
+    }
+  }
+
+  let store
+
+  beforeEach(() => {
+    MockWebSocket.instances = []
+    vi.stubGlobal('WebSocket', MockWebSocket)
+    setActivePinia(createPinia())
+    store = useArrayStore()
+  })
+
+  afterEach(() => {
+    store.disconnectStatusWebSocket()
+    vi.unstubAllGlobals()
+  })
+
+  it('subscribes on connect and routes stream_data to the callback', () => {
+    const onData = vi.fn()
+    store.subscribeStream('metrics', { array_id: 'arr1' }, onData)
+    store.connectStatusWebSocket()
+    const ws = MockWebSocket.instances[0]
+    expect(ws.sent).toHaveLength(0)
+
+    ws.open()
+    const sub = ws.sent.find(m => m.type === 'subscribe')
+    expect(sub).toMatchObject({ stream: 'metrics', params: { array_id: 'arr1' } })
+
+    ws.receive({ type: 'stream_data', sub_id: sub.sub_id, stream: 'metrics', items: [{ ts: 't1' }] })
+    ws.receive({ type: 'stream_data', sub_id: 'other', stream: 'metrics', items: [{ ts: 't2' }] })
+    expect(onData).toHaveBeenCalledTimes(1)
+    expect(onData).toHaveBeenCalledWith([{ ts: 't1' }])
+  })
+
+  it('sends unsubscribe and stops delivering after unsubscribe', () => {
+    store.connectStatusWebSocket()
+    const ws = MockWebSocket.instances[0]
+    ws.open()
+
+    const onData = vi.fn()
+    const unsubscribe = store.subscribeStream('log', { array_id: 'arr1', file_path: '/var/log/messages' }, onData)
+    const subId = ws.sent.find(m => m.type === 'subscribe').sub_id
+
+    unsubscribe()
+    expect(ws.sent[ws.sent.length - 1]).toEqual({ type: 'unsubscribe', sub_id: subId })
+    ws.receive({ type: 'stream_data', sub_id: subId, stream: 'log', items: ['line'] })
+    expect(onData).not.toHaveBeenCalled()
+  })
+
+  it('replays active subscriptions after a reconnect', () => {
+    vi.useFakeTimers()
+    try {
+      store.connectStatusWebSocket()
+      MockWebSocket.instances[0].open()
+      store.subscribeStream('traffic', { array_id: 'arr1', port: 'eth0' }, vi.fn())
+
+      MockWebSocket.instances[0].onclose()
+      vi.advanceTimersByTime(1000)
+      const ws2 = MockWebSocket.instances[1]
+      ws2.open()
+      expect(ws2.sent.filter(m => m.type === 'subscribe')).toHaveLength(1)
+    } finally {
+      vi.useRealTimers()
+    }
+  })
+})
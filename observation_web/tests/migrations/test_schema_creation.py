@@ -54,7 +54,8 @@ ALL_EXPECTED_TABLES = sorted([
     "alerts_archive", "alerts_v2", "archive_config",
     "array_enrollment_jobs", "array_import_jobs", "array_locks",
     "array_tags", "arrays", "audit_logs", "card_inventory",
-    "card_presence_current", "card_presence_history", "expected_windows",
+    "card_inventory_journal", "card_presence_current",
+    "card_presence_history", "card_search_tokens", "expected_windows",
     "issues", "monitor_templates", "observer_configs", "observer_snapshots",
     "port_traffic", "query_templates", "scheduled_tasks", "schema_version",
     "snapshots", "sync_state", "system_config", "tags", "task_results",
@@ -458,7 +458,8 @@ class TestLinkStatusObserver:
 
     @staticmethod
     def _obs(**kw):
-        cfg = {"ports": ["eth0"]}
+        # Polling path: the netlink path reads LinkMonitor, not _get_port_state
+        cfg = {"ports": ["eth0"], "use_netlink": False}
         cfg.update(kw)
         return LinkStatusObserver("ls_test", cfg)
 
@@ -0,0 +1,100 @@
+"""
+Local OpenAI-compatible stub model server for AI service tests.
+
+Serves POST /v1/chat/completions and GET /v1/models from a background
+thread, counts requests and can delay replies to widen race windows.
+
+    with StubLLMServer(delay=0.2) as server:
+        config.ai.api_url = server.chat_url
+        ...
+        assert server.chat_requests == 1
+"""
+
+import json
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+class StubLLMServer:
+    def __init__(self, reply: str = "stub interpretation", delay: float = 0.0, status: int = 200):
+        self.reply = reply
+        self.delay = delay
+        self.status = status
+        self.chat_requests = 0
+        self.prompts = []
+        self._lock = threading.Lock()
+        self._httpd = None
+        self._thread = None
+
+    @property
+    def base_url(self) -> str:
+        host, port = self._httpd.server_address[:2]
+        return f"http://{host}:{port}"
+
+    @property
+    def chat_url(self) -> str:
+        return f"{self.base_url}/v1/chat/completions"
+
+    def _make_handler(self):
+        server = self
+
+        class Handler(BaseHTTPRequestHandler):
+            protocol_version = "HTTP/1.1"  # keep-alive, so pooled clients reuse connections
+
+            def log_message(self, *args):
+                pass
+
+            def _send(self, status, payload):
+                body = json.dumps(payload, ensure_ascii=False).encode("utf-8")
+                self.send_response(status)
+                self.send_header("Content-Type", "application/json")
+                self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                self.wfile.write(body)
+
+            def do_GET(self):
+                if self.path == "/v1/models":
+                    self._send(200, {"data": [{"id": "stub-model"}]})
+                else:
+                    self._send(404, {"error": "not found"})
+
+            def do_POST(self):
+                length = int(self.headers.get("Content-Length") or 0)
+                request = json.loads(self.rfile.read(length) or b"{}")
+                if self.path != "/v1/chat/completions":
+                    self._send(404, {"error": "not found"})
+                    return
+                with server._lock:
+                    server.chat_requests += 1
+                    server.prompts.append(request.get("messages", [{}])[-1].get("content", ""))
+                if server.delay:
+                    time.sleep(server.delay)
+                if server.status != 200:
+                    self._send(server.status, {"error": "stub failure"})
+                    return
+                self._send(200, {
+                    "model": request.get("model", "stub-model"),
+                    "choices": [{"message": {"role": "assistant", "content": server.reply}}],
+                })
+
+        return Handler
+
+    def start(self):
+        self._httpd = ThreadingHTTPServer(("127.0.0.1", 0), self._make_handler())
+        self._httpd.daemon_threads = True
+        self._thread = threading.Thread(target=self._httpd.serve_forever, daemon=True)
+        self._thread.start()
+        return self
+
+    def stop(self):
+        if self._httpd:
+            self._httpd.shutdown()
+            self._httpd.server_close()
+            self._httpd = None
+
+    def __enter__(self):
+        return self.start()
+
+    def __exit__(self, *exc):
+        self.stop()
@@ -0,0 +1,64 @@
+"""Tests for backend/core/ack_expiry.py — AckExpiryScheduler."""
+from datetime import datetime, timedelta
+
+import pytest
+from sqlalchemy import select
+
+from backend.core.ack_expiry import AckExpiryScheduler
+from backend.models.alert import AlertAckModel, AlertModel
+
+
+async def _alert_with_ack(db, expires_at, ack_type="dismiss"):
+    alert = AlertModel(array_id="arr-exp", observer_name="cpu_usage", level="warning",
+                       message="cpu high", details="{}", timestamp=datetime.now())
+    db.add(alert)
+    await db.flush()
+    db.add(AlertAckModel(alert_id=alert.id, acked_by_ip="127.0.0.1",
+                         ack_type=ack_type, ack_expires_at=expires_at))
+    await db.commit()
+    return alert.id
+
+
+class TestScheduling:
+    def test_schedule_keeps_earliest(self):
+        s = AckExpiryScheduler(max_sleep=60)
+        later = datetime.now() + timedelta(hours=2)
+        sooner = datetime.now() + timedelta(seconds=10)
+        s.schedule(later)
+        s.schedule(sooner)
+        s.schedule(later)
+        s.schedule(None)
+        assert s.next_due == sooner
+        assert 9 <= s._sleep_seconds() <= 11
+
+    def test_sleep_capped(self):
+        s = AckExpiryScheduler(max_sleep=30)
+        assert s._sleep_seconds() == 30
+        s.schedule(datetime.now() + timedelta(days=1))
+        assert s._sleep_seconds() == 30
+        s._next_due = datetime.now() - timedelta(seconds=5)
+        assert s._sleep_seconds() == 0
+
+
+@pytest.mark.asyncio
+class TestExpire:
+    async def test_only_lapsed_acks_are_removed(self, db_session):
+        now = datetime.now()
+        lapsed = await _alert_with_ack(db_session, now - timedelta(seconds=1))
+        pending = await _alert_with_ack(db_session, now + timedelta(hours=1))
+        permanent = await _alert_with_ack(db_session, None, ack_type="confirmed_ok")
+
+        s = AckExpiryScheduler()
+        expired = await s._expire(db_session, now)
+        assert expired == {"arr-exp": [lapsed]}
+        assert s.expired_total == 1
+
+        result = await db_session.execute(select(AlertAckModel.alert_id))
+        assert sorted(r[0] for r in result.all()) == sorted([pending, permanent])
+        # Timer now points at the next pending expiry
+        assert s.next_due == now + timedelta(hours=1)
+
+    async def test_nothing_due(self, db_session):
+        s = AckExpiryScheduler()
+        assert await s._expire(db_session, datetime.now()) == {}
+        assert s.next_due is None
@@ -0,0 +1,167 @@
+"""
+AI interpretation cache tests (backend/core/ai_cache.py, ai_service.interpret_alert).
+
+Covers content-key normalization, TTL / LRU bounds, in-flight coalescing,
+and storm behaviour against the local stub model server.
+"""
+
+import asyncio
+
+import pytest
+
+from backend import config as config_mod
+from backend.config import AppConfig
+from backend.core import ai_cache, ai_service
+from backend.core.ai_cache import InterpretationCache, interpretation_key
+
+from stub_llm_server import StubLLMServer
+
+
+# ── Content key ──────────────────────────────────────────────
+
+def test_key_ignores_timestamps_and_whitespace():
+    a = interpretation_key("m", "link_status", "warning",
+                           "2026-03-14 10:00:01 eth0  link down", {"port": "eth0", "ts": "10:00:01"})
+    b = interpretation_key("m", "link_status", "warning",
+                           "2026-03-14T11:22:33.5 eth0 link down", {"ts": "11:22:33", "port": "eth0"})
+    assert a == b
+
+
+def test_key_distinguishes_content_and_model():
+    base = interpretation_key("m", "link_status", "warning", "eth0 link down", {})
+    assert base != interpretation_key("m", "link_status", "warning", "eth1 link down", {})
+    assert base != interpretation_key("m", "link_status", "error", "eth0 link down", {})
+    assert base != interpretation_key("other", "link_status", "warning", "eth0 link down", {})
+
+
+# ── TTL / LRU ────────────────────────────────────────────────
+
+def test_entries_expire_after_ttl():
+    now = [0.0]
+    cache = InterpretationCache(ttl=10, clock=lambda: now[0])
+    cache.put("k", "v")
+    now[0] = 9
+    assert cache.get("k") == "v"
+    now[0] = 10
+    assert cache.get("k") is None
+
+
+def test_lru_bound_evicts_least_recently_used():
+    cache = InterpretationCache(max_entries=2)
+    cache.put("a", "1")
+    cache.put("b", "2")
+    cache.get("a")
+    cache.put("c", "3")
+    assert cache.get("a") == "1"
+    assert cache.get("b") is None
+    assert cache.get("c") == "3"
+
+
+# ── Coalescing ───────────────────────────────────────────────
+
+async def test_concurrent_identical_requests_share_one_call():
+    cache = InterpretationCache()
+    calls = 0
+
+    async def compute():
+        nonlocal calls
+        calls += 1
+        await asyncio.sleep(0.05)
+        return "answer"
+
+    results = await asyncio.gather(*(cache.get_or_compute("k", compute) for _ in range(50)))
+    assert results == ["answer"] * 50
+    assert calls == 1
+    assert cache.stats()["coalesced"] == 49
+    assert await cache.get_or_compute("k", compute) == "answer"
+    assert calls == 1
+
+
+async def test_failures_are_not_cached():
+    cache = InterpretationCache()
+    replies = [None, "ok"]
+
+    async def compute():
+        return replies.pop(0)
+
+    assert await cache.get_or_compute("k", compute) is None
+    assert await cache.get_or_compute("k", compute) == "ok"
+
+
+async def test_cancelled_caller_does_not_abort_shared_call():
+    cache = InterpretationCache()
+
+    async def compute():
+        await asyncio.sleep(0.05)
+        return "answer"
+
+    first = asyncio.ensure_future(cache.get_or_compute("k", compute))
+    second = asyncio.ensure_future(cache.get_or_compute("k", compute))
+    await asyncio.sleep(0)
+    first.cancel()
+    assert await second == "answer"
+
+
+# ── Against the stub model server ────────────────────────────
+
+@pytest.fixture
+def ai_config(monkeypatch):
+    cfg = AppConfig()
+    cfg.ai.enabled = True
+    cfg.ai.model = "stub-model"
+    cfg.ai.proxy_mode = "none"
+    monkeypatch.setattr(config_mod, "_config", cfg)
+    monkeypatch.setattr(ai_cache, "_cache", None)
+    return cfg
+
+
+async def test_alert_storm_makes_one_model_call(ai_config):
+    with StubLLMServer(reply="链路中断", delay=0.2) as server:
+        ai_config.ai.api_url = server.chat_url
+        try:
+            storm = [
+                ai_service.interpret_alert(
+                    "link_status", "warning",
+                    f"2026-03-14 10:00:{i % 60:02d} eth0 link down",
+                    {"port": "eth0", "timestamp": i},
+                )
+                for i in range(200)
+            ]
+            results = await asyncio.gather(*storm)
+            assert results == ["链路中断"] * 200
+            assert server.chat_requests == 1
+
+            # Later alerts that differ only in timestamps are served from the cache
+            again = await ai_service.interpret_alert(
+                "link_status", "warning", "2026-03-14 11:30:00 eth0 link down", {"port": "eth0", "timestamp": 999},
+            )
+            assert again == "链路中断"
+            assert server.chat_requests == 1
+        finally:
+            await ai_service.reset_http_client()
+
+
+async def test_pooled_client_is_reused(ai_config):
+    with StubLLMServer() as server:
+        ai_config.ai.api_url = server.chat_url
+        try:
+            client = ai_service.get_http_client()
+            await ai_service.interpret_alert("cpu_usage", "warning", "cpu 95%", {})
+            await ai_service.interpret_alert("cpu_usage", "warning", "cpu 99%", {})
+            assert ai_service.get_http_client() is client
+            assert server.chat_requests == 2
+        finally:
+            await ai_service.reset_http_client()
+        assert ai_service.get_http_client() is not client
+        await ai_service.reset_http_client()
+
+
+async def test_model_error_degrades_to_none_and_retries(ai_config):
+    with StubLLMServer(status=500) as server:
+        ai_config.ai.api_url = server.chat_url
+        try:
+            assert await ai_service.interpret_alert("cpu_usage", "warning", "cpu 95%", {}) is None
+            assert await ai_service.interpret_alert("cpu_usage", "warning", "cpu 95%", {}) is None
+            assert server.chat_requests == 2
+        finally:
+            await ai_service.reset_http_client()
@@ -0,0 +1,98 @@
+"""
+Compiled expectation matcher tests (backend/core/alert_expectation.py).
+
+Covers: compiled rule set agrees with the straightforward per-rule check,
+priority order, invalid patterns and backreferences.
+"""
+
+import random
+import re
+
+from backend.core.alert_expectation import CompiledRuleSet, _compile_any
+from backend.models.alert_rule import BUILTIN_RULES
+
+
+def _rules_from_builtin():
+    return [
+        dict(r, id=i + 1, priority=50, task_types=r["task_types"])
+        for i, r in enumerate(BUILTIN_RULES)
+    ]
+
+
+def _linear_match(rules, task_type, observer, level, message):
+    """Reference: the original rule-by-rule evaluation."""
+    for rule in rules:
+        if rule["task_types"] and task_type not in rule["task_types"]:
+            continue
+        if rule["observer_patterns"] and not any(
+            p == observer or re.search(p, observer, re.IGNORECASE) for p in rule["observer_patterns"]
+        ):
+            continue
+        if rule["level_patterns"] and level not in rule["level_patterns"]:
+            continue
+        if rule["message_patterns"]:
+            ok = False
+            for p in rule["message_patterns"]:
+                try:
+                    if re.search(p, message, re.IGNORECASE):
+                        ok = True
+                        break
+                except re.error:
+                    continue
+            if not ok:
+                continue
+        return rule["id"]
+    return None
+
+
+def test_matches_linear_evaluation():
+    rules = _rules_from_builtin()
+    rules.append({"id": 100, "task_types": [], "observer_patterns": ["^port"],
+                  "level_patterns": [], "message_patterns": ["crc"]})
+    compiled = CompiledRuleSet(rules)
+
+    rng = random.Random(7)
+    task_types = ["port_toggle", "cable_pull", "controller_poweroff", "card_poweroff",
+                  "fault_injection", "controller_upgrade", "normal_business"]
+    observers = ["link_status", "port_speed", "alarm_type", "controller_state", "heartbeat",
+                 "card_info", "error_code", "process_crash", "port_error_code", "cpu_usage"]
+    levels = ["info", "warning", "error", "critical"]
+    messages = ["eth0 link down", "Link UP on port 3", "speed unknown", "ETH_PORT alarm",
+                "heartbeat lost", "controller offline", "card removed", "process restart",
+                "CRC errors rising", "cpu 95%", "链路状态变化", "接口卡下电", ""]
+    for _ in range(2000):
+        args = (rng.choice(task_types), rng.choice(observers), rng.choice(levels), rng.choice(messages))
+        assert compiled.match(*args) == _linear_match(rules, *args), args
+
+
+def test_priority_order_is_kept():
+    rules = [
+        {"id": 1, "task_types": [], "observer_patterns": [], "level_patterns": [], "message_patterns": ["down"]},
+        {"id": 2, "task_types": ["t"], "observer_patterns": [], "level_patterns": [], "message_patterns": ["link"]},
+    ]
+    compiled = CompiledRuleSet(rules)
+    assert compiled.match("t", "link_status", "warning", "link down") == 1
+    assert compiled.match("t", "link_status", "warning", "link up") == 2
+    assert compiled.match("other", "link_status", "warning", "link up") is None
+
+
+def test_invalid_patterns_are_skipped():
+    rules = [
+        {"id": 1, "task_types": [], "observer_patterns": [], "level_patterns": [], "message_patterns": ["(bad"]},
+        {"id": 2, "task_types": [], "observer_patterns": [], "level_patterns": [], "message_patterns": ["(bad", "ok"]},
+        {"id": 3, "task_types": [], "observer_patterns": [], "level_patterns": [], "message_patterns": [r"(a)\1"]},
+    ]
+    compiled = CompiledRuleSet(rules)
+    assert compiled.match("t", "o", "info", "(bad") is None
+    assert compiled.match("t", "o", "info", "all ok") == 2
+    assert compiled.match("t", "o", "info", "aa") == 3
+
+
+def test_backreferences_are_not_merged():
+    # Joining would renumber (a)\1 to refer to the first pattern's group
+    assert _compile_any(["(x)y", r"(a)\1"]).search("aa")
+    rules = [
+        {"id": 1, "task_types": [], "observer_patterns": [], "level_patterns": [],
+         "message_patterns": ["(x)y", r"(a)\1"]},
+    ]
+    assert CompiledRuleSet(rules).match("t", "o", "info", "aa") == 1
@@ -133,3 +133,46 @@ class TestSchedulerAPI:
     async def test_recent_results(self, app_client):
         resp = await app_client.get("/api/tasks/results/recent")
         assert resp.status_code == 200
+
+
+@pytest.mark.asyncio
+class TestTimelineAPI:
+    async def test_cursor_paging(self, app_client):
+        from datetime import datetime, timedelta
+        base = datetime.now() - timedelta(minutes=30)
+        for i in range(5):
+            resp = await app_client.post("/api/ingest", json={
+                "type": "alert",
+                "array_id": "test_arr_timeline",
+                "observer_name": "port_fec" if i % 2 else "cpu_usage",
+                "level": "warning",
+                "message": f"evt{i}",
+                # Two events share a timestamp to exercise the id tie-break
+                "timestamp": (base + timedelta(minutes=min(i, 3))).isoformat(),
+            })
+            assert resp.status_code == 200
+
+        seen = []
+        cursor = None
+        while True:
+            params = {"limit": 2}
+            if cursor:
+                params["cursor"] = cursor
+            data = (await app_client.get("/api/timeline/test_arr_timeline", params=params)).json()
+            assert data["total"] == 5
+            seen.extend(e["message"] for e in data["events"])
+            cursor = data["next_cursor"]
+            if not cursor:
+                break
+        assert sorted(seen) == [f"evt{i}" for i in range(5)]
+        assert len(seen) == 5
+
+        port = (await app_client.get(
+            "/api/timeline/test_arr_timeline", params={"category": "port"}
+        )).json()
+        assert {e["category"] for e in port["events"]} == {"port"}
+        assert port["total"] == 2
+
+    async def test_invalid_cursor(self, app_client):
+        resp = await app_client.get("/api/timeline/test_arr_timeline", params={"cursor": "!!"})
+        assert resp.status_code == 400
@@ -0,0 +1,181 @@
+"""Tests for backend/core/card_inventory.py — bulk apply, journal and search tokens."""
+from datetime import datetime, timedelta
+
+import pytest
+from sqlalchemy import select
+
+from backend.core.card_inventory import (
+    CARD_JOURNAL_RETENTION_DAYS, apply_array_cards, prune_card_journal, search_tokens, token_range,
+)
+from backend.models.card_inventory import CardInventoryModel, CardJournalModel, CardSearchTokenModel
+
+
+def _card(card_no, board_id, health="NORMAL", running="RUNNING", model="X100"):
+    return {"card_no": card_no, "board_id": board_id, "health_state": health,
+            "running_state": running, "model": model, "raw_fields": {"BoardId": board_id}}
+
+
+async def _journal(db):
+    result = await db.execute(select(CardJournalModel).order_by(CardJournalModel.id))
+    return [(j.change, j.board_id, j.old_state, j.new_state) for j in result.scalars().all()]
+
+
+async def _search(db, keyword):
+    lo, hi = token_range(keyword)
+    result = await db.execute(
+        select(CardSearchTokenModel.card_id)
+        .where(CardSearchTokenModel.token >= lo, CardSearchTokenModel.token < hi)
+    )
+    return {r[0] for r in result.all()}
+
+
+class TestTokens:
+    def test_suffixes_cover_substrings(self):
+        tokens = search_tokens("No001", "BOARD123", "X 100")
+        assert {"no001", "001", "board123", "123", "x", "100"} <= tokens
+        lo, hi = token_range("RD1")
+        assert any(lo <= t < hi for t in tokens)
+
+    def test_empty_values(self):
+        assert search_tokens(None, "", "  ") == set()
+
+
+@pytest.mark.asyncio
+class TestApply:
+    async def test_insert_state_change_and_remove(self, db_session):
+        now = datetime(2026, 1, 1, 12, 0, 0)
+        first = await apply_array_cards(db_session, "arr-ci", [
+            _card("No001", "B001"), _card("No002", "B002"), _card("No003", "B002"),
+        ], now)
+        await db_session.commit()
+        assert (first.synced, first.inserted, first.removed, first.state_changed) == (2, 2, 0, 0)
+
+        second = await apply_array_cards(db_session, "arr-ci", [
+            _card("No001", "B001", health="FAULT"), _card("No004", "B004"),
+        ], now)
+        await db_session.commit()
+        assert (second.inserted, second.removed, second.state_changed) == (1, 1, 1)
+
+        result = await db_session.execute(
+            select(CardInventoryModel.card_no, CardInventoryModel.health_state)
+            .where(CardInventoryModel.array_id == "arr-ci").order_by(CardInventoryModel.card_no)
+        )
+        assert result.all() == [("No001", "FAULT"), ("No004", "NORMAL")]
+        assert await _journal(db_session) == [
+            ("insert", "B001", "", "NORMAL/RUNNING"),
+            ("insert", "B002", "", "NORMAL/RUNNING"),
+            ("remove", "B002", "NORMAL/RUNNING", ""),
+            ("state", "B001", "NORMAL/RUNNING", "FAULT/RUNNING"),
+            ("insert", "B004", "", "NORMAL/RUNNING"),
+        ]
+
+    async def test_board_moves_slot_keeps_row(self, db_session):
+        await apply_array_cards(db_session, "arr-mv", [_card("No001", "B001")])
+        await db_session.commit()
+        card_id = (await db_session.execute(select(CardInventoryModel.id))).scalar_one()
+
+        applied = await apply_array_cards(db_session, "arr-mv", [_card("No005", "B001")])
+        await db_session.commit()
+        assert (applied.inserted, applied.removed) == (0, 0)
+        row = (await db_session.execute(select(CardInventoryModel))).scalar_one()
+        assert (row.id, row.card_no) == (card_id, "No005")
+        # Tokens follow the new slot
+        assert await _search(db_session, "no005") == {card_id}
+        assert await _search(db_session, "no001") == set()
+
+    async def _slots(self, db, array_id):
+        result = await db.execute(
+            select(CardInventoryModel.id, CardInventoryModel.card_no, CardInventoryModel.board_id)
+            .where(CardInventoryModel.array_id == array_id).order_by(CardInventoryModel.card_no)
+        )
+        return result.all()
+
+    async def test_board_moves_into_slot_still_held(self, db_session):
+        await apply_array_cards(db_session, "arr-hold", [_card("No001", "BX")])
+        await db_session.commit()
+        [(card_id, _, _)] = await self._slots(db_session, "arr-hold")
+
+        applied = await apply_array_cards(db_session, "arr-hold", [
+            _card("No001", "BZ"), _card("No003", "BX"),
+        ])
+        await db_session.commit()
+        assert (applied.inserted, applied.removed) == (1, 0)
+        slots = await self._slots(db_session, "arr-hold")
+        assert [(no, board) for _, no, board in slots] == [("No001", "BZ"), ("No003", "BX")]
+        assert slots[1][0] == card_id
+
+    async def test_two_boards_swap_slots(self, db_session):
+        await apply_array_cards(db_session, "arr-swap", [_card("No001", "BA"), _card("No002", "BB")])
+        await db_session.commit()
+        ids = {board: card_id for card_id, _, board in await self._slots(db_session, "arr-swap")}
+
+        applied = await apply_array_cards(db_session, "arr-swap", [
+            _card("No001", "BB"), _card("No002", "BA"),
+        ])
+        await db_session.commit()
+        assert (applied.inserted, applied.removed) == (0, 0)
+        assert await self._slots(db_session, "arr-swap") == [
+            (ids["BB"], "No001", "BB"), (ids["BA"], "No002", "BA"),
+        ]
+        assert await _search(db_session, "no001") == {ids["BB"]}
+
+    async def test_empty_parse_removes_nothing(self, db_session):
+        await apply_array_cards(db_session, "arr-empty", [_card("No001", "B001")])
+        await db_session.commit()
+        applied = await apply_array_cards(db_session, "arr-empty", [])
+        await db_session.commit()
+        assert applied.removed == 0
+        result = await db_session.execute(select(CardInventoryModel.board_id))
+        assert [r[0] for r in result.all()] == ["B001"]
+
+    async def test_tokens_track_inserts_and_removes(self, db_session):
+        await apply_array_cards(db_session, "arr-tok", [
+            _card("No001", "BOARD123", model="X200"), _card("No002", "BOARD456", model="Y300"),
+        ])
+        await db_session.commit()
+        ids = dict((await db_session.execute(
+            select(CardInventoryModel.board_id, CardInventoryModel.id)
+        )).all())
+        assert await _search(db_session, "d12") == {ids["BOARD123"]}
+        assert await _search(db_session, "board") == set(ids.values())
+
+        await apply_array_cards(db_session, "arr-tok", [_card("No002", "BOARD456", model="Y300")])
+        await db_session.commit()
+        assert await _search(db_session, "board") == {ids["BOARD456"]}
+
+    async def test_same_card_no_new_boards_inserts_once(self, db_session):
+        applied = await apply_array_cards(db_session, "arr-dup", [
+            _card("No001", "B001"), _card("No001", "B002"),
+        ])
+        await db_session.commit()
+        assert (applied.synced, applied.inserted) == (1, 1)
+        result = await db_session.execute(
+            select(CardInventoryModel.card_no, CardInventoryModel.board_id)
+            .where(CardInventoryModel.array_id == "arr-dup")
+        )
+        assert result.all() == [("No001", "B001")]
+
+    async def test_orm_writes_are_indexed(self, db_session):
+        card = CardInventoryModel(array_id="arr-orm", card_no="No001", board_id="BOARD789")
+        db_session.add(card)
+        await db_session.commit()
+        assert await _search(db_session, "d78") == {card.id}
+
+        card.board_id = "BOARD000"
+        await db_session.commit()
+        assert await _search(db_session, "d78") == set()
+
+        await db_session.delete(card)
+        await db_session.commit()
+        assert await _search(db_session, "board") == set()
+
+    async def test_prune_journal(self, db_session):
+        now = datetime(2026, 6, 1)
+        old = now - timedelta(days=CARD_JOURNAL_RETENTION_DAYS + 1)
+        await apply_array_cards(db_session, "arr-old", [_card("No001", "B001")], old)
+        await apply_array_cards(db_session, "arr-new", [_card("No001", "B002")], now)
+        await db_session.commit()
+
+        assert await prune_card_journal(db_session, now) == 1
+        await db_session.commit()
+        assert [j[1] for j in await _journal(db_session)] == ["B002"]
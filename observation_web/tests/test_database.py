@@ -4,7 +4,9 @@ import pytest
 import pytest_asyncio
 import sqlalchemy as sa
 from pathlib import Path
-from backend.db.database import init_db, create_tables, get_db, get_database_url, Base
+from backend.db.database import (
+    init_db, create_tables, get_db, get_database_url, Base, check_sqlite_version,
+)
 
 
 class TestDatabaseUrl:
@@ -18,6 +20,12 @@ class TestDatabaseUrl:
         assert url.startswith("sqlite+aiosqlite://")
 
 
+class TestSqliteVersion:
+    def test_minimum_version(self):
+        assert check_sqlite_version((3, 35, 0))
+        assert not check_sqlite_version((3, 34, 1))
+
+
 @pytest.mark.asyncio
 class TestDatabaseInit:
     async def test_init_and_create_tables(self):
@@ -0,0 +1,46 @@
+"""
+Chart decimation tests (backend/core/downsample.py).
+
+Covers min/max row buckets (multi-column, spike preservation, extent).
+"""
+
+from backend.core.downsample import minmax_rows
+
+
+def _rows(n, **spikes):
+    rows = [{"ts": i, "tx_rate_bps": 100.0, "rx_rate_bps": 50.0} for i in range(n)]
+    for key, idx in spikes.items():
+        rows[idx][key] = 1e9
+    return rows
+
+
+# ── minmax_rows ──────────────────────────────────────────────
+
+def test_short_series_returned_unchanged():
+    rows = _rows(10)
+    assert minmax_rows(rows, 500, ["tx_rate_bps"]) == rows
+
+
+def test_respects_point_budget_and_keeps_extent():
+    rows = _rows(10000)
+    out = minmax_rows(rows, 500, ["tx_rate_bps", "rx_rate_bps"])
+    assert len(out) <= 500
+    assert out[0]["ts"] == 0
+    assert out[-1]["ts"] == 9999
+    assert [r["ts"] for r in out] == sorted(r["ts"] for r in out)
+
+
+def test_spikes_in_every_column_survive():
+    rows = _rows(10000, tx_rate_bps=1234, rx_rate_bps=8765)
+    out = minmax_rows(rows, 200, ["tx_rate_bps", "rx_rate_bps"])
+    assert max(r["tx_rate_bps"] for r in out) == 1e9
+    assert max(r["rx_rate_bps"] for r in out) == 1e9
+
+
+def test_rows_missing_a_column_are_tolerated():
+    rows = [{"ts": i, "cpu0": float(i % 7)} if i % 2 else {"ts": i, "mem_used_mb": 4096.0}
+            for i in range(5000)]
+    out = minmax_rows(rows, 300, ["cpu0", "mem_used_mb"])
+    assert len(out) <= 300
+    assert any("cpu0" in r for r in out)
+    assert any("mem_used_mb" in r for r in out)
@@ -29,3 +29,23 @@ class TestMetricsStore:
         """EDGE: Getting metrics for unknown IP returns empty."""
         from backend.api.ingest import _metrics_store
         assert _metrics_store.get("unknown_ip") is None
+
+
+class TestIngestPressure:
+    def _level(self, monkeypatch, rate, limit):
+        from backend.api import ingest
+        from backend.core.event_pipeline import RateCounter
+        counter = RateCounter()
+        counter.add(rate)
+        monkeypatch.setattr(ingest, "_metrics_rate", counter)
+        monkeypatch.setattr(ingest.get_config().remote, "ingest_pressure_rate", limit)
+        return ingest.ingest_pressure_level()
+
+    def test_levels_double_with_rate(self, monkeypatch):
+        assert self._level(monkeypatch, 599, 600) == 0
+        assert self._level(monkeypatch, 600, 600) == 1
+        assert self._level(monkeypatch, 1200, 600) == 2
+        assert self._level(monkeypatch, 100000, 600) == 3
+
+    def test_disabled(self, monkeypatch):
+        assert self._level(monkeypatch, 100000, 0) == 0
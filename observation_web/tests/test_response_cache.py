@@ -0,0 +1,122 @@
+"""
+ETag response cache tests (backend/core/response_cache.py).
+
+Covers: repeated dashboard polls served from cached bytes, 304 on a
+matching If-None-Match, invalidation on committed ORM / raw SQL writes,
+no invalidation on rollback, and max-age expiry.
+"""
+
+from datetime import datetime
+
+import pytest
+from sqlalchemy import text
+
+from backend.core import response_cache as cache_mod
+from backend.core.response_cache import ARRAY_STATUS_STATE, ResponseCache
+from backend.models.alert import AlertModel
+
+
+@pytest.fixture
+def cache(monkeypatch):
+    fresh = ResponseCache()
+    monkeypatch.setattr(cache_mod, "_cache", fresh)
+    return fresh
+
+
+def _alert(message="eth0 link down"):
+    return AlertModel(
+        array_id="arr-1", observer_name="link_status", level="warning",
+        message=message, details="{}", timestamp=datetime.now(),
+    )
+
+
+async def test_repeat_poll_served_from_cache_and_304(app_client_with_db, cache):
+    client, _ = app_client_with_db
+
+    first = await client.get("/api/alerts/stats", params={"hours": 24})
+    assert first.status_code == 200
+    etag = first.headers["etag"]
+    assert first.headers["cache-control"] == "no-cache"
+
+    second = await client.get("/api/alerts/stats", params={"hours": 24})
+    assert second.headers["etag"] == etag
+    assert second.content == first.content
+
+    conditional = await client.get("/api/alerts/stats", params={"hours": 24},
+                                   headers={"If-None-Match": etag})
+    assert conditional.status_code == 304
+    assert conditional.content == b""
+
+    stats = cache.stats()
+    assert stats["misses"] == 1
+    assert stats["hits"] == 2
+    assert stats["not_modified"] == 1
+
+
+async def test_committed_alert_invalidates(app_client_with_db, cache):
+    client, session = app_client_with_db
+
+    before = await client.get("/api/alerts/stats")
+    session.add(_alert())
+    await session.commit()
+
+    after = await client.get("/api/alerts/stats", headers={"If-None-Match": before.headers["etag"]})
+    assert after.status_code == 200
+    assert after.json()["total"] == 1
+    assert after.headers["etag"] != before.headers["etag"]
+
+
+async def test_raw_sql_write_invalidates(app_client_with_db, cache):
+    client, session = app_client_with_db
+    session.add(_alert())
+    await session.commit()
+
+    before = await client.get("/api/alerts/recent")
+    assert len(before.json()) == 1
+    await session.execute(text("DELETE FROM alerts"))
+    await session.commit()
+
+    after = await client.get("/api/alerts/recent")
+    assert after.json() == []
+
+
+async def test_rollback_and_unrelated_tables_keep_entry(app_client_with_db, cache):
+    client, session = app_client_with_db
+    first = await client.get("/api/alerts/aggregated")
+
+    session.add(_alert())
+    await session.flush()
+    await session.rollback()
+    await session.execute(text("INSERT INTO audit_logs (action) VALUES ('x')"))
+    await session.commit()
+
+    again = await client.get("/api/alerts/aggregated", headers={"If-None-Match": first.headers["etag"]})
+    assert again.status_code == 304
+
+
+async def test_status_push_invalidates_statuses(app_client_with_db, cache):
+    client, _ = app_client_with_db
+    await client.get("/api/arrays/statuses")
+    versions = cache.versions((ARRAY_STATUS_STATE,))
+
+    from backend.api.websocket import broadcast_status_update
+    await broadcast_status_update("arr-1", {"state": "connected"})
+
+    assert cache.versions((ARRAY_STATUS_STATE,)) != versions
+    await client.get("/api/arrays/statuses")
+    assert cache.stats()["misses"] == 2
+
+
+async def test_entries_expire_after_max_age(app_client_with_db, monkeypatch):
+    now = [0.0]
+    fresh = ResponseCache(max_age=30, clock=lambda: now[0])
+    monkeypatch.setattr(cache_mod, "_cache", fresh)
+    client, _ = app_client_with_db
+
+    await client.get("/api/alerts/stats")
+    now[0] = 29
+    await client.get("/api/alerts/stats")
+    assert fresh.stats()["misses"] == 1
+    now[0] = 30
+    await client.get("/api/alerts/stats")
+    assert fresh.stats()["misses"] == 2
@@ -0,0 +1,179 @@
+"""
+Live stream hub tests (backend/core/stream_hub.py).
+
+Covers one shared poller per topic, teardown on last unsubscribe,
+per-subscriber filters and parameter validation.
+"""
+
+import asyncio
+
+import pytest
+
+from backend.core.stream_hub import StreamHub, StreamSpec
+
+
+def _counting_spec(batches, interval=0.01, **kwargs):
+    """Spec whose fetcher returns successive items from ``batches`` and counts fetcher builds."""
+    built = []
+
+    def make_fetcher(params):
+        it = iter(batches)
+        built.append(params)
+
+        async def fetch():
+            return next(it, [])
+
+        return fetch
+
+    spec = StreamSpec(topic=lambda p: p["array_id"], make_fetcher=make_fetcher, interval=interval, **kwargs)
+    return spec, built
+
+
+async def _wait_for(predicate, timeout=1.0):
+    deadline = asyncio.get_event_loop().time() + timeout
+    while not predicate():
+        if asyncio.get_event_loop().time() > deadline:
+            raise AssertionError("condition not met in time")
+        await asyncio.sleep(0.005)
+
+
+async def test_subscribers_share_one_poller():
+    hub = StreamHub()
+    spec, built = _counting_spec([[1, 2], [3]])
+    hub.register_stream("metrics", spec)
+    got_a, got_b = [], []
+
+    async def deliver_a(items):
+        got_a.extend(items)
+
+    async def deliver_b(items):
+        got_b.extend(items)
+
+    sub_a = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver_a)
+    sub_b = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver_b)
+    await _wait_for(lambda: len(got_a) == 3 and len(got_b) == 3)
+
+    assert len(built) == 1
+    assert hub.topic_count() == 1
+    assert hub.subscriber_count("metrics", {"array_id": "arr1"}) == 2
+
+    await hub.unsubscribe(sub_a)
+    assert hub.topic_count() == 1
+    await hub.unsubscribe(sub_b)
+    assert hub.topic_count() == 0
+
+
+async def test_last_unsubscribe_stops_polling():
+    hub = StreamHub()
+    spec, _ = _counting_spec([])
+    hub.register_stream("metrics", spec)
+
+    async def deliver(items):
+        pass
+
+    sub = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver)
+    await _wait_for(lambda: hub.fetch_count("metrics", {"array_id": "arr1"}) >= 2)
+    await hub.unsubscribe(sub)
+    assert hub.fetch_count("metrics", {"array_id": "arr1"}) == 0
+
+    # A fresh subscription builds a new fetcher (new cursor)
+    sub = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver)
+    assert hub.topic_count() == 1
+    await hub.unsubscribe(sub)
+
+
+async def test_distinct_topics_poll_separately():
+    hub = StreamHub()
+    spec, built = _counting_spec([])
+    hub.register_stream("metrics", spec)
+
+    async def deliver(items):
+        pass
+
+    s1 = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver)
+    s2 = await hub.subscribe("metrics", {"array_id": "arr2"}, deliver)
+    assert hub.topic_count() == 2
+    assert len(built) == 2
+    await hub.unsubscribe(s1)
+    await hub.unsubscribe(s2)
+
+
+async def test_per_subscriber_filter():
+    hub = StreamHub()
+    records = [{"port": "eth0", "v": 1}, {"port": "eth1", "v": 2}]
+    spec, _ = _counting_spec(
+        [records],
+        make_filter=lambda p: (lambda r: r["port"] == p["port"]) if p.get("port") else None,
+    )
+    hub.register_stream("traffic", spec)
+    eth0, everything = [], []
+
+    async def deliver_eth0(items):
+        eth0.extend(items)
+
+    async def deliver_all(items):
+        everything.extend(items)
+
+    s1 = await hub.subscribe("traffic", {"array_id": "arr1", "port": "eth0"}, deliver_eth0)
+    s2 = await hub.subscribe("traffic", {"array_id": "arr1"}, deliver_all)
+    await _wait_for(lambda: len(everything) == 2)
+
+    assert eth0 == [{"port": "eth0", "v": 1}]
+    await hub.unsubscribe(s1)
+    await hub.unsubscribe(s2)
+
+
+async def test_failing_delivery_does_not_stop_others():
+    hub = StreamHub()
+    spec, _ = _counting_spec([[1]])
+    hub.register_stream("metrics", spec)
+    got = []
+
+    async def broken(items):
+        raise RuntimeError("socket closed")
+
+    async def deliver(items):
+        got.extend(items)
+
+    s1 = await hub.subscribe("metrics", {"array_id": "arr1"}, broken)
+    s2 = await hub.subscribe("metrics", {"array_id": "arr1"}, deliver)
+    await _wait_for(lambda: got == [1])
+    await hub.unsubscribe(s1)
+    await hub.unsubscribe(s2)
+
+
+async def test_unknown_stream_and_invalid_params_rejected():
+    hub = StreamHub()
+
+    def validate(params):
+        if not params.get("array_id"):
+            raise ValueError("Missing stream parameter: array_id")
+
+    spec, built = _counting_spec([], validate=validate)
+    hub.register_stream("metrics", spec)
+
+    async def deliver(items):
+        pass
+
+    with pytest.raises(ValueError):
+        await hub.subscribe("nope", {"array_id": "arr1"}, deliver)
+    with pytest.raises(ValueError):
+        await hub.subscribe("metrics", {}, deliver)
+    assert built == []
+    assert hub.topic_count() == 0
+
+
+async def test_log_stream_rejects_paths_outside_allowed_prefixes():
+    from backend.api.streams import register_streams
+
+    hub = StreamHub()
+    register_streams(hub)
+
+    async def deliver(items):
+        pass
+
+    with pytest.raises(ValueError):
+        await hub.subscribe("log", {"array_id": "arr1", "file_path": "/etc/shadow"}, deliver)
+    with pytest.raises(ValueError):
+        await hub.subscribe("log", {"array_id": "arr1", "file_path": "/var/log/../../etc/shadow"}, deliver)
+    assert hub.topic_count() == 0
@@ -0,0 +1,91 @@
+"""
+Write-behind user presence tests (backend/middleware/user_session.py).
+
+Covers: requests never write user_sessions directly, batched flush upserts
+one row per IP, online queries are answered from memory, and a nickname
+claim does not resurrect the old IP's row.
+"""
+
+import pytest
+from sqlalchemy import func, select
+
+from backend.middleware import user_session as presence_mod
+from backend.middleware.user_session import PresenceTracker
+from backend.models.user_session import UserSessionModel
+
+
+@pytest.fixture
+def tracker(monkeypatch):
+    fresh = PresenceTracker()
+    monkeypatch.setattr(presence_mod, "_tracker", fresh)
+    return fresh
+
+
+async def _row_count(session) -> int:
+    result = await session.execute(select(func.count(UserSessionModel.id)))
+    return result.scalar() or 0
+
+
+async def test_requests_do_not_write_until_flush(app_client_with_db, tracker):
+    client, session = app_client_with_db
+    for _ in range(5):
+        await client.get("/api/users/count", headers={"X-Real-IP": "10.0.0.1"})
+    await client.get("/api/users/count", headers={"X-Real-IP": "10.0.0.2"})
+
+    assert await _row_count(session) == 0
+    assert tracker.pending_count() == 2
+
+    assert await tracker.flush() == 2
+    assert await _row_count(session) == 2
+    assert tracker.pending_count() == 0
+
+    # Nothing new -> no write
+    assert await tracker.flush() == 0
+
+
+async def test_flush_updates_existing_rows(app_client_with_db, tracker):
+    client, session = app_client_with_db
+    session.add(UserSessionModel(ip="10.0.0.1", nickname="alice", is_active=False))
+    await session.commit()
+
+    await client.get("/api/users/count", headers={"X-Real-IP": "10.0.0.1"})
+    await tracker.flush()
+
+    session.expire_all()
+    row = (await session.execute(
+        select(UserSessionModel).where(UserSessionModel.ip == "10.0.0.1")
+    )).scalar_one()
+    assert row.is_active is True
+    assert row.nickname == "alice"
+    assert await _row_count(session) == 1
+    assert tracker.get_nickname("10.0.0.1") == "alice"
+
+
+async def test_online_users_served_from_memory(app_client_with_db, tracker):
+    client, _ = app_client_with_db
+    await client.get("/api/arrays/arr-1/status", headers={"X-Real-IP": "10.0.0.7"})
+
+    resp = await client.get("/api/users/online", headers={"X-Real-IP": "10.0.0.8"})
+    assert resp.status_code == 200
+    users = {u["ip"]: u for u in resp.json()}
+    assert users["10.0.0.7"]["viewing_page"] == "/arrays/arr-1"
+    assert "10.0.0.8" in users
+
+    resp = await client.get("/api/users/count", headers={"X-Real-IP": "10.0.0.8"})
+    assert resp.json()["online_count"] == 2
+
+
+async def test_claim_does_not_recreate_old_ip_row(app_client_with_db, tracker):
+    client, session = app_client_with_db
+    session.add(UserSessionModel(ip="10.0.0.1", nickname="bob", is_active=True))
+    await session.commit()
+
+    # Old IP has pending presence, then the user claims from a new IP
+    tracker.touch("10.0.0.1", "/")
+    resp = await client.post("/api/users/claim", json={"nickname": "bob"}, headers={"X-Real-IP": "10.0.0.9"})
+    assert resp.status_code == 200
+
+    await tracker.flush()
+    ips = set((await session.execute(select(UserSessionModel.ip))).scalars().all())
+    assert ips == {"10.0.0.9"}
+    assert tracker.get_nickname("10.0.0.9") == "bob"
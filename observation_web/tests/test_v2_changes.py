@@ -576,6 +576,78 @@ class TestAckAPIWithData:
         assert remaining.scalar_one_or_none() is None
 
 
+@pytest.mark.asyncio
+class TestBulkAckAPI:
+    """Set-based ack / ack-all / batch undo / batch modify through the API."""
+
+    async def _seed(self, db, count=5):
+        alerts = [
+            AlertModel(array_id="arr-bulk", observer_name="cpu_usage", level="warning",
+                       message=f"m{i}", details="{}", timestamp=datetime.now())
+            for i in range(count)
+        ]
+        db.add_all(alerts)
+        await db.commit()
+        return [a.id for a in alerts]
+
+    async def test_ack_is_idempotent_and_ordered(self, app_client_with_db):
+        client, db = app_client_with_db
+        ids = await self._seed(db)
+        resp = await client.post("/api/alerts/ack", json={"alert_ids": ids[2:0:-1]})
+        assert resp.status_code == 200
+        assert [a["alert_id"] for a in resp.json()] == [ids[2], ids[1]]
+        assert all(a["ack_expires_at"] for a in resp.json())
+
+        resp = await client.post("/api/alerts/ack", json={"alert_ids": ids, "ack_type": "confirmed_ok"})
+        assert [a["alert_id"] for a in resp.json()] == [ids[0], ids[3], ids[4]]
+        assert all(a["ack_expires_at"] is None for a in resp.json())
+
+        resp = await client.post("/api/alerts/ack", json={"alert_ids": ids + [99999]})
+        assert resp.status_code == 404
+        assert "99999" in resp.json()["detail"]
+
+    async def test_ack_all_then_modify_and_undo(self, app_client_with_db):
+        client, db = app_client_with_db
+        ids = await self._seed(db)
+        await client.post("/api/alerts/ack", json={"alert_ids": ids[:1]})
+
+        resp = await client.post("/api/alerts/ack-all-visible", params={"hours": 1})
+        assert resp.json()["acked_count"] == len(ids) - 1
+        resp = await client.post("/api/alerts/ack-all-visible", params={"hours": 1})
+        assert resp.json()["acked_count"] == 0
+
+        resp = await client.post("/api/alerts/ack/batch-modify", json={
+            "alert_ids": ids[:2], "new_ack_type": "deferred", "expires_hours": 8,
+        })
+        assert resp.json()["modified_count"] == 2
+        result = await db.execute(
+            select(AlertAckModel.ack_type).where(AlertAckModel.alert_id == ids[0])
+        )
+        assert result.scalar() == "deferred"
+
+        resp = await client.post("/api/alerts/ack/batch-undo", json={"alert_ids": ids + [99999]})
+        assert resp.json()["undone_count"] == len(ids)
+
+    async def test_undo_keeps_observer_issue_while_another_ack_covers_it(self, app_client_with_db):
+        from backend.api.arrays import _array_status_cache, _get_array_status
+
+        client, db = app_client_with_db
+        ids = await self._seed(db, count=2)
+        issue = {"key": "cpu", "observer": "cpu_usage", "suppressed": False}
+        _get_array_status("arr-bulk").active_issues = [issue]
+        try:
+            await client.post("/api/alerts/ack", json={"alert_ids": ids})
+            assert issue["suppressed"] is True
+
+            await client.post("/api/alerts/ack/batch-undo", json={"alert_ids": ids[:1]})
+            assert issue["suppressed"] is True
+
+            await client.post("/api/alerts/ack/batch-undo", json={"alert_ids": ids[1:]})
+            assert issue["suppressed"] is False
+        finally:
+            _array_status_cache.pop("arr-bulk", None)
+
+
 # ═══════════════════════════════════════════════════════════════════════════
 # 9. _compute_recent_alert_summary
 # ═══════════════════════════════════════════════════════════════════════════